@@ -0,0 +1,123 @@
+# CMAKE generated file: DO NOT EDIT!
+# Generated by "Unix Makefiles" Generator, CMake Version 3.25
+
+# The generator used is:
+set(CMAKE_DEPENDS_GENERATOR "Unix Makefiles")
+
+# The top level Makefile was generated from the following files:
+set(CMAKE_MAKEFILE_DEPENDS
+  "CMakeCache.txt"
+  "/root/repo/CMakeLists.txt"
+  "CMakeFiles/3.25.1/CMakeCCompiler.cmake"
+  "CMakeFiles/3.25.1/CMakeCXXCompiler.cmake"
+  "CMakeFiles/3.25.1/CMakeSystem.cmake"
+  "external/benchmark/CMakeLists.txt"
+  "external/gt/CMakeLists.txt"
+  "external/gt/googlemock/CMakeLists.txt"
+  "external/gt/googlemock/cmake/gmock.pc.in"
+  "external/gt/googlemock/cmake/gmock_main.pc.in"
+  "external/gt/googletest/CMakeLists.txt"
+  "external/gt/googletest/cmake/Config.cmake.in"
+  "external/gt/googletest/cmake/gtest.pc.in"
+  "external/gt/googletest/cmake/gtest_main.pc.in"
+  "external/gt/googletest/cmake/internal_utils.cmake"
+  "external/spdlog/CMakeLists.txt"
+  "/usr/lib/x86_64-linux-gnu/cmake/benchmark/benchmarkConfig.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/benchmark/benchmarkConfigVersion.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/benchmark/benchmarkTargets-none.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/benchmark/benchmarkTargets.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/fmt/fmt-config-version.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/fmt/fmt-config.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/fmt/fmt-targets-none.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/fmt/fmt-targets.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/spdlog/spdlogConfig.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/spdlog/spdlogConfigTargets-none.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/spdlog/spdlogConfigTargets.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/spdlog/spdlogConfigVersion.cmake"
+  "/usr/share/cmake-3.25/Modules/BasicConfigVersion-AnyNewerVersion.cmake.in"
+  "/usr/share/cmake-3.25/Modules/CMakeCInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeCXXInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeCommonLanguageInclude.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeDependentOption.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeFindDependencyMacro.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeGenericSystem.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeInitializeConfigs.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeLanguageInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakePackageConfigHelpers.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeSystemSpecificInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeSystemSpecificInitialize.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckCSourceCompiles.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckIncludeFile.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckLibraryExists.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/CMakeCommonCompilerMacros.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU-C.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU-CXX.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU.cmake"
+  "/usr/share/cmake-3.25/Modules/FindPackageHandleStandardArgs.cmake"
+  "/usr/share/cmake-3.25/Modules/FindPackageMessage.cmake"
+  "/usr/share/cmake-3.25/Modules/FindPython.cmake"
+  "/usr/share/cmake-3.25/Modules/FindPython/Support.cmake"
+  "/usr/share/cmake-3.25/Modules/FindThreads.cmake"
+  "/usr/share/cmake-3.25/Modules/GNUInstallDirs.cmake"
+  "/usr/share/cmake-3.25/Modules/Internal/CheckSourceCompiles.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU-C.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU-CXX.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/UnixPaths.cmake"
+  "/usr/share/cmake-3.25/Modules/WriteBasicConfigVersionFile.cmake"
+  )
+
+# The corresponding makefile is:
+set(CMAKE_MAKEFILE_OUTPUTS
+  "Makefile"
+  "CMakeFiles/cmake.check_cache"
+  )
+
+# Byproducts of CMake generate step:
+set(CMAKE_MAKEFILE_PRODUCTS
+  "CMakeFiles/CMakeDirectoryInformation.cmake"
+  "_bench_build/external/spdlog/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "_bench_build/external/gt/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "_bench_build/external/gt/googletest/generated/gmock.pc"
+  "_bench_build/external/gt/googletest/generated/gmock_main.pc"
+  "_bench_build/external/gt/googlemock/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "_bench_build/external/gt/googletest/generated/GTestConfigVersion.cmake"
+  "_bench_build/external/gt/googletest/generated/GTestConfig.cmake"
+  "_bench_build/external/gt/googletest/generated/gtest.pc"
+  "_bench_build/external/gt/googletest/generated/gtest_main.pc"
+  "_bench_build/external/gt/googletest/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "_bench_build/external/benchmark/CMakeFiles/CMakeDirectoryInformation.cmake"
+  )
+
+# Dependency information for all targets:
+set(CMAKE_DEPEND_INFO_FILES
+  "CMakeFiles/gbmu.dir/DependInfo.cmake"
+  "CMakeFiles/interrupt_ctrl_test.dir/DependInfo.cmake"
+  "CMakeFiles/wram_test.dir/DependInfo.cmake"
+  "CMakeFiles/joypad_test.dir/DependInfo.cmake"
+  "CMakeFiles/timer_test.dir/DependInfo.cmake"
+  "CMakeFiles/oram_test.dir/DependInfo.cmake"
+  "CMakeFiles/vram_test.dir/DependInfo.cmake"
+  "CMakeFiles/hram_test.dir/DependInfo.cmake"
+  "CMakeFiles/bus_test.dir/DependInfo.cmake"
+  "CMakeFiles/arena_test.dir/DependInfo.cmake"
+  "CMakeFiles/dbuffer_test.dir/DependInfo.cmake"
+  "CMakeFiles/scheduler_test.dir/DependInfo.cmake"
+  "CMakeFiles/cartridge_test.dir/DependInfo.cmake"
+  "CMakeFiles/tile_decoder_test.dir/DependInfo.cmake"
+  "CMakeFiles/dma_test.dir/DependInfo.cmake"
+  "CMakeFiles/hdma_test.dir/DependInfo.cmake"
+  "CMakeFiles/cpu_test.dir/DependInfo.cmake"
+  "CMakeFiles/machine_test.dir/DependInfo.cmake"
+  "CMakeFiles/delta_codec_test.dir/DependInfo.cmake"
+  "CMakeFiles/rewind_test.dir/DependInfo.cmake"
+  "CMakeFiles/run_ahead_test.dir/DependInfo.cmake"
+  "CMakeFiles/worker_pool_test.dir/DependInfo.cmake"
+  "CMakeFiles/vec_env_test.dir/DependInfo.cmake"
+  "CMakeFiles/gbmu_bench.dir/DependInfo.cmake"
+  "_bench_build/external/gt/googlemock/CMakeFiles/gmock.dir/DependInfo.cmake"
+  "_bench_build/external/gt/googlemock/CMakeFiles/gmock_main.dir/DependInfo.cmake"
+  "_bench_build/external/gt/googletest/CMakeFiles/gtest.dir/DependInfo.cmake"
+  "_bench_build/external/gt/googletest/CMakeFiles/gtest_main.dir/DependInfo.cmake"
+  )
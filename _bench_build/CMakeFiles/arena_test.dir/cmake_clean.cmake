@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "/root/repo/bin/arena_test"
+  "/root/repo/bin/arena_test.pdb"
+  "CMakeFiles/arena_test.dir/test/arena.cc.o"
+  "CMakeFiles/arena_test.dir/test/arena.cc.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/arena_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
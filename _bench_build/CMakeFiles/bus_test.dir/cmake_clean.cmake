@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "/root/repo/bin/bus_test"
+  "/root/repo/bin/bus_test.pdb"
+  "CMakeFiles/bus_test.dir/test/bus.cc.o"
+  "CMakeFiles/bus_test.dir/test/bus.cc.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/bus_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
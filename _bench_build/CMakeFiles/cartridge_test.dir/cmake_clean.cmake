@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "/root/repo/bin/cartridge_test"
+  "/root/repo/bin/cartridge_test.pdb"
+  "CMakeFiles/cartridge_test.dir/test/cartridge.cc.o"
+  "CMakeFiles/cartridge_test.dir/test/cartridge.cc.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/cartridge_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
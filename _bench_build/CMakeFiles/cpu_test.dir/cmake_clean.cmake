@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "/root/repo/bin/cpu_test"
+  "/root/repo/bin/cpu_test.pdb"
+  "CMakeFiles/cpu_test.dir/test/cpu.cc.o"
+  "CMakeFiles/cpu_test.dir/test/cpu.cc.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/cpu_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
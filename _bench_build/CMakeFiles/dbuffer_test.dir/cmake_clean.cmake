@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "/root/repo/bin/dbuffer_test"
+  "/root/repo/bin/dbuffer_test.pdb"
+  "CMakeFiles/dbuffer_test.dir/test/dbuffer.cc.o"
+  "CMakeFiles/dbuffer_test.dir/test/dbuffer.cc.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/dbuffer_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
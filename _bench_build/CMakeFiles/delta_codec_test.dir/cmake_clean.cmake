@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "/root/repo/bin/delta_codec_test"
+  "/root/repo/bin/delta_codec_test.pdb"
+  "CMakeFiles/delta_codec_test.dir/test/delta_codec.cc.o"
+  "CMakeFiles/delta_codec_test.dir/test/delta_codec.cc.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/delta_codec_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "/root/repo/bin/dma_test"
+  "/root/repo/bin/dma_test.pdb"
+  "CMakeFiles/dma_test.dir/test/dma.cc.o"
+  "CMakeFiles/dma_test.dir/test/dma.cc.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/dma_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
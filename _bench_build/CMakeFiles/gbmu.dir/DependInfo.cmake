@@ -0,0 +1,36 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/sources/bus.cc" "CMakeFiles/gbmu.dir/sources/bus.cc.o" "gcc" "CMakeFiles/gbmu.dir/sources/bus.cc.o.d"
+  "/root/repo/sources/cartridge.cc" "CMakeFiles/gbmu.dir/sources/cartridge.cc.o" "gcc" "CMakeFiles/gbmu.dir/sources/cartridge.cc.o.d"
+  "/root/repo/sources/cpu.cc" "CMakeFiles/gbmu.dir/sources/cpu.cc.o" "gcc" "CMakeFiles/gbmu.dir/sources/cpu.cc.o.d"
+  "/root/repo/sources/delta_codec.cc" "CMakeFiles/gbmu.dir/sources/delta_codec.cc.o" "gcc" "CMakeFiles/gbmu.dir/sources/delta_codec.cc.o.d"
+  "/root/repo/sources/dma.cc" "CMakeFiles/gbmu.dir/sources/dma.cc.o" "gcc" "CMakeFiles/gbmu.dir/sources/dma.cc.o.d"
+  "/root/repo/sources/hdma.cc" "CMakeFiles/gbmu.dir/sources/hdma.cc.o" "gcc" "CMakeFiles/gbmu.dir/sources/hdma.cc.o.d"
+  "/root/repo/sources/hram.cc" "CMakeFiles/gbmu.dir/sources/hram.cc.o" "gcc" "CMakeFiles/gbmu.dir/sources/hram.cc.o.d"
+  "/root/repo/sources/interrupt.cc" "CMakeFiles/gbmu.dir/sources/interrupt.cc.o" "gcc" "CMakeFiles/gbmu.dir/sources/interrupt.cc.o.d"
+  "/root/repo/sources/joypad.cc" "CMakeFiles/gbmu.dir/sources/joypad.cc.o" "gcc" "CMakeFiles/gbmu.dir/sources/joypad.cc.o.d"
+  "/root/repo/sources/machine.cc" "CMakeFiles/gbmu.dir/sources/machine.cc.o" "gcc" "CMakeFiles/gbmu.dir/sources/machine.cc.o.d"
+  "/root/repo/sources/memory_resource.cc" "CMakeFiles/gbmu.dir/sources/memory_resource.cc.o" "gcc" "CMakeFiles/gbmu.dir/sources/memory_resource.cc.o.d"
+  "/root/repo/sources/oram.cc" "CMakeFiles/gbmu.dir/sources/oram.cc.o" "gcc" "CMakeFiles/gbmu.dir/sources/oram.cc.o.d"
+  "/root/repo/sources/rewind.cc" "CMakeFiles/gbmu.dir/sources/rewind.cc.o" "gcc" "CMakeFiles/gbmu.dir/sources/rewind.cc.o.d"
+  "/root/repo/sources/tile_decoder.cc" "CMakeFiles/gbmu.dir/sources/tile_decoder.cc.o" "gcc" "CMakeFiles/gbmu.dir/sources/tile_decoder.cc.o.d"
+  "/root/repo/sources/timer.cc" "CMakeFiles/gbmu.dir/sources/timer.cc.o" "gcc" "CMakeFiles/gbmu.dir/sources/timer.cc.o.d"
+  "/root/repo/sources/vram.cc" "CMakeFiles/gbmu.dir/sources/vram.cc.o" "gcc" "CMakeFiles/gbmu.dir/sources/vram.cc.o.d"
+  "/root/repo/sources/worker_pool.cc" "CMakeFiles/gbmu.dir/sources/worker_pool.cc.o" "gcc" "CMakeFiles/gbmu.dir/sources/worker_pool.cc.o.d"
+  "/root/repo/sources/wram.cc" "CMakeFiles/gbmu.dir/sources/wram.cc.o" "gcc" "CMakeFiles/gbmu.dir/sources/wram.cc.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
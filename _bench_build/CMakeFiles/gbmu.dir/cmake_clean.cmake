@@ -0,0 +1,45 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/gbmu.dir/sources/bus.cc.o"
+  "CMakeFiles/gbmu.dir/sources/bus.cc.o.d"
+  "CMakeFiles/gbmu.dir/sources/cartridge.cc.o"
+  "CMakeFiles/gbmu.dir/sources/cartridge.cc.o.d"
+  "CMakeFiles/gbmu.dir/sources/cpu.cc.o"
+  "CMakeFiles/gbmu.dir/sources/cpu.cc.o.d"
+  "CMakeFiles/gbmu.dir/sources/delta_codec.cc.o"
+  "CMakeFiles/gbmu.dir/sources/delta_codec.cc.o.d"
+  "CMakeFiles/gbmu.dir/sources/dma.cc.o"
+  "CMakeFiles/gbmu.dir/sources/dma.cc.o.d"
+  "CMakeFiles/gbmu.dir/sources/hdma.cc.o"
+  "CMakeFiles/gbmu.dir/sources/hdma.cc.o.d"
+  "CMakeFiles/gbmu.dir/sources/hram.cc.o"
+  "CMakeFiles/gbmu.dir/sources/hram.cc.o.d"
+  "CMakeFiles/gbmu.dir/sources/interrupt.cc.o"
+  "CMakeFiles/gbmu.dir/sources/interrupt.cc.o.d"
+  "CMakeFiles/gbmu.dir/sources/joypad.cc.o"
+  "CMakeFiles/gbmu.dir/sources/joypad.cc.o.d"
+  "CMakeFiles/gbmu.dir/sources/machine.cc.o"
+  "CMakeFiles/gbmu.dir/sources/machine.cc.o.d"
+  "CMakeFiles/gbmu.dir/sources/memory_resource.cc.o"
+  "CMakeFiles/gbmu.dir/sources/memory_resource.cc.o.d"
+  "CMakeFiles/gbmu.dir/sources/oram.cc.o"
+  "CMakeFiles/gbmu.dir/sources/oram.cc.o.d"
+  "CMakeFiles/gbmu.dir/sources/rewind.cc.o"
+  "CMakeFiles/gbmu.dir/sources/rewind.cc.o.d"
+  "CMakeFiles/gbmu.dir/sources/tile_decoder.cc.o"
+  "CMakeFiles/gbmu.dir/sources/tile_decoder.cc.o.d"
+  "CMakeFiles/gbmu.dir/sources/timer.cc.o"
+  "CMakeFiles/gbmu.dir/sources/timer.cc.o.d"
+  "CMakeFiles/gbmu.dir/sources/vram.cc.o"
+  "CMakeFiles/gbmu.dir/sources/vram.cc.o.d"
+  "CMakeFiles/gbmu.dir/sources/worker_pool.cc.o"
+  "CMakeFiles/gbmu.dir/sources/worker_pool.cc.o.d"
+  "CMakeFiles/gbmu.dir/sources/wram.cc.o"
+  "CMakeFiles/gbmu.dir/sources/wram.cc.o.d"
+  "libgbmu.a"
+  "libgbmu.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/gbmu.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,36 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/bench/arena.cc" "CMakeFiles/gbmu_bench.dir/bench/arena.cc.o" "gcc" "CMakeFiles/gbmu_bench.dir/bench/arena.cc.o.d"
+  "/root/repo/bench/cpu.cc" "CMakeFiles/gbmu_bench.dir/bench/cpu.cc.o" "gcc" "CMakeFiles/gbmu_bench.dir/bench/cpu.cc.o.d"
+  "/root/repo/bench/dbuffer.cc" "CMakeFiles/gbmu_bench.dir/bench/dbuffer.cc.o" "gcc" "CMakeFiles/gbmu_bench.dir/bench/dbuffer.cc.o.d"
+  "/root/repo/bench/dma.cc" "CMakeFiles/gbmu_bench.dir/bench/dma.cc.o" "gcc" "CMakeFiles/gbmu_bench.dir/bench/dma.cc.o.d"
+  "/root/repo/bench/hdma.cc" "CMakeFiles/gbmu_bench.dir/bench/hdma.cc.o" "gcc" "CMakeFiles/gbmu_bench.dir/bench/hdma.cc.o.d"
+  "/root/repo/bench/interrupt.cc" "CMakeFiles/gbmu_bench.dir/bench/interrupt.cc.o" "gcc" "CMakeFiles/gbmu_bench.dir/bench/interrupt.cc.o.d"
+  "/root/repo/bench/joypad.cc" "CMakeFiles/gbmu_bench.dir/bench/joypad.cc.o" "gcc" "CMakeFiles/gbmu_bench.dir/bench/joypad.cc.o.d"
+  "/root/repo/bench/machine.cc" "CMakeFiles/gbmu_bench.dir/bench/machine.cc.o" "gcc" "CMakeFiles/gbmu_bench.dir/bench/machine.cc.o.d"
+  "/root/repo/bench/oram.cc" "CMakeFiles/gbmu_bench.dir/bench/oram.cc.o" "gcc" "CMakeFiles/gbmu_bench.dir/bench/oram.cc.o.d"
+  "/root/repo/bench/rewind.cc" "CMakeFiles/gbmu_bench.dir/bench/rewind.cc.o" "gcc" "CMakeFiles/gbmu_bench.dir/bench/rewind.cc.o.d"
+  "/root/repo/bench/run_ahead.cc" "CMakeFiles/gbmu_bench.dir/bench/run_ahead.cc.o" "gcc" "CMakeFiles/gbmu_bench.dir/bench/run_ahead.cc.o.d"
+  "/root/repo/bench/scheduler.cc" "CMakeFiles/gbmu_bench.dir/bench/scheduler.cc.o" "gcc" "CMakeFiles/gbmu_bench.dir/bench/scheduler.cc.o.d"
+  "/root/repo/bench/tile_decoder.cc" "CMakeFiles/gbmu_bench.dir/bench/tile_decoder.cc.o" "gcc" "CMakeFiles/gbmu_bench.dir/bench/tile_decoder.cc.o.d"
+  "/root/repo/bench/timer.cc" "CMakeFiles/gbmu_bench.dir/bench/timer.cc.o" "gcc" "CMakeFiles/gbmu_bench.dir/bench/timer.cc.o.d"
+  "/root/repo/bench/vec_env.cc" "CMakeFiles/gbmu_bench.dir/bench/vec_env.cc.o" "gcc" "CMakeFiles/gbmu_bench.dir/bench/vec_env.cc.o.d"
+  "/root/repo/bench/vram.cc" "CMakeFiles/gbmu_bench.dir/bench/vram.cc.o" "gcc" "CMakeFiles/gbmu_bench.dir/bench/vram.cc.o.d"
+  "/root/repo/bench/wram.cc" "CMakeFiles/gbmu_bench.dir/bench/wram.cc.o" "gcc" "CMakeFiles/gbmu_bench.dir/bench/wram.cc.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_bench_build/CMakeFiles/gbmu.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
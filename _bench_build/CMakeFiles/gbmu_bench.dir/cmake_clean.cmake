@@ -0,0 +1,43 @@
+file(REMOVE_RECURSE
+  "/root/repo/bin/gbmu_bench"
+  "/root/repo/bin/gbmu_bench.pdb"
+  "CMakeFiles/gbmu_bench.dir/bench/arena.cc.o"
+  "CMakeFiles/gbmu_bench.dir/bench/arena.cc.o.d"
+  "CMakeFiles/gbmu_bench.dir/bench/cpu.cc.o"
+  "CMakeFiles/gbmu_bench.dir/bench/cpu.cc.o.d"
+  "CMakeFiles/gbmu_bench.dir/bench/dbuffer.cc.o"
+  "CMakeFiles/gbmu_bench.dir/bench/dbuffer.cc.o.d"
+  "CMakeFiles/gbmu_bench.dir/bench/dma.cc.o"
+  "CMakeFiles/gbmu_bench.dir/bench/dma.cc.o.d"
+  "CMakeFiles/gbmu_bench.dir/bench/hdma.cc.o"
+  "CMakeFiles/gbmu_bench.dir/bench/hdma.cc.o.d"
+  "CMakeFiles/gbmu_bench.dir/bench/interrupt.cc.o"
+  "CMakeFiles/gbmu_bench.dir/bench/interrupt.cc.o.d"
+  "CMakeFiles/gbmu_bench.dir/bench/joypad.cc.o"
+  "CMakeFiles/gbmu_bench.dir/bench/joypad.cc.o.d"
+  "CMakeFiles/gbmu_bench.dir/bench/machine.cc.o"
+  "CMakeFiles/gbmu_bench.dir/bench/machine.cc.o.d"
+  "CMakeFiles/gbmu_bench.dir/bench/oram.cc.o"
+  "CMakeFiles/gbmu_bench.dir/bench/oram.cc.o.d"
+  "CMakeFiles/gbmu_bench.dir/bench/rewind.cc.o"
+  "CMakeFiles/gbmu_bench.dir/bench/rewind.cc.o.d"
+  "CMakeFiles/gbmu_bench.dir/bench/run_ahead.cc.o"
+  "CMakeFiles/gbmu_bench.dir/bench/run_ahead.cc.o.d"
+  "CMakeFiles/gbmu_bench.dir/bench/scheduler.cc.o"
+  "CMakeFiles/gbmu_bench.dir/bench/scheduler.cc.o.d"
+  "CMakeFiles/gbmu_bench.dir/bench/tile_decoder.cc.o"
+  "CMakeFiles/gbmu_bench.dir/bench/tile_decoder.cc.o.d"
+  "CMakeFiles/gbmu_bench.dir/bench/timer.cc.o"
+  "CMakeFiles/gbmu_bench.dir/bench/timer.cc.o.d"
+  "CMakeFiles/gbmu_bench.dir/bench/vec_env.cc.o"
+  "CMakeFiles/gbmu_bench.dir/bench/vec_env.cc.o.d"
+  "CMakeFiles/gbmu_bench.dir/bench/vram.cc.o"
+  "CMakeFiles/gbmu_bench.dir/bench/vram.cc.o.d"
+  "CMakeFiles/gbmu_bench.dir/bench/wram.cc.o"
+  "CMakeFiles/gbmu_bench.dir/bench/wram.cc.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/gbmu_bench.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
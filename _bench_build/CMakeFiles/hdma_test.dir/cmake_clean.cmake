@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "/root/repo/bin/hdma_test"
+  "/root/repo/bin/hdma_test.pdb"
+  "CMakeFiles/hdma_test.dir/test/hdma.cc.o"
+  "CMakeFiles/hdma_test.dir/test/hdma.cc.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/hdma_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
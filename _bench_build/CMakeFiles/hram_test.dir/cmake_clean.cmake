@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "/root/repo/bin/hram_test"
+  "/root/repo/bin/hram_test.pdb"
+  "CMakeFiles/hram_test.dir/test/hram.cc.o"
+  "CMakeFiles/hram_test.dir/test/hram.cc.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/hram_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "/root/repo/bin/interrupt_ctrl_test"
+  "/root/repo/bin/interrupt_ctrl_test.pdb"
+  "CMakeFiles/interrupt_ctrl_test.dir/test/interrupt.cc.o"
+  "CMakeFiles/interrupt_ctrl_test.dir/test/interrupt.cc.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/interrupt_ctrl_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
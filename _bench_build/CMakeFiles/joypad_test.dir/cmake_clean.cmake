@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "/root/repo/bin/joypad_test"
+  "/root/repo/bin/joypad_test.pdb"
+  "CMakeFiles/joypad_test.dir/test/joypad.cc.o"
+  "CMakeFiles/joypad_test.dir/test/joypad.cc.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/joypad_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "/root/repo/bin/machine_test"
+  "/root/repo/bin/machine_test.pdb"
+  "CMakeFiles/machine_test.dir/test/machine.cc.o"
+  "CMakeFiles/machine_test.dir/test/machine.cc.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/machine_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "/root/repo/bin/oram_test"
+  "/root/repo/bin/oram_test.pdb"
+  "CMakeFiles/oram_test.dir/test/oram.cc.o"
+  "CMakeFiles/oram_test.dir/test/oram.cc.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/oram_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
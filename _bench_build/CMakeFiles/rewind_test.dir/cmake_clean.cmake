@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "/root/repo/bin/rewind_test"
+  "/root/repo/bin/rewind_test.pdb"
+  "CMakeFiles/rewind_test.dir/test/rewind.cc.o"
+  "CMakeFiles/rewind_test.dir/test/rewind.cc.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/rewind_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "/root/repo/bin/run_ahead_test"
+  "/root/repo/bin/run_ahead_test.pdb"
+  "CMakeFiles/run_ahead_test.dir/test/run_ahead.cc.o"
+  "CMakeFiles/run_ahead_test.dir/test/run_ahead.cc.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/run_ahead_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "/root/repo/bin/scheduler_test"
+  "/root/repo/bin/scheduler_test.pdb"
+  "CMakeFiles/scheduler_test.dir/test/scheduler.cc.o"
+  "CMakeFiles/scheduler_test.dir/test/scheduler.cc.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/scheduler_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
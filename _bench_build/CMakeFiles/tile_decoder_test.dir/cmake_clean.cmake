@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "/root/repo/bin/tile_decoder_test"
+  "/root/repo/bin/tile_decoder_test.pdb"
+  "CMakeFiles/tile_decoder_test.dir/test/tile_decoder.cc.o"
+  "CMakeFiles/tile_decoder_test.dir/test/tile_decoder.cc.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/tile_decoder_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
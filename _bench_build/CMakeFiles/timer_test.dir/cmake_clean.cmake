@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "/root/repo/bin/timer_test"
+  "/root/repo/bin/timer_test.pdb"
+  "CMakeFiles/timer_test.dir/test/timer.cc.o"
+  "CMakeFiles/timer_test.dir/test/timer.cc.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/timer_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
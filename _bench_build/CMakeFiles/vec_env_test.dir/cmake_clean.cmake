@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "/root/repo/bin/vec_env_test"
+  "/root/repo/bin/vec_env_test.pdb"
+  "CMakeFiles/vec_env_test.dir/test/vec_env.cc.o"
+  "CMakeFiles/vec_env_test.dir/test/vec_env.cc.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/vec_env_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
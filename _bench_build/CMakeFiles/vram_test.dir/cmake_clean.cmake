@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "/root/repo/bin/vram_test"
+  "/root/repo/bin/vram_test.pdb"
+  "CMakeFiles/vram_test.dir/test/vram.cc.o"
+  "CMakeFiles/vram_test.dir/test/vram.cc.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/vram_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "/root/repo/bin/worker_pool_test"
+  "/root/repo/bin/worker_pool_test.pdb"
+  "CMakeFiles/worker_pool_test.dir/test/worker_pool.cc.o"
+  "CMakeFiles/worker_pool_test.dir/test/worker_pool.cc.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/worker_pool_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
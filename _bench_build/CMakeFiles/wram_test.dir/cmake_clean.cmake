@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "/root/repo/bin/wram_test"
+  "/root/repo/bin/wram_test.pdb"
+  "CMakeFiles/wram_test.dir/test/wram.cc.o"
+  "CMakeFiles/wram_test.dir/test/wram.cc.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/wram_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,53 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo
+# Build directory: /root/repo/_bench_build
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test(interrupt_ctrl_test "/root/repo/bin/interrupt_ctrl_test" "--gtest_print_time=0")
+set_tests_properties(interrupt_ctrl_test PROPERTIES  WORKING_DIRECTORY "/root/repo/test" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;110;add_test;/root/repo/CMakeLists.txt;119;ADD_GBMU_LIB_TEST;/root/repo/CMakeLists.txt;0;")
+add_test(wram_test "/root/repo/bin/wram_test" "--gtest_print_time=0")
+set_tests_properties(wram_test PROPERTIES  WORKING_DIRECTORY "/root/repo/test" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;110;add_test;/root/repo/CMakeLists.txt;120;ADD_GBMU_LIB_TEST;/root/repo/CMakeLists.txt;0;")
+add_test(joypad_test "/root/repo/bin/joypad_test" "--gtest_print_time=0")
+set_tests_properties(joypad_test PROPERTIES  WORKING_DIRECTORY "/root/repo/test" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;110;add_test;/root/repo/CMakeLists.txt;121;ADD_GBMU_LIB_TEST;/root/repo/CMakeLists.txt;0;")
+add_test(timer_test "/root/repo/bin/timer_test" "--gtest_print_time=0")
+set_tests_properties(timer_test PROPERTIES  WORKING_DIRECTORY "/root/repo/test" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;110;add_test;/root/repo/CMakeLists.txt;122;ADD_GBMU_LIB_TEST;/root/repo/CMakeLists.txt;0;")
+add_test(oram_test "/root/repo/bin/oram_test" "--gtest_print_time=0")
+set_tests_properties(oram_test PROPERTIES  WORKING_DIRECTORY "/root/repo/test" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;110;add_test;/root/repo/CMakeLists.txt;123;ADD_GBMU_LIB_TEST;/root/repo/CMakeLists.txt;0;")
+add_test(vram_test "/root/repo/bin/vram_test" "--gtest_print_time=0")
+set_tests_properties(vram_test PROPERTIES  WORKING_DIRECTORY "/root/repo/test" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;110;add_test;/root/repo/CMakeLists.txt;124;ADD_GBMU_LIB_TEST;/root/repo/CMakeLists.txt;0;")
+add_test(hram_test "/root/repo/bin/hram_test" "--gtest_print_time=0")
+set_tests_properties(hram_test PROPERTIES  WORKING_DIRECTORY "/root/repo/test" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;110;add_test;/root/repo/CMakeLists.txt;125;ADD_GBMU_LIB_TEST;/root/repo/CMakeLists.txt;0;")
+add_test(bus_test "/root/repo/bin/bus_test" "--gtest_print_time=0")
+set_tests_properties(bus_test PROPERTIES  WORKING_DIRECTORY "/root/repo/test" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;110;add_test;/root/repo/CMakeLists.txt;126;ADD_GBMU_LIB_TEST;/root/repo/CMakeLists.txt;0;")
+add_test(arena_test "/root/repo/bin/arena_test" "--gtest_print_time=0")
+set_tests_properties(arena_test PROPERTIES  WORKING_DIRECTORY "/root/repo/test" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;110;add_test;/root/repo/CMakeLists.txt;127;ADD_GBMU_LIB_TEST;/root/repo/CMakeLists.txt;0;")
+add_test(dbuffer_test "/root/repo/bin/dbuffer_test" "--gtest_print_time=0")
+set_tests_properties(dbuffer_test PROPERTIES  WORKING_DIRECTORY "/root/repo/test" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;110;add_test;/root/repo/CMakeLists.txt;128;ADD_GBMU_LIB_TEST;/root/repo/CMakeLists.txt;0;")
+add_test(scheduler_test "/root/repo/bin/scheduler_test" "--gtest_print_time=0")
+set_tests_properties(scheduler_test PROPERTIES  WORKING_DIRECTORY "/root/repo/test" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;110;add_test;/root/repo/CMakeLists.txt;129;ADD_GBMU_LIB_TEST;/root/repo/CMakeLists.txt;0;")
+add_test(cartridge_test "/root/repo/bin/cartridge_test" "--gtest_print_time=0")
+set_tests_properties(cartridge_test PROPERTIES  WORKING_DIRECTORY "/root/repo/test" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;110;add_test;/root/repo/CMakeLists.txt;130;ADD_GBMU_LIB_TEST;/root/repo/CMakeLists.txt;0;")
+add_test(tile_decoder_test "/root/repo/bin/tile_decoder_test" "--gtest_print_time=0")
+set_tests_properties(tile_decoder_test PROPERTIES  WORKING_DIRECTORY "/root/repo/test" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;110;add_test;/root/repo/CMakeLists.txt;131;ADD_GBMU_LIB_TEST;/root/repo/CMakeLists.txt;0;")
+add_test(dma_test "/root/repo/bin/dma_test" "--gtest_print_time=0")
+set_tests_properties(dma_test PROPERTIES  WORKING_DIRECTORY "/root/repo/test" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;110;add_test;/root/repo/CMakeLists.txt;132;ADD_GBMU_LIB_TEST;/root/repo/CMakeLists.txt;0;")
+add_test(hdma_test "/root/repo/bin/hdma_test" "--gtest_print_time=0")
+set_tests_properties(hdma_test PROPERTIES  WORKING_DIRECTORY "/root/repo/test" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;110;add_test;/root/repo/CMakeLists.txt;133;ADD_GBMU_LIB_TEST;/root/repo/CMakeLists.txt;0;")
+add_test(cpu_test "/root/repo/bin/cpu_test" "--gtest_print_time=0")
+set_tests_properties(cpu_test PROPERTIES  WORKING_DIRECTORY "/root/repo/test" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;110;add_test;/root/repo/CMakeLists.txt;134;ADD_GBMU_LIB_TEST;/root/repo/CMakeLists.txt;0;")
+add_test(machine_test "/root/repo/bin/machine_test" "--gtest_print_time=0")
+set_tests_properties(machine_test PROPERTIES  WORKING_DIRECTORY "/root/repo/test" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;110;add_test;/root/repo/CMakeLists.txt;135;ADD_GBMU_LIB_TEST;/root/repo/CMakeLists.txt;0;")
+add_test(delta_codec_test "/root/repo/bin/delta_codec_test" "--gtest_print_time=0")
+set_tests_properties(delta_codec_test PROPERTIES  WORKING_DIRECTORY "/root/repo/test" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;110;add_test;/root/repo/CMakeLists.txt;136;ADD_GBMU_LIB_TEST;/root/repo/CMakeLists.txt;0;")
+add_test(rewind_test "/root/repo/bin/rewind_test" "--gtest_print_time=0")
+set_tests_properties(rewind_test PROPERTIES  WORKING_DIRECTORY "/root/repo/test" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;110;add_test;/root/repo/CMakeLists.txt;137;ADD_GBMU_LIB_TEST;/root/repo/CMakeLists.txt;0;")
+add_test(run_ahead_test "/root/repo/bin/run_ahead_test" "--gtest_print_time=0")
+set_tests_properties(run_ahead_test PROPERTIES  WORKING_DIRECTORY "/root/repo/test" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;110;add_test;/root/repo/CMakeLists.txt;138;ADD_GBMU_LIB_TEST;/root/repo/CMakeLists.txt;0;")
+add_test(worker_pool_test "/root/repo/bin/worker_pool_test" "--gtest_print_time=0")
+set_tests_properties(worker_pool_test PROPERTIES  WORKING_DIRECTORY "/root/repo/test" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;110;add_test;/root/repo/CMakeLists.txt;139;ADD_GBMU_LIB_TEST;/root/repo/CMakeLists.txt;0;")
+add_test(vec_env_test "/root/repo/bin/vec_env_test" "--gtest_print_time=0")
+set_tests_properties(vec_env_test PROPERTIES  WORKING_DIRECTORY "/root/repo/test" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;110;add_test;/root/repo/CMakeLists.txt;140;ADD_GBMU_LIB_TEST;/root/repo/CMakeLists.txt;0;")
+subdirs("_bench_build/external/spdlog")
+subdirs("_bench_build/external/gt")
+subdirs("_bench_build/external/benchmark")
@@ -0,0 +1,6 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/_bench_build/external/gt/googletest
+# Build directory: /root/repo/_bench_build/_bench_build/external/gt/googletest
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
@@ -0,0 +1,87 @@
+#include "benchmark/benchmark.h"
+
+#include "GB_config.h"
+#include "device/GB_hram.h"
+#include "device/GB_oram.h"
+#include "device/GB_vram.h"
+#include "device/GB_wram.h"
+#include "memory/GB_arena.h"
+
+namespace {
+
+using Arena = GB::memory::Arena<GB::CGB_MODE>;
+using WRAM = GB::device::WRAM<GB::CGB_MODE>;
+using VRAM = GB::device::VRAM<GB::CGB_MODE>;
+
+/* Memory devices, which own separate heap buffers */
+
+struct HeapDevices {
+    WRAM                wram;
+    VRAM                vram;
+    GB::device::ORAM    oram;
+    GB::device::HRAM    hram;
+};
+
+/* Memory devices, which keep their storage in one arena */
+
+struct ArenaDevices {
+    Arena               arena;
+    WRAM                wram;
+    VRAM                vram;
+    GB::device::ORAM    oram;
+    GB::device::HRAM    hram;
+
+    ArenaDevices()
+    : arena()
+    , wram(arena.view(Arena::WRAM_REGION))
+    , vram(arena.view(Arena::VRAM_REGION))
+    , oram(arena.view(Arena::OAM_REGION))
+    , hram(arena.view(Arena::HRAM_REGION)) {}
+};
+
+void BM_Devices_Create_Heap(benchmark::State& state) {
+    for (auto _ : state) {
+        HeapDevices devices;
+        benchmark::DoNotOptimize(&devices);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Devices_Create_Heap)->Name("Memory/create/heap");
+
+void BM_Devices_Create_Arena(benchmark::State& state) {
+    for (auto _ : state) {
+        ArenaDevices devices;
+        benchmark::DoNotOptimize(&devices);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Devices_Create_Arena)->Name("Memory/create/arena");
+
+void BM_Devices_Snapshot_Heap(benchmark::State& state) {
+    HeapDevices devices;
+    HeapDevices snapshot;
+
+    for (auto _ : state) {
+        snapshot.wram = devices.wram;
+        snapshot.vram = devices.vram;
+        snapshot.oram = devices.oram;
+        snapshot.hram = devices.hram;
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Devices_Snapshot_Heap)->Name("Memory/snapshot/heap");
+
+void BM_Devices_Snapshot_Arena(benchmark::State& state) {
+    ArenaDevices    devices;
+    dbuffer_t       snapshot;
+
+    for (auto _ : state) {
+        devices.arena.save(snapshot);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Devices_Snapshot_Arena)->Name("Memory/snapshot/arena");
+
+}  // namespace
@@ -0,0 +1,71 @@
+#include <algorithm>
+#include <iterator>
+
+#include "benchmark/benchmark.h"
+
+#include "GB_config.h"
+#include "common/GB_clock.h"
+#include "core/GB_machine.h"
+
+namespace {
+
+using Machine = GB::core::Machine<GB::DMG_MODE>;
+
+constexpr clk_cycle_t FRAME_CYCLES = 70224;
+constexpr double CLOCK_RATE = 4194304.0;
+
+/** Busy loop, which copies and sums WRAM bytes without HALT */
+dbuffer_t make_busy_rom() {
+    dbuffer_t rom(32_KBytes);
+    const byte_t program[] = {
+        0x21, 0x00, 0xC0,   // 0100: LD HL,0xC000
+        0x11, 0x00, 0xD0,   // 0103: LD DE,0xD000
+        0x0E, 0x00,         // 0106: LD C,0x00
+        0x2A,               // 0108: LD A,(HL+)
+        0x80,               // 0109: ADD A,B
+        0x47,               // 010A: LD B,A
+        0x12,               // 010B: LD (DE),A
+        0x1C,               // 010C: INC E
+        0xCB, 0x38,         // 010D: SRL B
+        0x0D,               // 010F: DEC C
+        0x20, 0xF6,         // 0110: JR NZ,0x0108
+        0xC3, 0x00, 0x01,   // 0112: JP 0x0100
+    };
+
+    for (size_t i = 0; i < rom.size(); ++i)
+        rom[i] = 0x0;
+    std::copy(std::begin(program), std::end(program), &rom[GB::CPU_PC_INIT_VALUE]);
+    return rom;
+}
+
+/* Machine runs CPU and devices for a frame, speed is a multiple of real time */
+
+void BM_CPU_Frame_Steps(benchmark::State& state) {
+    Machine     machine(make_busy_rom());
+    auto&       scheduler = machine.get_scheduler();
+    auto&       cpu = machine.get_cpu();
+
+    for (auto _ : state) {
+        const clk_cycle_t limit = scheduler.get_time() + FRAME_CYCLES;
+
+        while (scheduler.get_time() < limit)
+            scheduler.advance(cpu.step());
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.counters["realtime_x"] = benchmark::Counter(double(state.iterations()) * FRAME_CYCLES / CLOCK_RATE
+                                                    , benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_CPU_Frame_Steps)->Name("CPU/busy_frame/steps");
+
+void BM_CPU_Frame(benchmark::State& state) {
+    Machine machine(make_busy_rom());
+
+    for (auto _ : state)
+        machine.run(machine.get_scheduler().get_time() + FRAME_CYCLES);
+    state.SetItemsProcessed(state.iterations());
+    state.counters["realtime_x"] = benchmark::Counter(double(state.iterations()) * FRAME_CYCLES / CLOCK_RATE
+                                                    , benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_CPU_Frame)->Name("CPU/busy_frame/machine");
+
+}  // namespace
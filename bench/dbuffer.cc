@@ -0,0 +1,32 @@
+#include <utility>
+
+#include "benchmark/benchmark.h"
+
+#include "common/GB_dbuffer.h"
+
+namespace {
+
+void BM_DBuffer_Copy(benchmark::State& state) {
+    const dbuffer_t source(state.range(0));
+
+    for (auto _ : state) {
+        dbuffer_t copy(source);
+        benchmark::DoNotOptimize(copy.get_data_addr());
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_DBuffer_Copy)->Name("DBuffer/copy")->RangeMultiplier(8)->Range(0x80, 0x8000);
+
+void BM_DBuffer_Move(benchmark::State& state) {
+    dbuffer_t buffer(state.range(0));
+
+    for (auto _ : state) {
+        dbuffer_t moved(std::move(buffer));
+        buffer = std::move(moved);
+        benchmark::DoNotOptimize(&buffer);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_DBuffer_Move)->Name("DBuffer/move")->RangeMultiplier(8)->Range(0x80, 0x8000);
+
+}  // namespace
@@ -0,0 +1,58 @@
+#include "benchmark/benchmark.h"
+
+#include "GB_config.h"
+#include "common/GB_clock.h"
+#include "common/GB_scheduler.h"
+#include "device/GB_dma.h"
+#include "device/GB_oram.h"
+#include "device/GB_wram.h"
+#include "memory/GB_bus.h"
+#include "memory/GB_vaddr.h"
+
+namespace {
+
+using Bus = GB::memory::BusInterface;
+using DMA = GB::device::DMA;
+using ORAM = GB::device::ORAM;
+using WRAM = GB::device::WRAM<GB::CGB_MODE>;
+
+/* OAM DMA as 160 byte transactions, one per M-cycle */
+
+void BM_DMA_Bytewise(benchmark::State& state) {
+    Bus     bus;
+    WRAM    wram;
+    ORAM    oram;
+
+    wram.map_to_memory(bus);
+    oram.map_to_memory(bus);
+    for (auto _ : state) {
+        for (word_t offset = 0; offset < DMA::TRANSFER_SIZE; ++offset)
+            bus.write(GB::memory::OAM_RAM_BASE_VADDR + offset, bus.read(0xC000 + offset));
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_DMA_Bytewise)->Name("DMA/oam_transfer/bytewise");
+
+/* OAM DMA controller, which copies the block at the end of the transfer */
+
+void BM_DMA_Controller(benchmark::State& state) {
+    Bus                 bus;
+    devsync::Scheduler  scheduler;
+    WRAM                wram;
+    ORAM                oram;
+    DMA                 dma(&oram, &scheduler);
+
+    wram.map_to_memory(bus);
+    oram.map_to_memory(bus);
+    dma.map_to_memory(bus);
+    for (auto _ : state) {
+        bus.write(GB::memory::DMA_VADDR, 0xC0);
+        scheduler.advance(DMA::STARTUP_CYCLES + DMA::TRANSFER_CYCLES);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_DMA_Controller)->Name("DMA/oam_transfer/controller");
+
+}  // namespace
@@ -0,0 +1,63 @@
+#include "benchmark/benchmark.h"
+
+#include "GB_config.h"
+#include "device/GB_hdma.h"
+#include "device/GB_vram.h"
+#include "device/GB_wram.h"
+#include "memory/GB_bus.h"
+#include "memory/GB_vaddr.h"
+
+namespace {
+
+using Bus = GB::memory::BusInterface;
+using HDMA = GB::device::HDMA<GB::CGB_MODE>;
+using VRAM = GB::device::VRAM<GB::CGB_MODE>;
+using WRAM = GB::device::WRAM<GB::CGB_MODE>;
+
+constexpr unsigned FRAME_BLOCKS_NUM = GB::LCD_HEIGHT / 2;    ///< tile streaming, a block per HBlank
+
+/* HBlank streaming as byte transactions through the bus */
+
+void BM_HDMA_Bytewise(benchmark::State& state) {
+    Bus     bus;
+    WRAM    wram;
+    VRAM    vram;
+
+    wram.map_to_memory(bus);
+    vram.map_to_memory(bus);
+    for (auto _ : state) {
+        for (word_t offset = 0; offset < FRAME_BLOCKS_NUM * HDMA::BLOCK_SIZE; ++offset)
+            bus.write(GB::memory::VRAM_BASE_VADDR + offset, bus.read(0xC000 + offset));
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * FRAME_BLOCKS_NUM);
+}
+BENCHMARK(BM_HDMA_Bytewise)->Name("HDMA/hblank_frame/bytewise");
+
+/* HBlank streaming by the controller, which copies block spans */
+
+void BM_HDMA_Controller(benchmark::State& state) {
+    Bus     bus;
+    WRAM    wram;
+    VRAM    vram;
+    HDMA    hdma(&vram);
+
+    wram.map_to_memory(bus);
+    vram.map_to_memory(bus);
+    hdma.map_to_memory(bus);
+    for (auto _ : state) {
+        bus.write(GB::memory::HDMA1_VADDR, 0xC0);
+        bus.write(GB::memory::HDMA2_VADDR, 0x00);
+        bus.write(GB::memory::HDMA3_VADDR, 0x00);
+        bus.write(GB::memory::HDMA4_VADDR, 0x00);
+        bus.write(GB::memory::HDMA5_VADDR, 0x80 | (FRAME_BLOCKS_NUM - 1));
+        for (unsigned line = 0; line < FRAME_BLOCKS_NUM; ++line)
+            hdma.on_hblank();
+        benchmark::DoNotOptimize(hdma.take_stall_cycles());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * FRAME_BLOCKS_NUM);
+}
+BENCHMARK(BM_HDMA_Controller)->Name("HDMA/hblank_frame/controller");
+
+}  // namespace
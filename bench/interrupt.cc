@@ -0,0 +1,35 @@
+#include "benchmark/benchmark.h"
+
+#include "common/GB_macro.h"
+#include "device/GB_interrupt.h"
+
+namespace {
+
+using IntController = GB::device::InterruptController;
+
+void BM_Bit_LSB(benchmark::State& state) {
+    uint16_t bitset = 1;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(::bit_lsb(bitset));
+        bitset = uint16_t(bitset * 5 + 1) | 0x8000;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Bit_LSB)->Name("Macro/bit_lsb");
+
+void BM_Highest_Priority_Interrupt(benchmark::State& state) {
+    IntController int_ctrl;
+
+    int_ctrl.set_IE_reg(0x1F);
+
+    byte_t requests = 0;
+    for (auto _ : state) {
+        int_ctrl.set_IF_reg(requests);
+        benchmark::DoNotOptimize(int_ctrl.get_highest_priority_interrupt());
+        requests = (requests + 1) & 0x1F;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Highest_Priority_Interrupt)->Name("InterruptController/highest_priority");
+
+}  // namespace
@@ -0,0 +1,73 @@
+#include "benchmark/benchmark.h"
+
+#include "common/GB_clock.h"
+#include "common/GB_scheduler.h"
+#include "device/GB_interrupt.h"
+#include "device/GB_joypad.h"
+#include "memory/GB_bus.h"
+#include "memory/GB_vaddr.h"
+
+namespace {
+
+using JoyPad = GB::device::JoyPad;
+using Vaddr = GB::memory::VirtualAddress;
+
+constexpr clk_cycle_t FRAME_CYCLES = 70224;
+constexpr unsigned P1_READS_PER_FRAME = 4;
+constexpr clk_cycle_t READ_PERIOD = FRAME_CYCLES / P1_READS_PER_FRAME;
+
+void BM_JoyPad_Get_P1(benchmark::State& state) {
+    JoyPad jp(nullptr);
+
+    jp.press_key(JoyPad::A_KEY);
+    jp.press_key(JoyPad::UP_KEY);
+
+    byte_t select = 0b010000;
+    for (auto _ : state) {
+        jp.set_P1_reg(select);
+        benchmark::DoNotOptimize(jp.get_P1_reg());
+        select ^= 0b110000;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_JoyPad_Get_P1)->Name("JoyPad/get_P1");
+
+/* Joypad, which is stepped every M-cycle */
+
+void BM_JoyPad_Frame_Lockstep(benchmark::State& state) {
+    GB::device::InterruptController int_ctrl;
+    GB::memory::BusInterface        bus;
+    JoyPad                          jp(&int_ctrl);
+
+    jp.map_to_memory(bus);
+    for (auto _ : state) {
+        for (unsigned read = 0; read < P1_READS_PER_FRAME; ++read) {
+            for (clk_cycle_t time = 0; time < READ_PERIOD; time += 1_MCycles)
+                jp.step();
+            benchmark::DoNotOptimize(bus.read(Vaddr::P1_VADDR));
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_JoyPad_Frame_Lockstep)->Name("JoyPad/frame/lockstep");
+
+/* Joypad, which catches up on P1 access only, while the core commits cycles between accesses */
+
+void BM_JoyPad_Frame_Lazy(benchmark::State& state) {
+    devsync::Scheduler              scheduler;
+    GB::device::InterruptController int_ctrl;
+    GB::memory::BusInterface        bus;
+    JoyPad                          jp(&int_ctrl, scheduler.get_clock());
+
+    jp.map_to_memory(bus);
+    for (auto _ : state) {
+        for (unsigned read = 0; read < P1_READS_PER_FRAME; ++read) {
+            scheduler.advance(READ_PERIOD);
+            benchmark::DoNotOptimize(bus.read(Vaddr::P1_VADDR));
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_JoyPad_Frame_Lazy)->Name("JoyPad/frame/lazy");
+
+}  // namespace
@@ -0,0 +1,88 @@
+#include "benchmark/benchmark.h"
+
+#include "GB_config.h"
+#include "common/GB_clock.h"
+#include "core/GB_machine.h"
+#include "memory/GB_vaddr.h"
+
+namespace {
+
+using Machine = GB::core::Machine<GB::DMG_MODE>;
+using IntController = GB::device::InterruptController;
+
+constexpr clk_cycle_t FRAME_CYCLES = 70224;
+constexpr byte_t FRAME_TMA = 0x100 - 68;    ///< timer overflows about once per frame (68 * 1024 cycles)
+
+/** Game, which waits in HALT for the timer interrupt once per frame */
+void setup_halted_game(Machine& machine) {
+    auto& bus = machine.get_bus();
+
+    bus.write(GB::memory::IE_VADDR, IntController::interrupts<IntController::TIMOVER_INT>);
+    bus.write(GB::memory::TMA_VADDR, FRAME_TMA);
+    bus.write(GB::memory::TIMA_VADDR, FRAME_TMA);
+    bus.write(GB::memory::TAC_VADDR, 0x04);
+}
+
+/* Halted CPU, which checks pending interrupt every M-cycle */
+
+void BM_Halt_Stepped(benchmark::State& state) {
+    Machine machine;
+    auto&   scheduler = machine.get_scheduler();
+    auto&   int_ctrl = machine.get_interrupt_controller();
+
+    setup_halted_game(machine);
+    for (auto _ : state) {
+        const clk_cycle_t limit = scheduler.get_time() + FRAME_CYCLES;
+
+        while (!int_ctrl.has_pending_interrupt() && scheduler.get_time() < limit)
+            scheduler.advance(1_MCycles);
+        int_ctrl.reset_interrupt(IntController::TIMOVER_INT);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Halt_Stepped)->Name("Machine/halt_frame/stepped");
+
+/* Halted CPU, which jumps to the next pending interrupt */
+
+void BM_Halt_Fast_Forward(benchmark::State& state) {
+    Machine machine;
+    auto&   scheduler = machine.get_scheduler();
+    auto&   int_ctrl = machine.get_interrupt_controller();
+
+    setup_halted_game(machine);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(machine.fast_forward_halt(scheduler.get_time() + FRAME_CYCLES));
+        int_ctrl.reset_interrupt(IntController::TIMOVER_INT);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Halt_Fast_Forward)->Name("Machine/halt_frame/fast_forward");
+
+/* Save-state image is the device state blocks and one copy of the arena */
+
+void BM_Save_State(benchmark::State& state) {
+    Machine     machine;
+    dbuffer_t   image;
+
+    setup_halted_game(machine);
+    for (auto _ : state) {
+        machine.save_state(image);
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * machine.get_state_size());
+}
+BENCHMARK(BM_Save_State)->Name("Machine/save_state");
+
+void BM_Load_State(benchmark::State& state) {
+    Machine     machine;
+    dbuffer_t   image;
+
+    setup_halted_game(machine);
+    machine.save_state(image);
+    for (auto _ : state)
+        benchmark::DoNotOptimize(machine.load_state(image));
+    state.SetBytesProcessed(state.iterations() * machine.get_state_size());
+}
+BENCHMARK(BM_Load_State)->Name("Machine/load_state");
+
+}  // namespace
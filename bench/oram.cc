@@ -0,0 +1,58 @@
+#include "benchmark/benchmark.h"
+
+#include "GB_config.h"
+#include "device/GB_oram.h"
+
+namespace {
+
+using ORAM = GB::device::ORAM;
+
+void place_objects(ORAM& oram) {
+    for (unsigned object = 0; object < GB::ORAM_OBJECTS_NUM; ++object)
+        oram.write_phys_addr(object * ORAM::OBJECT_SIZE, byte_t(object * 37 % 176));
+}
+
+/* OAM scan of all 144 lines, which checks all 40 objects on every line */
+
+void BM_ORAM_Frame_Scan(benchmark::State& state) {
+    ORAM    oram;
+    byte_t  objects[ORAM::LINE_OBJECTS_MAX];
+
+    place_objects(oram);
+    for (auto _ : state) {
+        for (unsigned line = 0; line < GB::LCD_HEIGHT; ++line) {
+            unsigned objects_num = 0;
+            for (unsigned object = 0; object < GB::ORAM_OBJECTS_NUM; ++object) {
+                const unsigned top = oram.read_phys_addr(object * ORAM::OBJECT_SIZE);
+                if (line + ORAM::OBJECT_Y_OFFSET >= top && line + ORAM::OBJECT_Y_OFFSET < top + 16) {
+                    objects[objects_num++] = byte_t(object);
+                    if (objects_num == ORAM::LINE_OBJECTS_MAX)
+                        break;
+                }
+            }
+            benchmark::DoNotOptimize(objects_num);
+            benchmark::DoNotOptimize(objects);
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ORAM_Frame_Scan)->Name("ORAM/frame_select/scan");
+
+/* OAM scan of all 144 lines with the objects index */
+
+void BM_ORAM_Frame_Index(benchmark::State& state) {
+    ORAM    oram;
+    byte_t  objects[ORAM::LINE_OBJECTS_MAX];
+
+    place_objects(oram);
+    for (auto _ : state) {
+        for (unsigned line = 0; line < GB::LCD_HEIGHT; ++line)
+            benchmark::DoNotOptimize(oram.select_line_objects(line, true, objects));
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ORAM_Frame_Index)->Name("ORAM/frame_select/index");
+
+}  // namespace
@@ -0,0 +1,74 @@
+#include <algorithm>
+#include <iterator>
+#include <utility>
+
+#include "benchmark/benchmark.h"
+
+#include "GB_config.h"
+#include "common/GB_dbuffer.h"
+#include "core/GB_machine.h"
+#include "core/GB_rewind.h"
+
+namespace {
+
+using Machine = GB::core::Machine<GB::CGB_MODE>;
+using GB::core::Rewind;
+
+constexpr clk_cycle_t FRAME_CYCLES = 70224;
+constexpr size_t REWIND_BUDGET = 16_MBytes;
+
+/** Game, which increments bytes of WRAM in a loop */
+dbuffer_t make_busy_rom() {
+    dbuffer_t rom(32_KBytes);
+    const byte_t program[] = {
+        0x21, 0x00, 0xC0,   // LD HL,0xC000
+        0x34,               // INC (HL)
+        0x2C,               // INC L
+        0x18, 0xFC,         // JR -4
+    };
+
+    std::fill(rom.get_data_addr(), rom.get_data_addr() + rom.size(), 0x0);
+    std::copy(std::begin(program), std::end(program), &rom[GB::CPU_PC_INIT_VALUE]);
+    return rom;
+}
+
+/* State is saved and compressed after every frame */
+
+void BM_Rewind_Push(benchmark::State& state) {
+    Machine machine(make_busy_rom());
+    Rewind  rewind(REWIND_BUDGET);
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        machine.run(machine.get_scheduler().get_time() + FRAME_CYCLES);
+        state.ResumeTiming();
+
+        rewind.push(machine);
+    }
+    state.counters["bytes_per_state"] = double(rewind.get_used_bytes()) / double(std::max<size_t>(rewind.size(), 1));
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Rewind_Push)->Name("Rewind/push_frame");
+
+/* Stepping back decodes one delta and restores the machine */
+
+void BM_Rewind_Step_Back(benchmark::State& state) {
+    Machine machine(make_busy_rom());
+    Rewind  rewind(REWIND_BUDGET);
+
+    for (auto _ : state) {
+        if (rewind.empty()) {
+            state.PauseTiming();
+            for (unsigned frame = 0; frame < 4 * Rewind::DEFAULT_KEYFRAME_INTERVAL; ++frame) {
+                machine.run(machine.get_scheduler().get_time() + FRAME_CYCLES);
+                rewind.push(machine);
+            }
+            state.ResumeTiming();
+        }
+        benchmark::DoNotOptimize(rewind.step_back(machine));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Rewind_Step_Back)->Name("Rewind/step_back");
+
+}  // namespace
@@ -0,0 +1,75 @@
+#include <algorithm>
+#include <iterator>
+
+#include "benchmark/benchmark.h"
+
+#include "GB_config.h"
+#include "core/GB_machine.h"
+#include "core/GB_run_ahead.h"
+#include "device/GB_joypad.h"
+
+namespace {
+
+using Machine = GB::core::Machine<GB::DMG_MODE>;
+using RunAhead = GB::core::RunAhead<GB::DMG_MODE>;
+using JoyPad = GB::device::JoyPad;
+
+constexpr unsigned FRAMES_AHEAD = 2;
+
+/** Game, which polls the joypad in a busy loop */
+dbuffer_t make_polling_rom() {
+    dbuffer_t rom(32_KBytes);
+    const byte_t program[] = {
+        0x3E, 0x20,         // LD A,0x20
+        0xE0, 0x00,         // LDH (P1),A
+        0xF0, 0x00,         // LDH A,(P1)
+        0xEA, 0x00, 0xC0,   // LD (0xC000),A
+        0x21, 0x01, 0xC0,   // LD HL,0xC001
+        0x34,               // INC (HL)
+        0x18, 0xF1,         // JR -15
+    };
+
+    std::fill(rom.get_data_addr(), rom.get_data_addr() + rom.size(), 0x0);
+    std::copy(std::begin(program), std::end(program), &rom[GB::CPU_PC_INIT_VALUE]);
+    return rom;
+}
+
+/* Frame without run-ahead is the base line */
+
+void BM_Frame(benchmark::State& state) {
+    Machine machine(make_polling_rom());
+
+    for (auto _ : state)
+        machine.run_frame();
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Frame)->Name("RunAhead/frame/off");
+
+/* Held input keeps the speculation, so a frame costs two frames */
+
+void BM_Run_Ahead_Held_Input(benchmark::State& state) {
+    Machine     machine(make_polling_rom());
+    RunAhead    run_ahead(machine, FRAMES_AHEAD);
+
+    for (auto _ : state)
+        benchmark::DoNotOptimize(&run_ahead.run_frame(::bits_set(JoyPad::RT_KEY)));
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Run_Ahead_Held_Input)->Name("RunAhead/frame/held_input");
+
+/* Input changes every frame, so every frame rolls back and runs FRAMES_AHEAD + 1 frames */
+
+void BM_Run_Ahead_Rollback(benchmark::State& state) {
+    Machine     machine(make_polling_rom());
+    RunAhead    run_ahead(machine, FRAMES_AHEAD);
+    byte_t      key_set = 0x0;
+
+    for (auto _ : state) {
+        key_set ^= ::bits_set(JoyPad::A_KEY);
+        benchmark::DoNotOptimize(&run_ahead.run_frame(key_set));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Run_Ahead_Rollback)->Name("RunAhead/frame/rollback");
+
+}  // namespace
@@ -0,0 +1,78 @@
+#include "benchmark/benchmark.h"
+
+#include "common/GB_clock.h"
+#include "common/GB_scheduler.h"
+
+namespace {
+
+using Scheduler = devsync::Scheduler;
+
+constexpr clk_cycle_t FRAME_CYCLES = 70224;
+constexpr unsigned DEVICES_NUM = 4;
+constexpr clk_cycle_t DEVICE_PERIODS[DEVICES_NUM] = { 456, 1024, 4096, 80 };
+
+/* Devices, which are stepped and polled every M-cycle */
+
+void BM_Frame_Polling(benchmark::State& state) {
+    clk_cycle_t counters[DEVICES_NUM] = {};
+    unsigned    events = 0;
+
+    for (auto _ : state) {
+        for (clk_cycle_t time = 0; time < FRAME_CYCLES; time += 1_MCycles) {
+            for (unsigned dev = 0; dev < DEVICES_NUM; ++dev) {
+                counters[dev] += 1_MCycles;
+                if (counters[dev] >= DEVICE_PERIODS[dev]) {
+                    counters[dev] -= DEVICE_PERIODS[dev];
+                    ++events;
+                }
+            }
+        }
+        benchmark::DoNotOptimize(events);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Frame_Polling)->Name("Scheduler/frame/polling");
+
+/* Devices, which schedule their next deadline */
+
+struct Device {
+    Scheduler*              scheduler;
+    Scheduler::event_id_t   event;
+    clk_cycle_t             period;
+    unsigned                events;
+
+    static void on_event(void* owner, clk_cycle_t deadline) {
+        Device* dev = static_cast<Device*>(owner);
+
+        ++dev->events;
+        dev->scheduler->schedule(dev->event, deadline + dev->period);
+    }
+};
+
+void BM_Frame_Scheduler(benchmark::State& state) {
+    Scheduler   sched;
+    Device      devs[DEVICES_NUM];
+
+    for (unsigned dev = 0; dev < DEVICES_NUM; ++dev) {
+        devs[dev] = Device{&sched, sched.register_event(&Device::on_event, &devs[dev]), DEVICE_PERIODS[dev], 0};
+        sched.schedule_in(devs[dev].event, DEVICE_PERIODS[dev]);
+    }
+
+    for (auto _ : state) {
+        const clk_cycle_t frame_end = sched.get_time() + FRAME_CYCLES;
+
+        // CPU would spend the budget with 1 M-cycle actions
+        while (sched.get_time() < frame_end) {
+            clk_cycle_t budget = sched.get_budget(frame_end - sched.get_time());
+            const clk_cycle_t given = budget;
+
+            budget -= ((budget + 1_MCycles) / 1_MCycles) * 1_MCycles;
+            sched.advance(given - budget);
+        }
+        benchmark::DoNotOptimize(devs[0].events);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Frame_Scheduler)->Name("Scheduler/frame/events");
+
+}  // namespace
@@ -0,0 +1,95 @@
+#include "benchmark/benchmark.h"
+
+#include "GB_config.h"
+#include "common/GB_macro.h"
+#include "device/GB_tile_decoder.h"
+
+namespace {
+
+using TileDecoder = GB::device::TileDecoder;
+
+constexpr word_t MAP_OFFSET = 0x1800;
+
+void fill_vram(byte_t* vram) {
+    for (unsigned offset = 0; offset < GB::VRAM_CGB_SIZE; ++offset)
+        vram[offset] = byte_t(offset * 7 + (offset >> 8));
+}
+
+/* Background line with shift and mask for every pixel */
+
+void BM_Fetch_Line_Naive(benchmark::State& state) {
+    byte_t vram[GB::VRAM_CGB_SIZE];
+    byte_t pixels[TileDecoder::LINE_WIDTH];
+
+    fill_vram(vram);
+
+    byte_t y = 0;
+    for (auto _ : state) {
+        for (unsigned x = 0; x < TileDecoder::LINE_WIDTH; ++x) {
+            const unsigned map_idx = MAP_OFFSET + (y / 8) * 32 + (x + 3) % 256 / 8;
+            const byte_t attrs = vram[GB::VRAM_BANK_SIZE + map_idx];
+            const unsigned bank_base = ::bit_n(TileDecoder::ATTR_BANK_BIT, attrs) ? GB::VRAM_BANK_SIZE : 0;
+            const unsigned tile_row = ::bit_n(TileDecoder::ATTR_VFLIP_BIT, attrs) ? 7 - y % 8 : y % 8;
+            const byte_t* row = vram + bank_base + vram[map_idx] * 16 + tile_row * 2;
+            const unsigned bit = ::bit_n(TileDecoder::ATTR_HFLIP_BIT, attrs) ? (x + 3) % 8 : 7 - (x + 3) % 8;
+
+            pixels[x] = byte_t((::bit_n(bit, row[1]) << 1) | ::bit_n(bit, row[0]));
+        }
+        benchmark::DoNotOptimize(pixels);
+        ++y;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Fetch_Line_Naive)->Name("TileDecoder/fetch_line/naive");
+
+template <TileDecoder::Isa _Isa>
+void BM_Fetch_Line(benchmark::State& state) {
+    if (!TileDecoder::is_supported(_Isa)) {
+        state.SkipWithError("ISA isn't supported");
+        return;
+    }
+
+    TileDecoder decoder(_Isa);
+    byte_t      vram[GB::VRAM_CGB_SIZE];
+    byte_t      pixels[TileDecoder::LINE_WIDTH];
+
+    fill_vram(vram);
+
+    byte_t y = 0;
+    for (auto _ : state) {
+        decoder.fetch_line(vram, MAP_OFFSET, false, true, 3, y, pixels);
+        benchmark::DoNotOptimize(pixels);
+        ++y;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_TEMPLATE(BM_Fetch_Line, TileDecoder::SCALAR_ISA)->Name("TileDecoder/fetch_line/scalar");
+BENCHMARK_TEMPLATE(BM_Fetch_Line, TileDecoder::SSE2_ISA)->Name("TileDecoder/fetch_line/sse2");
+BENCHMARK_TEMPLATE(BM_Fetch_Line, TileDecoder::AVX2_ISA)->Name("TileDecoder/fetch_line/avx2");
+
+template <TileDecoder::Isa _Isa>
+void BM_Decode_Rows(benchmark::State& state) {
+    if (!TileDecoder::is_supported(_Isa)) {
+        state.SkipWithError("ISA isn't supported");
+        return;
+    }
+
+    TileDecoder decoder(_Isa);
+    byte_t      planes[TileDecoder::LINE_TILES_NUM * 2];
+    byte_t      pixels[TileDecoder::LINE_TILES_NUM * 8];
+
+    for (unsigned idx = 0; idx < sizeof(planes); ++idx)
+        planes[idx] = byte_t(idx * 37);
+
+    for (auto _ : state) {
+        decoder.decode_rows(planes, TileDecoder::LINE_TILES_NUM, pixels);
+        benchmark::DoNotOptimize(pixels);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * TileDecoder::LINE_TILES_NUM);
+}
+BENCHMARK_TEMPLATE(BM_Decode_Rows, TileDecoder::SCALAR_ISA)->Name("TileDecoder/decode_rows/scalar");
+BENCHMARK_TEMPLATE(BM_Decode_Rows, TileDecoder::SSE2_ISA)->Name("TileDecoder/decode_rows/sse2");
+BENCHMARK_TEMPLATE(BM_Decode_Rows, TileDecoder::AVX2_ISA)->Name("TileDecoder/decode_rows/avx2");
+
+}  // namespace
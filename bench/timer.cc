@@ -0,0 +1,84 @@
+#include "benchmark/benchmark.h"
+
+#include "common/GB_clock.h"
+#include "common/GB_scheduler.h"
+#include "device/GB_interrupt.h"
+#include "device/GB_timer.h"
+#include "memory/GB_bus.h"
+#include "memory/GB_vaddr.h"
+
+namespace {
+
+using Bus = GB::memory::BusInterface;
+using Timer = GB::device::Timer;
+
+constexpr clk_cycle_t FRAME_CYCLES = 70224;
+constexpr clk_cycle_t LINE_CYCLES = 456;
+constexpr clk_cycle_t INSTRUCTION_CYCLES = 4_MCycles;  ///< average instruction, which advances time
+
+/**
+ * Timer, which is stepped every M-cycle: counter and falling edge are checked on every step
+ */
+struct SteppedTimer {
+    unsigned    counter = 0;
+    unsigned    tima = 0;
+    byte_t      tma = 0;
+    byte_t      tac = 0x5;
+    unsigned    interrupts = 0;
+
+    bool signal() const {
+        return ::bit_n(Timer::TAC_ENABLE_BIT, tac) && ::bit_n(Timer::TIMA_COUNTER_BITS[tac & 0b11], counter);
+    }
+
+    void step() {
+        const bool old_signal = signal();
+
+        counter = (counter + 1_MCycles) & Timer::COUNTER_MASK;
+        if (old_signal && !signal() && ++tima == Timer::TIMA_OVERFLOW) {
+            tima = tma;
+            ++interrupts;
+        }
+    }
+};
+
+/* Frame of instructions, which step the timer every M-cycle, TIMA is polled every line */
+
+void BM_Timer_Stepped(benchmark::State& state) {
+    SteppedTimer timer;
+
+    for (auto _ : state) {
+        for (clk_cycle_t time = 0; time < FRAME_CYCLES; time += INSTRUCTION_CYCLES) {
+            for (clk_cycle_t cycle = 0; cycle < INSTRUCTION_CYCLES; cycle += 1_MCycles)
+                timer.step();
+            if (time % LINE_CYCLES < INSTRUCTION_CYCLES)
+                benchmark::DoNotOptimize(timer.tima);
+        }
+        benchmark::DoNotOptimize(timer.interrupts);
+    }
+    state.SetItemsProcessed(state.iterations() * (FRAME_CYCLES / INSTRUCTION_CYCLES));
+}
+BENCHMARK(BM_Timer_Stepped)->Name("Timer/frame/stepped");
+
+/* Frame of instructions, which only advance the scheduler, TIMA is polled every line */
+
+void BM_Timer_Lazy(benchmark::State& state) {
+    Bus                                 bus;
+    devsync::Scheduler                  scheduler;
+    GB::device::InterruptController     int_ctrl;
+    Timer                               timer(&int_ctrl, &scheduler);
+
+    timer.map_to_memory(bus);
+    bus.write(GB::memory::TAC_VADDR, 0x5);
+    for (auto _ : state) {
+        for (clk_cycle_t time = 0; time < FRAME_CYCLES; time += INSTRUCTION_CYCLES) {
+            scheduler.advance(INSTRUCTION_CYCLES);
+            if (time % LINE_CYCLES < INSTRUCTION_CYCLES)
+                benchmark::DoNotOptimize(bus.read(GB::memory::TIMA_VADDR));
+        }
+        benchmark::DoNotOptimize(int_ctrl.get_IF_reg());
+    }
+    state.SetItemsProcessed(state.iterations() * (FRAME_CYCLES / INSTRUCTION_CYCLES));
+}
+BENCHMARK(BM_Timer_Lazy)->Name("Timer/frame/lazy");
+
+}  // namespace
@@ -0,0 +1,60 @@
+#include <algorithm>
+#include <iterator>
+
+#include "benchmark/benchmark.h"
+
+#include "GB_config.h"
+#include "core/GB_vec_env.h"
+#include "device/GB_joypad.h"
+
+namespace {
+
+using VecEnv = GB::core::VecEnv<GB::DMG_MODE>;
+using JoyPad = GB::device::JoyPad;
+
+constexpr unsigned INSTANCES_NUM = 16;
+
+/** Game, which polls the joypad in a busy loop */
+dbuffer_t make_polling_rom() {
+    dbuffer_t rom(32_KBytes);
+    const byte_t program[] = {
+        0x3E, 0x20,         // LD A,0x20
+        0xE0, 0x00,         // LDH (P1),A
+        0xF0, 0x00,         // LDH A,(P1)
+        0xEA, 0x00, 0xC0,   // LD (0xC000),A
+        0x21, 0x01, 0xC0,   // LD HL,0xC001
+        0x34,               // INC (HL)
+        0x18, 0xF1,         // JR -15
+    };
+
+    std::fill(rom.get_data_addr(), rom.get_data_addr() + rom.size(), 0x0);
+    std::copy(std::begin(program), std::end(program), &rom[GB::CPU_PC_INIT_VALUE]);
+    return rom;
+}
+
+/* Step of all instances with a WRAM observation, Arg is number of workers (1 is the base line) */
+
+void BM_Vec_Env_Step(benchmark::State& state) {
+    VecEnv::Config config;
+
+    config.instances_num = INSTANCES_NUM;
+    config.workers_num = unsigned(state.range(0));
+    config.observation = { {0xC000, 8_KBytes} };
+    config.rewards = { {0xC001, 1.0f} };
+
+    VecEnv env(make_polling_rom(), config);
+    byte_t actions[INSTANCES_NUM] = {};
+    unsigned step = 0;
+
+    for (auto _ : state) {
+        actions[step++ % INSTANCES_NUM] ^= ::bits_set(JoyPad::A_KEY);
+        env.step(actions);
+        benchmark::DoNotOptimize(env.get_observations());
+    }
+    state.counters["workers"] = double(env.get_workers_num());
+    state.counters["pinned"] = double(env.get_pinned_workers_num());
+    state.SetItemsProcessed(state.iterations() * INSTANCES_NUM);
+}
+BENCHMARK(BM_Vec_Env_Step)->Name("VecEnv/step")->Arg(1)->Arg(2)->Arg(4)->Arg(0)->UseRealTime();
+
+}  // namespace
@@ -0,0 +1,99 @@
+#include <cstring>
+
+#include "benchmark/benchmark.h"
+
+#include "GB_config.h"
+#include "common/GB_macro.h"
+#include "device/GB_vram.h"
+
+namespace {
+
+using VRAM = GB::device::VRAM<GB::CGB_MODE>;
+
+constexpr word_t VRAM_BANK_SIZE = 0x2000;
+
+/* Banked access, bank is selected once or changed before every access */
+
+template <bool _SwitchBank>
+void BM_VRAM_Read(benchmark::State& state) {
+    VRAM ram;
+
+    ram.set_VBK_reg(0x1);
+
+    word_t offset = 0;
+    for (auto _ : state) {
+        if (_SwitchBank)
+            ram.set_VBK_reg(byte_t(offset));
+        benchmark::DoNotOptimize(ram.read_inner_vaddr(offset));
+        offset = (offset + 0x101) % VRAM_BANK_SIZE;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_TEMPLATE(BM_VRAM_Read, false)->Name("VRAM/read/fixed_bank");
+BENCHMARK_TEMPLATE(BM_VRAM_Read, true)->Name("VRAM/read/switching");
+
+template <bool _SwitchBank>
+void BM_VRAM_Write(benchmark::State& state) {
+    VRAM ram;
+
+    ram.set_VBK_reg(0x1);
+
+    word_t offset = 0;
+    for (auto _ : state) {
+        if (_SwitchBank)
+            ram.set_VBK_reg(byte_t(offset));
+        ram.write_inner_vaddr(offset, byte_t(offset));
+        offset = (offset + 0x101) % VRAM_BANK_SIZE;
+    }
+    benchmark::ClobberMemory();
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_TEMPLATE(BM_VRAM_Write, false)->Name("VRAM/write/fixed_bank");
+BENCHMARK_TEMPLATE(BM_VRAM_Write, true)->Name("VRAM/write/switching");
+
+/* Background line of 20 tiles, which is decoded from 2bpp data or taken from the tile cache */
+
+constexpr unsigned LINE_TILES_NUM = 20;
+
+void BM_VRAM_Line_Decode(benchmark::State& state) {
+    VRAM    ram;
+    byte_t  line[LINE_TILES_NUM * 8];
+
+    for (word_t offset = 0; offset < VRAM::TILE_DATA_SIZE; ++offset)
+        ram.write_inner_vaddr(offset, byte_t(offset * 7));
+
+    unsigned row = 0;
+    for (auto _ : state) {
+        for (unsigned tile = 0; tile < LINE_TILES_NUM; ++tile) {
+            const word_t row_addr = tile * VRAM::TILE_SIZE + row * VRAM::TILE_ROW_SIZE;
+            const byte_t low = ram.read_inner_vaddr(row_addr);
+            const byte_t high = ram.read_inner_vaddr(row_addr + 1);
+            for (unsigned x = 0; x < 8; ++x)
+                line[tile * 8 + x] = byte_t((::bit_n(7 - x, high) << 1) | ::bit_n(7 - x, low));
+        }
+        benchmark::DoNotOptimize(line);
+        row = (row + 1) % VRAM::TILE_ROWS_NUM;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_VRAM_Line_Decode)->Name("VRAM/tile_line/decode");
+
+void BM_VRAM_Line_Cached(benchmark::State& state) {
+    VRAM    ram;
+    byte_t  line[LINE_TILES_NUM * 8];
+
+    for (word_t offset = 0; offset < VRAM::TILE_DATA_SIZE; ++offset)
+        ram.write_inner_vaddr(offset, byte_t(offset * 7));
+
+    unsigned row = 0;
+    for (auto _ : state) {
+        for (unsigned tile = 0; tile < LINE_TILES_NUM; ++tile)
+            std::memcpy(line + tile * 8, ram.get_tile_row(0, tile, row), 8);
+        benchmark::DoNotOptimize(line);
+        row = (row + 1) % VRAM::TILE_ROWS_NUM;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_VRAM_Line_Cached)->Name("VRAM/tile_line/cached");
+
+}  // namespace
@@ -0,0 +1,167 @@
+#include "benchmark/benchmark.h"
+
+#include "GB_config.h"
+#include "device/GB_wram.h"
+#include "memory/GB_bus.h"
+#include "memory/GB_vaddr.h"
+
+namespace {
+
+using WRAM = GB::device::WRAM<GB::CGB_MODE>;
+using Bus = GB::memory::BusInterface;
+
+constexpr word_t ECHO_SIZE = GB::memory::WRAMX_ECHO_LAST_VADDR - GB::memory::WRAM0_ECHO_BASE_VADDR + 1;
+
+/* Echo mapping through device callbacks, as it was done before echo pages aliasing */
+
+byte_t read_echo_cmd(void* dev, word_t vaddr) {
+    return static_cast<WRAM*>(dev)->read_inner_vaddr(vaddr - GB::memory::WRAM0_ECHO_BASE_VADDR);
+}
+
+void write_echo_cmd(void* dev, word_t vaddr, byte_t data) {
+    static_cast<WRAM*>(dev)->write_inner_vaddr(vaddr - GB::memory::WRAM0_ECHO_BASE_VADDR, data);
+}
+
+void map_echo_callbacks(WRAM& ram, Bus& bus) {
+    bus.MapVAddr(GB::memory::WRAM0_ECHO_BASE_VADDR, GB::memory::WRAMX_ECHO_LAST_VADDR
+                , Bus::ReadCmd(read_echo_cmd), Bus::WriteCmd(write_echo_cmd), &ram);
+}
+
+template <bool _EchoCallbacks>
+void BM_WRAM_Echo_Read(benchmark::State& state) {
+    WRAM    ram;
+    Bus     bus;
+
+    ram.map_to_memory(bus);
+    ram.set_SVBK_reg(0x3);
+    if (_EchoCallbacks)
+        map_echo_callbacks(ram, bus);
+
+    word_t offset = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(bus.read(GB::memory::WRAM0_ECHO_BASE_VADDR + offset));
+        offset = (offset + 0x101) % ECHO_SIZE;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_TEMPLATE(BM_WRAM_Echo_Read, false)->Name("WRAM/echo_read/pointer");
+BENCHMARK_TEMPLATE(BM_WRAM_Echo_Read, true)->Name("WRAM/echo_read/callback");
+
+template <bool _EchoCallbacks>
+void BM_WRAM_Echo_Write(benchmark::State& state) {
+    WRAM    ram;
+    Bus     bus;
+
+    ram.map_to_memory(bus);
+    ram.set_SVBK_reg(0x3);
+    if (_EchoCallbacks)
+        map_echo_callbacks(ram, bus);
+
+    word_t offset = 0;
+    for (auto _ : state) {
+        bus.write(GB::memory::WRAM0_ECHO_BASE_VADDR + offset, byte_t(offset));
+        offset = (offset + 0x101) % ECHO_SIZE;
+    }
+    benchmark::ClobberMemory();
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_TEMPLATE(BM_WRAM_Echo_Write, false)->Name("WRAM/echo_write/pointer");
+BENCHMARK_TEMPLATE(BM_WRAM_Echo_Write, true)->Name("WRAM/echo_write/callback");
+
+/* Inner address access across bank patterns */
+
+enum BankPattern {
+    BANK0_PATTERN,      ///< fixed bank 0
+    BANKX_PATTERN,      ///< fixed switchable bank
+    SWITCH_PATTERN,     ///< switchable bank is changed before every access
+};
+
+constexpr word_t BANK_SIZE = 0x1000;
+
+template <BankPattern _Pattern>
+inline word_t
+select_bank(WRAM& ram, word_t offset) {
+    switch (_Pattern) {
+        case BANK0_PATTERN:     return offset;
+        case BANKX_PATTERN:     return BANK_SIZE + offset;
+        case SWITCH_PATTERN:    ram.set_SVBK_reg(byte_t(offset)); return BANK_SIZE + offset;
+    }
+    return offset;
+}
+
+template <BankPattern _Pattern>
+void BM_WRAM_Read(benchmark::State& state) {
+    WRAM ram;
+
+    ram.set_SVBK_reg(0x3);
+
+    word_t offset = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(ram.read_inner_vaddr(select_bank<_Pattern>(ram, offset)));
+        offset = (offset + 0x101) % BANK_SIZE;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_TEMPLATE(BM_WRAM_Read, BANK0_PATTERN)->Name("WRAM/read/bank0");
+BENCHMARK_TEMPLATE(BM_WRAM_Read, BANKX_PATTERN)->Name("WRAM/read/bankx");
+BENCHMARK_TEMPLATE(BM_WRAM_Read, SWITCH_PATTERN)->Name("WRAM/read/switching");
+
+template <BankPattern _Pattern>
+void BM_WRAM_Write(benchmark::State& state) {
+    WRAM ram;
+
+    ram.set_SVBK_reg(0x3);
+
+    word_t offset = 0;
+    for (auto _ : state) {
+        ram.write_inner_vaddr(select_bank<_Pattern>(ram, offset), byte_t(offset));
+        offset = (offset + 0x101) % BANK_SIZE;
+    }
+    benchmark::ClobberMemory();
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_TEMPLATE(BM_WRAM_Write, BANK0_PATTERN)->Name("WRAM/write/bank0");
+BENCHMARK_TEMPLATE(BM_WRAM_Write, BANKX_PATTERN)->Name("WRAM/write/bankx");
+BENCHMARK_TEMPLATE(BM_WRAM_Write, SWITCH_PATTERN)->Name("WRAM/write/switching");
+
+template <bool _Shared>
+void BM_WRAM_Fork(benchmark::State& state) {
+    WRAM ram;
+
+    if (_Shared)
+        ram.share_memory();
+
+    for (auto _ : state) {
+        WRAM ram_fork(ram);
+        ram_fork.write_inner_vaddr(0x1000, 0x1);
+        benchmark::DoNotOptimize(&ram_fork);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_TEMPLATE(BM_WRAM_Fork, false)->Name("WRAM/fork_and_write/copy");
+BENCHMARK_TEMPLATE(BM_WRAM_Fork, true)->Name("WRAM/fork_and_write/cow");
+
+/* Copy of the whole inner address space (save-state, observation extraction) */
+
+template <bool _Block>
+void BM_WRAM_Copy_Out(benchmark::State& state) {
+    WRAM    ram;
+    byte_t  dst[WRAM::INNER_VADDR_MASK + 1];
+
+    ram.set_SVBK_reg(0x3);
+    for (auto _ : state) {
+        if (_Block) {
+            ram.read_block(0x0, dst, sizeof(dst));
+        } else {
+            for (word_t inner_vaddr = 0; inner_vaddr < sizeof(dst); ++inner_vaddr)
+                dst[inner_vaddr] = ram.read_inner_vaddr(inner_vaddr);
+        }
+        benchmark::DoNotOptimize(dst);
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * sizeof(dst));
+}
+BENCHMARK_TEMPLATE(BM_WRAM_Copy_Out, false)->Name("WRAM/copy_out/bytewise");
+BENCHMARK_TEMPLATE(BM_WRAM_Copy_Out, true)->Name("WRAM/copy_out/block");
+
+}  // namespace
@@ -21,6 +21,14 @@ constexpr unsigned INTC_IF_INIT_VALUE = 0x0;
 constexpr unsigned INTC_IE_INIT_VALUE = 0x0;
 constexpr bool INTC_IME_INIT_VALUE = true;
 
+/** CPU registers after the boot ROM */
+constexpr unsigned CPU_AF_INIT_VALUE = 0x01B0;
+constexpr unsigned CPU_BC_INIT_VALUE = 0x0013;
+constexpr unsigned CPU_DE_INIT_VALUE = 0x00D8;
+constexpr unsigned CPU_HL_INIT_VALUE = 0x014D;
+constexpr unsigned CPU_SP_INIT_VALUE = 0xFFFE;
+constexpr unsigned CPU_PC_INIT_VALUE = 0x0100;
+
 constexpr unsigned ORAM_OBJECTS_NUM = 40;
 constexpr unsigned ORAM_SIZE = ORAM_OBJECTS_NUM * 4_Bytes;
 
@@ -29,6 +37,14 @@ constexpr unsigned VRAM_NON_CGB_SIZE = VRAM_BANK_SIZE;
 constexpr unsigned VRAM_CGB_SIZE = VRAM_BANK_SIZE * 2;
 constexpr unsigned VRAM_MAX_SIZE = VRAM_CGB_SIZE;
 
+constexpr unsigned HRAM_SIZE = 127_Bytes;
+
+constexpr unsigned LCD_WIDTH = 160;
+constexpr unsigned LCD_HEIGHT = 144;
+
+/** Clock cycles of an LCD frame (154 lines of 456 cycles) */
+constexpr unsigned FRAME_CYCLES = 70224;
+
 
 enum GBModeFlag : u16 {
     DMG_MODE = 0b000001,
@@ -37,6 +53,28 @@ enum GBModeFlag : u16 {
     CGB_MODE = 0b001000
 };
 
+/**
+ * @brief Returns true if the mode has CGB memory banking (SVBK and VBK registers)
+ * @details CGB running in DMG compatible mode has banking registers locked, so it
+ *          behaves like DMG from the memory point of view.
+ */
+constexpr inline bool
+has_cgb_banks(GBModeFlag mode) {
+    return mode == CGB_MODE;
+}
+
+/** WRAM size which is accessible in the mode */
+constexpr inline unsigned
+wram_size(GBModeFlag mode) {
+    return has_cgb_banks(mode) ? WRAM_CGB_SIZE : WRAM_NON_CGB_SIZE;
+}
+
+/** VRAM size which is accessible in the mode */
+constexpr inline unsigned
+vram_size(GBModeFlag mode) {
+    return has_cgb_banks(mode) ? VRAM_CGB_SIZE : VRAM_NON_CGB_SIZE;
+}
+
 }  // namespace GB
 
 #endif  // GB_CONFIG_H_
@@ -7,17 +7,18 @@
 # define COMMON_GB_CLOCK_H_
 
 # include <algorithm>
+# include <cstdint>
 # include <type_traits>
 
 using clk_cycle_t = int64_t;  ///< type for representing clock cycles
 
 constexpr static auto MCYCLE_TO_CLK_CYCLE = 0x4;
 
-constexpr inline uint64_t
-operator "" _CLKCycles(uint64_t cCycles) { return cCycles; }
+constexpr inline unsigned long long int
+operator "" _CLKCycles(unsigned long long int cCycles) { return cCycles; }
 
-constexpr inline uint64_t
-operator "" _MCycles(uint64_t mCycles) { return mCycles * MCYCLE_TO_CLK_CYCLE; }
+constexpr inline unsigned long long int
+operator "" _MCycles(unsigned long long int mCycles) { return mCycles * MCYCLE_TO_CLK_CYCLE; }
 
 namespace devsync {
 
@@ -76,6 +77,59 @@ class counter_t {
     }
 };
 
+/**
+ * @brief timestamp of the last synchronization of a lazily synchronized device
+ *
+ * @details Instead of stepping every cycle, device records when it was synchronized last time,
+ *          and catches up for the elapsed cycles only when its state is observed: its register
+ *          is accessed from the bus, its input is changed or its scheduled event fires.
+ *          Stamp without clock (manually stepped device) never has elapsed cycles.
+ */
+class sync_stamp_t {
+ protected:
+    const clk_cycle_t*  __clock;
+    clk_cycle_t         __last_sync;
+
+ public:
+    /**
+     * @param[in] clock current time source (usually Scheduler::get_clock()), which must outlive the stamp
+     */
+    explicit
+    sync_stamp_t(const clk_cycle_t* clock = nullptr)
+    : __clock(clock), __last_sync(clock != nullptr ? *clock : 0) {}
+
+    /** returns true if stamp has a clock, so the device is synchronized lazily */
+    inline bool
+    has_clock() const {
+        return __clock != nullptr;
+    }
+
+    /** get cycles, which are elapsed since the last synchronization */
+    inline clk_cycle_t
+    elapsed() const {
+        return (__clock != nullptr) ? *__clock - __last_sync : 0;
+    }
+
+    /** mark device as synchronized at the current time, and return elapsed cycles */
+    inline clk_cycle_t
+    catch_up() {
+        const clk_cycle_t elapsed_cycles = elapsed();
+        __last_sync += elapsed_cycles;
+        return elapsed_cycles;
+    }
+
+    inline clk_cycle_t
+    get_last_sync() const {
+        return __last_sync;
+    }
+
+    /** restore time of the last synchronization (e.g. from a saved state) */
+    inline void
+    set_last_sync(clk_cycle_t last_sync) {
+        __last_sync = last_sync;
+    }
+};
+
 /**
  * @brief synchronized to clock decorator for a synced action
  */
@@ -6,36 +6,118 @@
 #ifndef COMMON_GB_DBUFFER_H_
 # define COMMON_GB_DBUFFER_H_
 
+# include <memory_resource>
+
+# include <cassert>
+# include <cstddef>
 # include <cstdint>
 # include <utility>
 # include <string>
 # include <cstring>
+# include <memory>
+# include <vector>
 
 /**
  * @brief Dynamic allocated buffer with support of move-semantic
+ *
+ * @details Owning buffer can be turned into a page-granular copy-on-write buffer with share().
+ *          Content of a shared buffer is frozen in a reference counted base, so copies of
+ *          the shared buffer don't copy unmodified pages. A page is copied to the private
+ *          memory of the buffer on the first write to it (see privatize_page()).
+ *
+ *          Memory is allocated from a std::pmr::memory_resource with the requested alignment.
+ *          Copy constructed buffer uses memory resource and alignment of the source,
+ *          assigned buffer keeps its own ones (like pmr containers do): memory of a moved
+ *          source is taken only if it's from an equal resource with the same alignment,
+ *          otherwise the content is copied.
  */
 class dbuffer_t {
+ public:
+
+    constexpr static size_t PAGE_SIZE = 0x1000;  ///< copy-on-write granularity
+    constexpr static size_t DEFAULT_ALIGNMENT = alignof(std::max_align_t);
+    constexpr static size_t CACHE_LINE_ALIGNMENT = 64;  ///< alignment for SIMD access
+
  protected:
 
-    uint8_t*    __data;
-    size_t      __len;
+    /** Copy-on-write state of shared buffer */
+    struct CowState {
+        std::shared_ptr<const uint8_t[]>    frozen;         ///< shared base content
+        std::vector<bool>                   private_pages;  ///< pages which are copied to __data
+        size_t                              shared_num;     ///< number of not copied pages
+    };
+
+    std::pmr::memory_resource*  __resource;
+    size_t                      __align;
+    uint8_t*                    __data;
+    size_t                      __len;
+    bool                        __owner;   ///< false for views, which don't free the data
+    std::unique_ptr<CowState>   __cow;     ///< nullptr, if buffer is not shared
 
  protected:
 
-    inline static
-    uint8_t* __allocate(size_t n) {
-        return new uint8_t[n];
+    inline
+    uint8_t* __allocate(size_t n) const {
+        return (n != 0) ? static_cast<uint8_t*>(__resource->allocate(n, __align)) : nullptr;
     }
 
-    inline static void
-    __deallocate(uint8_t *data) {
-        delete[] data;
+    inline void
+    __deallocate(uint8_t *data, size_t n) const {
+        __resource->deallocate(data, n, __align);
     }
 
     inline void __free() {
-        if (__data)
-            __deallocate(__data);
+        if (__data && __owner)
+            __deallocate(__data, __len);
         __data = nullptr;
+        __cow.reset();
+    }
+
+    inline size_t __pages_num() const {
+        return (__len + PAGE_SIZE - 1) / PAGE_SIZE;
+    }
+
+    inline size_t __page_len(size_t page_idx) const {
+        const size_t page_offset = page_idx * PAGE_SIZE;
+        return (__len - page_offset < PAGE_SIZE) ? __len - page_offset : PAGE_SIZE;
+    }
+
+    /** Copy first n bytes of content of any buffer (shared buffer is copied page by page) */
+    inline static void __copy_content(uint8_t* dst, const dbuffer_t& source, size_t n) {
+        if (source.__cow == nullptr) {
+            if (n != 0)
+                std::memmove(dst, source.__data, n);
+            return;
+        }
+        for (size_t offset = 0; offset < n; offset += PAGE_SIZE) {
+            const size_t len = (n - offset < PAGE_SIZE) ? n - offset : PAGE_SIZE;
+            std::memmove(dst + offset, source.get_page_rd_addr(offset / PAGE_SIZE), len);
+        }
+    }
+
+    /** Copy content into the view memory, which never changes its location */
+    inline void __copy_into_view(const dbuffer_t& source) {
+        __copy_content(__data, source, (__len < source.__len) ? __len : source.__len);
+    }
+
+    /** Make this (empty owning) buffer a copy of the source, shared source is copied lazily */
+    inline void __copy_from(const dbuffer_t& source) {
+        __len = source.__len;
+        __owner = true;
+        __data = __allocate(__len);
+
+        if (source.__cow == nullptr) {
+            __copy_content(__data, source, __len);
+            return;
+        }
+
+        __cow = std::make_unique<CowState>(*source.__cow);
+        for (size_t page_idx = 0; page_idx < __pages_num(); ++page_idx) {
+            if (__cow->private_pages[page_idx]) {
+                std::memcpy(__data + page_idx * PAGE_SIZE, source.__data + page_idx * PAGE_SIZE
+                          , __page_len(page_idx));
+            }
+        }
     }
 
  public:
@@ -50,8 +132,55 @@ class dbuffer_t {
      */
     explicit
     dbuffer_t(size_t size = 0ul)
-    : __data(size != 0 ? __allocate(size) : nullptr)
-    , __len(size) {
+    : __resource(std::pmr::get_default_resource())
+    , __align(DEFAULT_ALIGNMENT)
+    , __data(__allocate(size))
+    , __len(size)
+    , __owner(true)
+    , __cow() {
+    }
+
+    /**
+     * @brief Create and allocate dynamic buffer from the memory resource
+     * @param[in] size size (in bytes) to allocate for buffer data
+     * @param[in] resource memory resource, which must outlive the buffer and its copies
+     * @param[in] alignment alignment of buffer data (power of two)
+     */
+    dbuffer_t(size_t size, std::pmr::memory_resource* resource, size_t alignment = DEFAULT_ALIGNMENT)
+    : __resource(resource)
+    , __align(alignment)
+    , __data(__allocate(size))
+    , __len(size)
+    , __owner(true)
+    , __cow() {
+    }
+
+    /**
+     * @brief Create and allocate dynamic buffer with some alignment
+     * @param[in] size size (in bytes) to allocate for buffer data
+     * @param[in] alignment alignment of buffer data (power of two)
+     */
+    inline static dbuffer_t
+    aligned(size_t size, size_t alignment = CACHE_LINE_ALIGNMENT) {
+        return dbuffer_t(size, std::pmr::get_default_resource(), alignment);
+    }
+
+    /**
+     * @brief Create view of an external memory (view doesn't own and doesn't free the memory)
+     * @param[in] ext_data address of the memory, which must outlive the view
+     * @param[in] length size in bytes of the memory
+     *
+     * @details Assignment to a view copies content into the viewed memory, so devices
+     *          which keep their storage in a shared arena never leave it.
+     *          Copy of a view is an ordinary owning buffer. View can't be shared.
+     */
+    inline static dbuffer_t
+    view(uint8_t* ext_data, size_t length) {
+        dbuffer_t view_buffer;
+        view_buffer.__data = ext_data;
+        view_buffer.__len = length;
+        view_buffer.__owner = false;
+        return view_buffer;
     }
 
     /**
@@ -61,8 +190,12 @@ class dbuffer_t {
      */
     explicit
     dbuffer_t(void* ext_data, size_t length)
-    : __data(__allocate(length))
-    , __len(length) {
+    : __resource(std::pmr::get_default_resource())
+    , __align(DEFAULT_ALIGNMENT)
+    , __data(__allocate(length))
+    , __len(length)
+    , __owner(true)
+    , __cow() {
         std::memcpy(__data, ext_data, __len);
     }
 
@@ -72,46 +205,146 @@ class dbuffer_t {
      */
     explicit
     dbuffer_t(const std::string& str)
-    : __data(__allocate(str.length()))
-    , __len(str.length()) {
+    : __resource(std::pmr::get_default_resource())
+    , __align(DEFAULT_ALIGNMENT)
+    , __data(__allocate(str.length()))
+    , __len(str.length())
+    , __owner(true)
+    , __cow() {
         std::memcpy(__data, str.data(), __len);
     }
 
+    /** Copy of shared buffer shares its frozen pages and copies its private pages only */
     dbuffer_t(const dbuffer_t& source)
-    : __data(__allocate(source.__len))
-    , __len(source.__len) {
-        std::memcpy(__data, source.__data, __len);
+    : __resource(source.__resource)
+    , __align(source.__align)
+    , __data(nullptr)
+    , __len(0)
+    , __owner(true)
+    , __cow() {
+        __copy_from(source);
     }
 
     dbuffer_t(dbuffer_t&& source) noexcept
-    : __data(std::move(source.__data))
-    , __len(std::move(source.__len)) {
+    : __resource(source.__resource)
+    , __align(source.__align)
+    , __data(std::move(source.__data))
+    , __len(std::move(source.__len))
+    , __owner(source.__owner)
+    , __cow(std::move(source.__cow)) {
         source.__data = nullptr;
         source.__len = 0;
+        source.__owner = true;
     }
 
     dbuffer_t& operator=(const dbuffer_t& source) {
         if (this != &source) {
+            if (!__owner) {
+                __copy_into_view(source);
+                return *this;
+            }
             __free();
-            __data = __allocate(source.__len);
-            __len = source.__len;
-            std::memcpy(__data, source.__data, __len);
+            __copy_from(source);
         }
         return *this;
     }
 
-    dbuffer_t& operator=(dbuffer_t&& source) noexcept {
+    dbuffer_t& operator=(dbuffer_t&& source) {
         if (this != &source) {
+            if (!__owner) {
+                __copy_into_view(source);
+                return *this;
+            }
             __free();
+            if (!__resource->is_equal(*source.__resource) || __align != source.__align) {
+                __copy_from(source);
+                return *this;
+            }
+            __resource = source.__resource;
+            __align = source.__align;
             __data = std::move(source.__data);
             __len = std::move(source.__len);
+            __owner = source.__owner;
+            __cow = std::move(source.__cow);
 
             source.__data = nullptr;
             source.__len = 0;
+            source.__owner = true;
         }
         return *this;
     }
 
+    /**
+     * @brief Turn buffer into copy-on-write buffer (does nothing for views and shared buffers)
+     *
+     * @details Current content becomes frozen base, and all pages become read only, so host
+     *          addresses of pages which were taken before must be updated.
+     */
+    inline void share() {
+        if (!__owner || __cow != nullptr || __len == 0)
+            return;
+
+        __cow = std::make_unique<CowState>();
+        __cow->frozen = std::shared_ptr<const uint8_t[]>(__data
+                            , [resource = __resource, len = __len, align = __align](uint8_t* data) {
+                                resource->deallocate(data, len, align);
+                            });
+        __cow->private_pages.assign(__pages_num(), false);
+        __cow->shared_num = __pages_num();
+        __data = __allocate(__len);
+    }
+
+    /** Copy all frozen pages to the private memory, so buffer becomes an ordinary buffer */
+    inline void unshare() {
+        for (size_t page_idx = 0; __cow != nullptr && page_idx < __pages_num(); ++page_idx)
+            privatize_page(page_idx);
+    }
+
+    /**
+     * @brief returns true if buffer is a copy-on-write buffer with frozen pages
+     */
+    inline bool is_shared() const {
+        return __cow != nullptr;
+    }
+
+    /**
+     * @brief Copy frozen page to the private memory (does nothing if the page is writable)
+     * @return host address of the writable page
+     */
+    inline uint8_t* privatize_page(size_t page_idx) {
+        const size_t page_offset = page_idx * PAGE_SIZE;
+
+        if (__cow != nullptr && !__cow->private_pages[page_idx]) {
+            std::memcpy(__data + page_offset, __cow->frozen.get() + page_offset, __page_len(page_idx));
+            __cow->private_pages[page_idx] = true;
+            if (--__cow->shared_num == 0)
+                __cow.reset();
+        }
+        return __data + page_offset;
+    }
+
+    /**
+     * @brief get host address of the page for reading
+     */
+    inline const uint8_t* get_page_rd_addr(size_t page_idx) const {
+        const size_t page_offset = page_idx * PAGE_SIZE;
+
+        if (__cow == nullptr || __cow->private_pages[page_idx])
+            return __data + page_offset;
+        return __cow->frozen.get() + page_offset;
+    }
+
+    /**
+     * @brief get host address of the page for writing (nullptr if the page is frozen)
+     */
+    inline uint8_t* get_page_wr_addr(size_t page_idx) const {
+        const size_t page_offset = page_idx * PAGE_SIZE;
+
+        if (__cow == nullptr || __cow->private_pages[page_idx])
+            return __data + page_offset;
+        return nullptr;
+    }
+
     /**
      * @brief get allocated memory size
      */
@@ -119,6 +352,27 @@ class dbuffer_t {
         return __len;
     }
 
+    /**
+     * @brief get memory resource of the buffer
+     */
+    inline std::pmr::memory_resource* get_memory_resource() const {
+        return __resource;
+    }
+
+    /**
+     * @brief get alignment of buffer data
+     */
+    inline size_t get_alignment() const {
+        return __align;
+    }
+
+    /**
+     * @brief returns true if buffer is a view of an external memory
+     */
+    inline bool is_view() const {
+        return !__owner;
+    }
+
     /**
      * @brief get allocated memory length
      */
@@ -127,23 +381,27 @@ class dbuffer_t {
     }
 
     /**
-     * @brief get address of buffers data
+     * @brief get address of buffers data (shared buffer is unshared)
      */
     inline uint8_t* get_data_addr() {
+        unshare();
         return __data;
     }
 
     /**
-     * @brief get address of buffers data
+     * @brief get address of buffers data (buffer must not be shared)
      */
-    inline uint8_t* get_data_addr() const {
+    inline const uint8_t* get_data_addr() const {
+        assert(__cow == nullptr);
         return __data;
     }
 
     /**
-     * @brief get access to byte at some offset
+     * @brief get access to byte at some offset (page of shared buffer is privatized)
      */
     inline uint8_t& operator[](size_t offset) {
+        if (__cow != nullptr)
+            privatize_page(offset / PAGE_SIZE);
         return __data[offset];
     }
 
@@ -151,6 +409,8 @@ class dbuffer_t {
      * @brief get access to byte at some offset
      */
     inline const uint8_t& operator[](size_t offset) const {
+        if (__cow != nullptr)
+            return get_page_rd_addr(offset / PAGE_SIZE)[offset % PAGE_SIZE];
         return __data[offset];
     }
 
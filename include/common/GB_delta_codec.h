@@ -0,0 +1,56 @@
+/**
+ * @file GB_delta_codec.h
+ * @brief Describes XOR-delta run-length codec for memory images
+ */
+
+#ifndef COMMON_GB_DELTA_CODEC_H_
+# define COMMON_GB_DELTA_CODEC_H_
+
+# include <cstddef>
+# include <cstdint>
+
+/**
+ * @brief Codec of difference between two images of the same size
+ *
+ * @details Delta is XOR of the image and the reference, so consecutive snapshots of
+ *          the emulated memory produce long runs of zero words. Delta is encoded word by word
+ *          (WORD_SIZE bytes) into tokens:
+ *
+ *              [u16 zero words][u16 literal words][literal words of the delta]
+ *
+ *          Bytes after the last whole word are stored as a raw delta at the end of the stream.
+ *          Decoding XORs the delta into the buffer, which holds the reference, so the same
+ *          stream turns the reference into the image and back. Image, which is encoded without
+ *          reference (nullptr), is a delta against zeros.
+ */
+class delta_codec_t {
+ public:
+    constexpr static size_t WORD_SIZE = sizeof(uint64_t);
+    constexpr static size_t MAX_RUN = 0xFFFF;           ///< max words in a run of a token
+    constexpr static size_t TOKEN_HEADER_SIZE = 2 * sizeof(uint16_t);
+
+    /** Get encoded size of the worst (incompressible) image of len bytes */
+    constexpr static size_t max_encoded_size(size_t len) {
+        return len + (len / WORD_SIZE / MAX_RUN + 1) * TOKEN_HEADER_SIZE;
+    }
+
+    /**
+     * @brief Encode delta between the image and the reference
+     * @param[in] image image of len bytes
+     * @param[in] reference reference of len bytes, or nullptr to encode the image itself
+     * @param[out] dst buffer of max_encoded_size(len) bytes
+     * @return size of the encoded delta
+     */
+    static size_t encode(const uint8_t* image, const uint8_t* reference, size_t len, uint8_t* dst);
+
+    /**
+     * @brief XOR encoded delta into the buffer
+     * @param[in] src encoded delta
+     * @param[in] src_len size of the encoded delta
+     * @param[in,out] buffer reference (or zeros) of len bytes, which becomes the image
+     * @return false if the stream is corrupted or encodes an image of another size
+     */
+    static bool decode(const uint8_t* src, size_t src_len, uint8_t* buffer, size_t len);
+};
+
+#endif  // COMMON_GB_DELTA_CODEC_H_
@@ -0,0 +1,42 @@
+/**
+ * @file GB_memory_resource.h
+ * @brief Describes memory resources for dynamic buffers
+ */
+
+#ifndef COMMON_GB_MEMORY_RESOURCE_H_
+# define COMMON_GB_MEMORY_RESOURCE_H_
+
+# include <memory_resource>
+
+# include <cstddef>
+
+/**
+ * @brief Memory resource, which backs every allocation with transparent huge pages
+ *
+ * @details Allocations are rounded up to HUGE_PAGE_SIZE and aligned to it, so the kernel
+ *          can back them with huge pages (madvise(MADV_HUGEPAGE) on Linux, plain anonymous
+ *          mapping on other systems). It's intended as an upstream of a pmr pool or
+ *          a monotonic buffer, which packs buffers of many instances into a few huge pages:
+ *
+ *              hugepage_resource_t                     hugepages;
+ *              std::pmr::monotonic_buffer_resource     pool(hugepage_resource_t::HUGE_PAGE_SIZE, &hugepages);
+ *              dbuffer_t                               buffer(size, &pool, dbuffer_t::CACHE_LINE_ALIGNMENT);
+ */
+class hugepage_resource_t : public std::pmr::memory_resource {
+ public:
+    constexpr static size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+
+    /** Returns true if the system is asked to back allocations with huge pages */
+    static bool is_hugepage_supported();
+
+ protected:
+    inline static size_t __round_up(size_t bytes) {
+        return (bytes + HUGE_PAGE_SIZE - 1) & ~(HUGE_PAGE_SIZE - 1);
+    }
+
+    void* do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void* ptr, size_t bytes, size_t alignment) override;
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+};
+
+#endif  // COMMON_GB_MEMORY_RESOURCE_H_
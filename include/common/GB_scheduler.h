@@ -0,0 +1,318 @@
+/**
+ * @file GB_scheduler.h
+ * @brief Describes event scheduler, which dispatches device events at absolute clock cycles
+ */
+
+#ifndef COMMON_GB_SCHEDULER_H_
+# define COMMON_GB_SCHEDULER_H_
+
+# include <algorithm>
+# include <array>
+# include <limits>
+
+# include "common/GB_clock.h"
+
+namespace devsync {
+
+/**
+ * @brief Scheduler of device events keyed by absolute clock cycle
+ *
+ * @details Devices register an event slot once, and then (re)schedule its deadline.
+ *          Pending events are kept in an indexed binary min-heap, so the earliest deadline
+ *          costs a single load, and rescheduling of a pending event costs O(log n).
+ *          Events with the same deadline are dispatched in order of their ids.
+ *
+ *          The core asks for a budget (see get_budget()), spends it with devsync::pay()
+ *          while devsync::is_ready() and then commits the spent cycles with advance(),
+ *          so no device is stepped between events.
+ *
+ *          Lazily synchronized devices (see sync_stamp_t) read current time through
+ *          get_clock(), so the core commits spent cycles before bus accesses to I/O.
+ */
+class Scheduler {
+ public:
+    using event_id_t = unsigned;
+
+    /**
+     * @brief Event callback
+     * @details Called with scheduler time equal to the deadline, so callback can reschedule
+     *          the event relative to get_time().
+     */
+    using Callback = void(*)(void* owner, clk_cycle_t deadline);
+
+    constexpr static unsigned MAX_EVENTS = 32;
+    constexpr static event_id_t NO_EVENT = std::numeric_limits<event_id_t>::max();
+    constexpr static clk_cycle_t NEVER = std::numeric_limits<clk_cycle_t>::max();
+
+    /**
+     * @brief Trivially copyable scheduler state
+     * @details Callbacks aren't saved, so the state is restored to the scheduler with the same
+     *          registered events (the same machine type).
+     */
+    struct State {
+        clk_cycle_t                             time;
+        std::array<clk_cycle_t, MAX_EVENTS>     deadlines;  ///< NEVER for events, which aren't pending
+    };
+
+ protected:
+    constexpr static unsigned NOT_PENDING = std::numeric_limits<unsigned>::max();
+
+    struct Event {
+        Callback        callback;
+        void*           owner;
+        clk_cycle_t     deadline;
+        unsigned        heap_idx;   ///< position in the heap, NOT_PENDING if not scheduled
+    };
+
+    std::array<Event, MAX_EVENTS>       __events;
+    std::array<event_id_t, MAX_EVENTS>  __heap;
+    unsigned                            __events_num;
+    unsigned                            __pending_num;
+    clk_cycle_t                         __time;
+
+    inline bool __is_earlier(event_id_t lhs, event_id_t rhs) const;
+    inline void __place(unsigned heap_idx, event_id_t id);
+    inline void __sift_up(unsigned heap_idx);
+    inline void __sift_down(unsigned heap_idx);
+    inline void __remove(unsigned heap_idx);
+
+ public:
+    explicit
+    Scheduler(clk_cycle_t start_time = 0)
+    : __events(), __heap(), __events_num(0), __pending_num(0), __time(start_time) {}
+
+    /**
+     * @brief Register event slot
+     * @return id of the event slot, or NO_EVENT if there are no free slots
+     */
+    inline event_id_t register_event(Callback callback, void* owner);
+
+    /** Schedule (or reschedule) event at the absolute deadline */
+    inline void schedule(event_id_t id, clk_cycle_t deadline);
+
+    /** Schedule (or reschedule) event after some cycles from now */
+    inline void schedule_in(event_id_t id, clk_cycle_t cycles);
+
+    /** Cancel event, if it's pending */
+    inline void cancel(event_id_t id);
+
+    inline bool is_pending(event_id_t id) const;
+
+    /** Get deadline of the pending event (NEVER if event isn't pending) */
+    inline clk_cycle_t get_deadline(event_id_t id) const;
+
+    /** Get deadline of the earliest pending event (NEVER if there is no pending events) */
+    inline clk_cycle_t get_next_deadline() const;
+
+    /** Get current time */
+    inline clk_cycle_t get_time() const;
+
+    /** Get current time source for lazily synchronized devices */
+    inline const clk_cycle_t* get_clock() const { return &__time; }
+
+    /**
+     * @brief Get budget, which can be spent before the earliest event
+     * @param[in] limit max cycles to give
+     * @return budget, which is ready (see devsync::is_ready) while spent cycles don't reach
+     *         the earliest deadline. Action which is started before the deadline can overrun it.
+     */
+    inline clk_cycle_t get_budget(clk_cycle_t limit = NEVER) const;
+
+    /** Get time and deadlines of the pending events */
+    inline State get_state() const;
+
+    /** Restore time and pending events (no callback is called) */
+    inline void set_state(const State& state);
+
+    /**
+     * @brief Move time forward and dispatch all events with deadline up to the new time
+     * @details Events are dispatched in deadline order, and time is equal to the deadline
+     *          of the dispatched event, so events scheduled by callbacks in the past of
+     *          the new time are dispatched too.
+     */
+    inline void advance_to(clk_cycle_t time);
+
+    /** Move time forward by some cycles (see advance_to()) */
+    inline void advance(clk_cycle_t cycles);
+};
+
+inline bool
+Scheduler::__is_earlier(event_id_t lhs, event_id_t rhs) const {
+    const clk_cycle_t lhs_deadline = __events[lhs].deadline;
+    const clk_cycle_t rhs_deadline = __events[rhs].deadline;
+
+    return (lhs_deadline < rhs_deadline) || (lhs_deadline == rhs_deadline && lhs < rhs);
+}
+
+inline void
+Scheduler::__place(unsigned heap_idx, event_id_t id) {
+    __heap[heap_idx] = id;
+    __events[id].heap_idx = heap_idx;
+}
+
+inline void
+Scheduler::__sift_up(unsigned heap_idx) {
+    const event_id_t id = __heap[heap_idx];
+
+    while (heap_idx != 0) {
+        const unsigned parent_idx = (heap_idx - 1) / 2;
+        if (!__is_earlier(id, __heap[parent_idx]))
+            break;
+        __place(heap_idx, __heap[parent_idx]);
+        heap_idx = parent_idx;
+    }
+    __place(heap_idx, id);
+}
+
+inline void
+Scheduler::__sift_down(unsigned heap_idx) {
+    const event_id_t id = __heap[heap_idx];
+
+    while (true) {
+        const unsigned left_idx = heap_idx * 2 + 1;
+        const unsigned right_idx = left_idx + 1;
+        unsigned min_idx = heap_idx;
+        event_id_t min_id = id;
+
+        if (left_idx < __pending_num && __is_earlier(__heap[left_idx], min_id)) {
+            min_idx = left_idx;
+            min_id = __heap[left_idx];
+        }
+        if (right_idx < __pending_num && __is_earlier(__heap[right_idx], min_id)) {
+            min_idx = right_idx;
+            min_id = __heap[right_idx];
+        }
+        if (min_idx == heap_idx)
+            break;
+        __place(heap_idx, min_id);
+        heap_idx = min_idx;
+    }
+    __place(heap_idx, id);
+}
+
+inline void
+Scheduler::__remove(unsigned heap_idx) {
+    const event_id_t id = __heap[heap_idx];
+    const unsigned last_idx = --__pending_num;
+
+    __events[id].heap_idx = NOT_PENDING;
+    if (heap_idx == last_idx)
+        return;
+
+    // last event takes the place, and goes up or down from it
+    const event_id_t moved_id = __heap[last_idx];
+    __place(heap_idx, moved_id);
+    __sift_up(heap_idx);
+    if (__events[moved_id].heap_idx == heap_idx)
+        __sift_down(heap_idx);
+}
+
+inline Scheduler::event_id_t
+Scheduler::register_event(Callback callback, void* owner) {
+    if (__events_num == MAX_EVENTS)
+        return NO_EVENT;
+
+    const event_id_t id = __events_num++;
+    __events[id] = Event{callback, owner, NEVER, NOT_PENDING};
+    return id;
+}
+
+inline void
+Scheduler::schedule(event_id_t id, clk_cycle_t deadline) {
+    Event& event = __events[id];
+    const bool later = event.deadline < deadline;
+
+    event.deadline = deadline;
+    if (event.heap_idx == NOT_PENDING) {
+        __place(__pending_num++, id);
+        __sift_up(event.heap_idx);
+    } else if (later) {
+        __sift_down(event.heap_idx);
+    } else {
+        __sift_up(event.heap_idx);
+    }
+}
+
+inline void
+Scheduler::schedule_in(event_id_t id, clk_cycle_t cycles) {
+    schedule(id, __time + cycles);
+}
+
+inline void
+Scheduler::cancel(event_id_t id) {
+    if (__events[id].heap_idx != NOT_PENDING)
+        __remove(__events[id].heap_idx);
+}
+
+inline bool
+Scheduler::is_pending(event_id_t id) const {
+    return __events[id].heap_idx != NOT_PENDING;
+}
+
+inline clk_cycle_t
+Scheduler::get_deadline(event_id_t id) const {
+    return is_pending(id) ? __events[id].deadline : NEVER;
+}
+
+inline clk_cycle_t
+Scheduler::get_next_deadline() const {
+    return (__pending_num != 0) ? __events[__heap[0]].deadline : NEVER;
+}
+
+inline clk_cycle_t
+Scheduler::get_time() const {
+    return __time;
+}
+
+inline clk_cycle_t
+Scheduler::get_budget(clk_cycle_t limit) const {
+    const clk_cycle_t next_deadline = get_next_deadline();
+    const clk_cycle_t until_event = (next_deadline == NEVER) ? NEVER : next_deadline - __time;
+
+    return std::min(until_event, limit) - 1;
+}
+
+inline Scheduler::State
+Scheduler::get_state() const {
+    State state;
+
+    state.time = __time;
+    for (event_id_t id = 0; id < MAX_EVENTS; ++id)
+        state.deadlines[id] = (id < __events_num) ? get_deadline(id) : NEVER;
+    return state;
+}
+
+inline void
+Scheduler::set_state(const State& state) {
+    __time = state.time;
+    __pending_num = 0;
+    for (event_id_t id = 0; id < __events_num; ++id) {
+        __events[id].deadline = NEVER;
+        __events[id].heap_idx = NOT_PENDING;
+    }
+    for (event_id_t id = 0; id < __events_num; ++id) {
+        if (state.deadlines[id] != NEVER)
+            schedule(id, state.deadlines[id]);
+    }
+}
+
+inline void
+Scheduler::advance_to(clk_cycle_t time) {
+    while (__pending_num != 0 && __events[__heap[0]].deadline <= time) {
+        const Event event = __events[__heap[0]];
+
+        __time = std::max(__time, event.deadline);
+        __remove(0);
+        event.callback(event.owner, event.deadline);
+    }
+    __time = std::max(__time, time);
+}
+
+inline void
+Scheduler::advance(clk_cycle_t cycles) {
+    advance_to(__time + cycles);
+}
+
+}  // namespace devsync
+
+#endif  // COMMON_GB_SCHEDULER_H_
@@ -0,0 +1,42 @@
+/**
+ * @file GB_span.h
+ * @brief Describes non-owning view of contiguous memory
+ */
+
+#ifndef COMMON_GB_SPAN_H_
+# define COMMON_GB_SPAN_H_
+
+# include <cstddef>
+
+/**
+ * @brief Non-owning view of contiguous elements (subset of C++20 std::span)
+ * @details View doesn't extend the lifetime of the memory, and is invalidated by any
+ *          change of the memory location (e.g. bank switch or copy-on-write copy).
+ */
+template <typename _Tp>
+class span_t {
+ public:
+    using element_type = _Tp;
+    using iterator = _Tp*;
+
+    constexpr span_t() : __data(nullptr), __len(0) {}
+    constexpr span_t(_Tp* data, size_t length) : __data(data), __len(length) {}
+
+    constexpr _Tp* data() const { return __data; }
+    constexpr size_t size() const { return __len; }
+    constexpr bool empty() const { return __len == 0; }
+
+    constexpr iterator begin() const { return __data; }
+    constexpr iterator end() const { return __data + __len; }
+
+    constexpr _Tp& operator[](size_t idx) const { return __data[idx]; }
+
+    /** Get view of count elements from offset (offset + count must not exceed size()) */
+    constexpr span_t subspan(size_t offset, size_t count) const { return span_t(__data + offset, count); }
+
+ protected:
+    _Tp*    __data;
+    size_t  __len;
+};
+
+#endif  // COMMON_GB_SPAN_H_
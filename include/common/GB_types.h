@@ -10,6 +10,7 @@
 # include <cstdint>
 
 # include "common/GB_dbuffer.h"
+# include "common/GB_span.h"
 
 using u64   = uint64_t;
 using i64   = int64_t;
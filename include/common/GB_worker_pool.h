@@ -0,0 +1,85 @@
+/**
+ * @file GB_worker_pool.h
+ * @brief Describes fixed pool of worker threads, which run the same job in lockstep
+ */
+
+#ifndef COMMON_GB_WORKER_POOL_H_
+# define COMMON_GB_WORKER_POOL_H_
+
+# include <condition_variable>    // NOLINT(build/c++11)
+# include <mutex>                 // NOLINT(build/c++11)
+# include <thread>                // NOLINT(build/c++11)
+# include <vector>
+
+# include <cstddef>
+
+# include "common/GB_types.h"
+
+/**
+ * @brief Pool of threads, which run a job on every worker and wait for all of them
+ *
+ * @details Job is a plain function with a context pointer, so dispatch allocates nothing:
+ *          run() publishes the job, wakes the workers and sleeps until the last of them
+ *          is done. Worker knows its index, so a caller partitions the work statically
+ *          (e.g. worker n owns items n, n + size(), ...), and an item is always handled by
+ *          the same thread.
+ *
+ *          Pinned worker n is bound to the n-th CPU of the process affinity set (modulo
+ *          its size), so statically partitioned items stay in the cache of one core.
+ *          Pinning is supported on Linux only, and is a no-op on other systems.
+ */
+class worker_pool_t {
+ public:
+    using job_t = void (*)(void* context, unsigned worker_idx);
+
+ protected:
+    std::vector<std::thread>    __workers;
+    std::mutex                  __mutex;
+    std::condition_variable     __start_cv;
+    std::condition_variable     __done_cv;
+    job_t                       __job;
+    void*                       __context;
+    u64                         __generation;       ///< number of published jobs
+    unsigned                    __busy_num;         ///< workers, which run the current job
+    unsigned                    __pinned_num;
+    bool                        __is_stopped;
+
+ protected:
+    void __work(unsigned worker_idx);
+
+    /** Bind worker to a CPU of the process affinity set, returns false if it's not bound */
+    bool __pin(unsigned worker_idx);
+
+ public:
+    /**
+     * @brief Start workers
+     * @param[in] workers_num number of workers (0 is one worker)
+     * @param[in] is_pinned bind workers to CPUs
+     */
+    explicit
+    worker_pool_t(unsigned workers_num, bool is_pinned = true);
+    ~worker_pool_t();
+
+    worker_pool_t(const worker_pool_t&) = delete;
+    worker_pool_t& operator=(const worker_pool_t&) = delete;
+
+    /** Returns true if workers can be bound to CPUs on this system */
+    static bool is_pinning_supported();
+
+    /**
+     * @brief Get number of CPUs, which the process may run on (at least one)
+     * @details It's the size of the process affinity set on Linux, so pinned workers of this
+     *          number get a CPU each, and the number of online CPUs on other systems.
+     */
+    static unsigned get_cpus_num();
+
+    inline size_t size() const { return __workers.size(); }
+
+    /** Get number of workers, which are bound to CPUs */
+    inline unsigned get_pinned_num() const { return __pinned_num; }
+
+    /** Run job(context, worker_idx) on every worker, and wait until all of them return */
+    void run(job_t job, void* context);
+};
+
+#endif  // COMMON_GB_WORKER_POOL_H_
@@ -0,0 +1,231 @@
+/**
+ * @file GB_cpu.h
+ * @brief Describes SM83 CPU interpreter
+ */
+
+#ifndef CORE_GB_CPU_H_
+# define CORE_GB_CPU_H_
+
+# include <array>
+# include <memory>
+# include <vector>
+
+# include "GB_config.h"
+
+# include "common/GB_clock.h"
+# include "common/GB_macro.h"
+# include "common/GB_scheduler.h"
+# include "common/GB_types.h"
+
+# include "device/GB_interrupt.h"
+
+# include "memory/GB_bus.h"
+
+namespace GB::core {
+
+/**
+ * @brief SM83 CPU interpreter
+ *
+ * @details Handlers of all 256 opcodes and 256 CB-prefixed opcodes are instantiated at compile
+ *          time from templates over the opcode bit fields (register, register pair, condition and
+ *          ALU operation), and dispatched through flat function tables. Every handler is wrapped
+ *          into devsync::Action with the opcode price from one timing table, and taken branches
+ *          pay their extra cycles with an action too.
+ *
+ *          step() executes one instruction (or interrupt dispatch) and returns its cycles, so the
+ *          machine commits them to the scheduler between instructions: bus accesses of an
+ *          instruction see the time of its start.
+ *
+ *          execute_block() runs a block of instructions, which is decoded once from the PC: every
+ *          instruction becomes a micro-op with its operand bytes and next PC, so no opcode fetch
+ *          and decoding is repeated. Blocks end at control flow, HALT, STOP, EI and illegal
+ *          opcodes, or at the page end. Blocks are cached per code page, which is checked
+ *          against the host memory of the page (another ROM or WRAM bank is a new key), and
+ *          CPU writes to RAM pages with cached blocks invalidate them (see invalidate_blocks()
+ *          for other writers).
+ *
+ *          IME is kept by the interrupt controller. EI takes effect after the next instruction,
+ *          HALT with IME reset and a pending interrupt doesn't halt and repeats the next byte
+ *          (HALT bug), STOP halts CPU till any interrupt, and illegal opcodes lock CPU forever.
+ *
+ *          CPU is linked to the bus and interrupt controller, and is not copyable.
+ */
+class CPU {
+ public:
+    /** Flag bit offsets at F register */
+    enum Flag : u8 {
+        C_FLAG = 4,     ///< carry
+        H_FLAG = 5,     ///< half carry
+        N_FLAG = 6,     ///< subtraction
+        Z_FLAG = 7,     ///< zero
+    };
+
+    constexpr static byte_t F_REG_MASK = ::bit_mask(7, 4);
+    constexpr static word_t HIGH_PAGE_VADDR = 0xFF00;             ///< base of LDH addressing
+    constexpr static clk_cycle_t INTERRUPT_CYCLES = 5_MCycles;    ///< interrupt dispatch
+    constexpr static clk_cycle_t IDLE_CYCLES = 1_MCycles;         ///< halted or locked CPU step
+
+    /**
+     * @brief CPU registers
+     */
+    struct Registers {
+        byte_t  B, C, D, E, H, L, F, A;
+        word_t  SP;
+        word_t  PC;
+
+        explicit
+        Registers(word_t val_AF = ::GB::CPU_AF_INIT_VALUE
+                , word_t val_BC = ::GB::CPU_BC_INIT_VALUE
+                , word_t val_DE = ::GB::CPU_DE_INIT_VALUE
+                , word_t val_HL = ::GB::CPU_HL_INIT_VALUE
+                , word_t val_SP = ::GB::CPU_SP_INIT_VALUE
+                , word_t val_PC = ::GB::CPU_PC_INIT_VALUE)
+        : B(byte_t(val_BC >> 8)), C(byte_t(val_BC))
+        , D(byte_t(val_DE >> 8)), E(byte_t(val_DE))
+        , H(byte_t(val_HL >> 8)), L(byte_t(val_HL))
+        , F(byte_t(val_AF) & F_REG_MASK), A(byte_t(val_AF >> 8))
+        , SP(val_SP), PC(val_PC) {}
+
+        inline word_t get_AF() const { return word_t((A << 8) | F); }
+        inline word_t get_BC() const { return word_t((B << 8) | C); }
+        inline word_t get_DE() const { return word_t((D << 8) | E); }
+        inline word_t get_HL() const { return word_t((H << 8) | L); }
+
+        inline bool get_flag(Flag flag) const { return ::bit_n(flag, F); }
+    };
+
+    /** Trivially copyable CPU state */
+    struct State {
+        Registers   registers;
+        bool        is_halted;
+        bool        is_locked;
+        bool        is_ime_scheduled;
+        bool        has_halt_bug;
+    };
+
+ protected:
+    template <bool _Decoded>
+    struct __Instructions;
+
+    /** Pre-decoded instruction */
+    struct __MicroOp {
+        void    (*handler)(CPU* cpu);
+        word_t  next_pc;
+        byte_t  operands[2];
+    };
+
+    /** Run of pre-decoded instructions */
+    struct __Block {
+        u32         first_op;       ///< index of the first micro-op
+        u32         ops_num;
+        clk_cycle_t max_cycles;     ///< cycles of the block, if the last branch is taken
+    };
+
+    /** Blocks, which start at a code page */
+    struct __CodePage {
+        const byte_t*       host;       ///< host memory, which the blocks are decoded from
+        std::array<u32, memory::BusInterface::PAGE_SIZE> blocks;   ///< block index + 1 at each offset (0 - none)
+    };
+
+    Registers                       __registers;
+    memory::BusInterface*           __bus;
+    device::InterruptController*    __interrupt_link;
+    clk_cycle_t                     __clock;        ///< cycles of the current step (paid by actions)
+    bool                            __is_halted;
+    bool                            __is_locked;
+    bool                            __is_ime_scheduled;
+    bool                            __has_halt_bug;
+
+    /** Block cache */
+    std::vector<__MicroOp>          __ops;
+    std::vector<__Block>            __blocks;
+    std::array<std::unique_ptr<__CodePage>, memory::BusInterface::PAGES_NUM>   __code_pages;
+    memory::BusInterface::PageSet   __ram_code_pages;   ///< RAM pages (and echoes), which have blocks
+
+    /** Current block */
+    devsync::Scheduler*             __block_scheduler;
+    const byte_t*                   __operands;         ///< operand bytes of the current micro-op
+    clk_cycle_t                     __op_clock;         ///< block cycles before the current micro-op
+    clk_cycle_t                     __committed;        ///< block cycles, which are committed
+    bool                            __is_block_break;
+
+    void __dispatch_interrupt();
+
+    const __Block* __find_block(word_t pc);
+    u32 __decode_block(word_t pc, const byte_t* host);
+    void __invalidate_code_page(unsigned page_idx);
+    void __flush_blocks();
+    void __commit_block_cycles();
+
+ public:
+    /**
+     * @param[in] bus memory bus, which is accessed by instructions
+     * @param[in] ic_link interrupt controller, which keeps IME and requests interrupts
+     * @param[in] regs initial registers values
+     */
+    CPU(memory::BusInterface* bus, device::InterruptController* ic_link, const Registers& regs = Registers());
+
+    CPU(const CPU&) = delete;
+    CPU& operator=(const CPU&) = delete;
+
+    /**
+     * @brief Execute one instruction, or dispatch pending interrupt
+     * @return cycles of the step (IDLE_CYCLES, if CPU is halted or locked)
+     */
+    clk_cycle_t step();
+
+    /**
+     * @brief Execute a pre-decoded block at PC, and commit its cycles to the scheduler
+     * @param[in] scheduler machine scheduler
+     * @param[in] limit absolute time, which the block doesn't pass
+     * @return cycles of the block
+     *
+     * @details The block is executed only if it ends before the next scheduler deadline,
+     *          so no event is dispatched inside it. Accesses to OAM and I/O commit cycles
+     *          of the previous instructions first, so lazy devices see the same time as
+     *          with step(), and end the block after the instruction (the access could
+     *          request an interrupt or start DMA). CPU falls back to step() if there is no
+     *          block or it doesn't fit, and when interrupts, EI delay, HALT bug or bus lock
+     *          need instruction granularity.
+     */
+    clk_cycle_t execute_block(devsync::Scheduler& scheduler, clk_cycle_t limit);
+
+    /**
+     * @brief Drop pre-decoded blocks of RAM
+     * @details Call it after RAM is changed by anything but CPU (e.g. state load). Blocks of
+     *          ROM are kept: ROM isn't writable, and its banks are checked by host memory.
+     */
+    void invalidate_blocks();
+
+    inline State get_state() const;
+
+    /** Restore CPU state (blocks are kept, see invalidate_blocks()) */
+    inline void set_state(const State& state);
+
+    /** Returns true if CPU waits for an interrupt (HALT or STOP) */
+    inline bool is_halted() const { return __is_halted; }
+
+    /** Returns true if CPU has executed an illegal opcode */
+    inline bool is_locked() const { return __is_locked; }
+
+    inline Registers& get_registers() { return __registers; }
+    inline const Registers& get_registers() const { return __registers; }
+};
+
+inline CPU::State
+CPU::get_state() const {
+    return State{__registers, __is_halted, __is_locked, __is_ime_scheduled, __has_halt_bug};
+}
+
+inline void
+CPU::set_state(const State& state) {
+    __registers = state.registers;
+    __is_halted = state.is_halted;
+    __is_locked = state.is_locked;
+    __is_ime_scheduled = state.is_ime_scheduled;
+    __has_halt_bug = state.has_halt_bug;
+}
+
+}  // namespace GB::core
+
+#endif  // CORE_GB_CPU_H_
@@ -0,0 +1,370 @@
+/**
+ * @file GB_machine.h
+ * @brief Describes GameBoy machine, which connects devices with the memory bus
+ */
+
+#ifndef CORE_GB_MACHINE_H_
+# define CORE_GB_MACHINE_H_
+
+# include <variant>
+# include <memory_resource>
+
+# include <algorithm>
+# include <cstring>
+# include <type_traits>
+# include <utility>
+
+# include "GB_config.h"
+
+# include "common/GB_scheduler.h"
+# include "common/GB_types.h"
+
+# include "core/GB_cpu.h"
+
+# include "device/GB_cartridge.h"
+# include "device/GB_dma.h"
+# include "device/GB_hdma.h"
+# include "device/GB_hram.h"
+# include "device/GB_interrupt.h"
+# include "device/GB_joypad.h"
+# include "device/GB_oram.h"
+# include "device/GB_timer.h"
+# include "device/GB_vram.h"
+# include "device/GB_wram.h"
+
+# include "memory/GB_arena.h"
+# include "memory/GB_bus.h"
+
+namespace GB::core {
+
+/**
+ * @brief GameBoy machine, specialized for a hardware mode at compile time
+ *
+ * @details All devices of the machine are instantiated for the same mode, so DMG machine
+ *          has no CGB bank select logic at all. Storage of all memory devices is placed
+ *          in one arena, and devices register their deadlines at the machine scheduler.
+ *          Machine is not copyable and not movable, because devices are linked to
+ *          the machine's bus and arena.
+ */
+template <GBModeFlag _Mode>
+class Machine {
+ public:
+    using WRAM = device::WRAM<_Mode>;
+    using VRAM = device::VRAM<_Mode>;
+    using HDMA = device::HDMA<_Mode>;
+    using Arena = memory::Arena<_Mode>;
+
+    constexpr static GBModeFlag MODE = _Mode;
+
+    /**
+     * @brief Trivially copyable state of all machine devices
+     * @details Memory of the devices isn't here: it's saved with the arena. Padding of the state,
+     *          of the device states and up to the arena is zeroed, so equal machines give equal images.
+     */
+    struct State {
+        u32                                 magic;
+        u32                                 version;
+        GBModeFlag                          mode;
+        size_t                              arena_size;
+        devsync::Scheduler::State           scheduler;
+        device::InterruptController::State  int_ctrl;
+        CPU::State                          cpu;
+        device::JoyPad::State               joypad;
+        device::Timer::State                timer;
+        typename WRAM::State                wram;
+        typename VRAM::State                vram;
+        device::DMA::State                  dma;
+        typename HDMA::State                hdma;
+    };
+
+    constexpr static u32 STATE_MAGIC = 0x534D4247;      ///< "GBMS"
+    constexpr static u32 STATE_VERSION = 1;
+
+    /** Save-state image is State and the arena, which starts at a cache line */
+    constexpr static size_t STATE_ARENA_OFFSET = (sizeof(State) + Arena::CACHE_LINE_SIZE - 1) & ~(Arena::CACHE_LINE_SIZE - 1);
+
+ protected:
+    memory::BusInterface            __bus;
+    devsync::Scheduler              __scheduler;
+    Arena                           __arena;
+    device::InterruptController     __int_ctrl;
+    CPU                             __cpu;
+    device::JoyPad                  __joypad;
+    device::Timer                   __timer;
+    device::Cartridge               __cartridge;
+    WRAM                            __wram;
+    VRAM                            __vram;
+    device::ORAM                    __oram;
+    device::HRAM                    __hram;
+    device::DMA                     __dma;
+    HDMA                            __hdma;
+
+ public:
+    /**
+     * @brief Create machine and map all devices to the bus
+     * @param[in] rom cartridge ROM image
+     * @param[in] resource memory resource for the arena, which must outlive the machine
+     */
+    explicit
+    Machine(dbuffer_t rom = dbuffer_t(), std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+    Machine(const Machine&) = delete;
+    Machine& operator=(const Machine&) = delete;
+
+    /**
+     * @brief Fast-forward halted CPU to the next pending interrupt
+     * @param[in] limit absolute time, which is never passed (e.g. end of the frame)
+     * @return cycles spent in HALT
+     *
+     * @details Only device events can request an interrupt while CPU is halted (joypad
+     *          interrupt is requested by the input, which changes between runs), so time
+     *          jumps from one scheduled deadline to the next one until any enabled interrupt
+     *          is requested, regardless of IME. CPU wakes up at the deadline of the event,
+     *          which has requested the interrupt.
+     */
+    clk_cycle_t fast_forward_halt(clk_cycle_t limit);
+
+    /**
+     * @brief Run CPU until the absolute time
+     * @param[in] limit time, which is reached (the last instruction could overrun it)
+     *
+     * @details CPU executes pre-decoded blocks, which end before the next event, and
+     *          commits their cycles (and CPU stall of HDMA blocks) to the scheduler, so device
+     *          events are dispatched between instructions. Halted CPU is fast-forwarded to
+     *          the next interrupt.
+     */
+    void run(clk_cycle_t limit);
+
+    /**
+     * @brief Run CPU until the end of the current frame
+     * @details Frames are aligned to FRAME_CYCLES from the power on, so machines, which are
+     *          restored from the same state, split the time into the same runs.
+     */
+    inline void run_frame() { run((__scheduler.get_time() / FRAME_CYCLES + 1) * FRAME_CYCLES); }
+
+    /** Get size of the save-state image */
+    inline size_t get_state_size() const { return STATE_ARENA_OFFSET + __arena.size(); }
+
+    /**
+     * @brief Save state of the machine to the image
+     * @details Owning buffer is reallocated from its memory resource if its size differs,
+     *          view (e.g. of a mapped file) must have get_state_size() bytes. Lazily synchronized
+     *          devices save their synchronization time, so nothing is synchronized before the copy.
+     */
+    void save_state(dbuffer_t& image) const;
+
+    /**
+     * @brief Restore state of the machine from the image, which is saved by the same machine
+     * @return false if the image has another version, mode or size (machine isn't changed)
+     *
+     * @details Devices restore their state blocks and remap selected banks, and caches, which
+     *          are built from the memory (VRAM tiles, OAM line index, CPU blocks of RAM),
+     *          are rebuilt. The whole memory is marked dirty. Cartridge ROM isn't saved.
+     */
+    bool load_state(const dbuffer_t& image);
+
+    inline memory::BusInterface& get_bus() { return __bus; }
+    inline devsync::Scheduler& get_scheduler() { return __scheduler; }
+    inline Arena& get_arena() { return __arena; }
+    inline device::InterruptController& get_interrupt_controller() { return __int_ctrl; }
+    inline CPU& get_cpu() { return __cpu; }
+    inline device::JoyPad& get_joypad() { return __joypad; }
+    inline device::Timer& get_timer() { return __timer; }
+    inline device::Cartridge& get_cartridge() { return __cartridge; }
+    inline WRAM& get_wram() { return __wram; }
+    inline VRAM& get_vram() { return __vram; }
+    inline device::ORAM& get_oram() { return __oram; }
+    inline device::HRAM& get_hram() { return __hram; }
+    inline device::DMA& get_dma() { return __dma; }
+    inline HDMA& get_hdma() { return __hdma; }
+};
+
+template <GBModeFlag _Mode>
+Machine<_Mode>::Machine(dbuffer_t rom, std::pmr::memory_resource* resource)
+: __bus()
+, __scheduler()
+, __arena(device::Cartridge::sram_size(rom), resource)
+, __int_ctrl()
+, __cpu(&__bus, &__int_ctrl)
+, __joypad(&__int_ctrl, __scheduler.get_clock())
+, __timer(&__int_ctrl, &__scheduler)
+, __cartridge(std::move(rom), __arena.view(Arena::SRAM_REGION))
+, __wram(__arena.view(Arena::WRAM_REGION))
+, __vram(__arena.view(Arena::VRAM_REGION))
+, __oram(__arena.view(Arena::OAM_REGION))
+, __hram(__arena.view(Arena::HRAM_REGION))
+, __dma(&__oram, &__scheduler)
+, __hdma(&__vram) {
+    __cartridge.map_to_memory(__bus);
+    __vram.map_to_memory(__bus);
+    __wram.map_to_memory(__bus);
+    __oram.map_to_memory(__bus);
+    __joypad.map_to_memory(__bus);
+    __timer.map_to_memory(__bus);
+    __int_ctrl.map_to_memory(__bus);
+    __hram.map_to_memory(__bus);
+    __dma.map_to_memory(__bus);
+    __hdma.map_to_memory(__bus);
+}
+
+template <GBModeFlag _Mode>
+void
+Machine<_Mode>::save_state(dbuffer_t& image) const {
+    static_assert(std::is_trivially_copyable_v<State>, "save-state must be a plain copy");
+
+    State state;
+
+    std::memset(static_cast<void*>(&state), 0, sizeof(State));
+    state.magic = STATE_MAGIC;
+    state.version = STATE_VERSION;
+    state.mode = _Mode;
+    state.arena_size = __arena.size();
+    state.scheduler = __scheduler.get_state();
+    state.int_ctrl = __int_ctrl.get_state();
+    state.cpu = __cpu.get_state();
+    state.joypad = __joypad.get_state();
+    state.timer = __timer.get_state();
+    state.wram = __wram.get_state();
+    state.vram = __vram.get_state();
+    state.dma = __dma.get_state();
+    state.hdma = __hdma.get_state();
+
+    if (image.size() != get_state_size())
+        image = dbuffer_t(get_state_size(), image.get_memory_resource(), image.get_alignment());
+    std::memcpy(image.get_data_addr(), &state, sizeof(State));
+    std::memset(image.get_data_addr() + sizeof(State), 0, STATE_ARENA_OFFSET - sizeof(State));
+    std::memcpy(image.get_data_addr() + STATE_ARENA_OFFSET, __arena.get_data_addr(), __arena.size());
+}
+
+/**
+ * @details Scheduler and DMA are restored before the memory: remapping of banks synchronizes
+ *          active DMA, which copies bytes from the restored memory up to the restored time.
+ */
+template <GBModeFlag _Mode>
+bool
+Machine<_Mode>::load_state(const dbuffer_t& image) {
+    State state;
+
+    if (image.size() != get_state_size())
+        return false;
+    std::memcpy(&state, image.get_data_addr(), sizeof(State));
+    if (state.magic != STATE_MAGIC || state.version != STATE_VERSION || state.mode != _Mode
+     || state.arena_size != __arena.size())
+        return false;
+
+    __scheduler.set_state(state.scheduler);
+    __dma.set_state(state.dma);
+    std::memcpy(__arena.get_data_addr(), image.get_data_addr() + STATE_ARENA_OFFSET, __arena.size());
+
+    __int_ctrl.set_state(state.int_ctrl);
+    __cpu.set_state(state.cpu);
+    __joypad.set_state(state.joypad);
+    __timer.set_state(state.timer);
+    __wram.set_state(state.wram);
+    __vram.set_state(state.vram);
+    __hdma.set_state(state.hdma);
+
+    __oram.rebuild_line_index();
+    __cpu.invalidate_blocks();
+    __wram.mark_dirty_pages();
+    __vram.mark_dirty_pages();
+    __oram.mark_dirty_pages();
+    __cartridge.mark_dirty_pages();
+    return true;
+}
+
+template <GBModeFlag _Mode>
+clk_cycle_t
+Machine<_Mode>::fast_forward_halt(clk_cycle_t limit) {
+    const clk_cycle_t halt_time = __scheduler.get_time();
+
+    while (!__int_ctrl.has_pending_interrupt() && __scheduler.get_time() < limit)
+        __scheduler.advance_to(std::min(__scheduler.get_next_deadline(), limit));
+    return __scheduler.get_time() - halt_time;
+}
+
+template <GBModeFlag _Mode>
+void
+Machine<_Mode>::run(clk_cycle_t limit) {
+    while (__scheduler.get_time() < limit) {
+        if (__cpu.is_locked())
+            return __scheduler.advance_to(limit);
+        if (__cpu.is_halted() && !__int_ctrl.has_pending_interrupt()) {
+            fast_forward_halt(limit);
+        } else {
+            __cpu.execute_block(__scheduler, limit);
+            __scheduler.advance(__hdma.take_stall_cycles());
+        }
+    }
+}
+
+/**
+ * @brief Runtime dispatch wrapper, which chooses machine instantiation when ROM is loaded
+ *
+ * @details Dispatch happens once per visit, so the code inside a visitor works with
+ *          a concrete Machine<MODE> without any runtime mode checks.
+ */
+class AnyMachine {
+ public:
+    using DMGMachine = Machine<DMG_MODE>;
+    using CGBMachine = Machine<CGB_MODE>;
+
+ protected:
+    std::variant<std::monostate, DMGMachine, CGBMachine>    __machine;
+
+ public:
+    AnyMachine() : __machine() {}
+
+    AnyMachine(const AnyMachine&) = delete;
+    AnyMachine& operator=(const AnyMachine&) = delete;
+
+    /**
+     * @brief Choose hardware mode for a ROM image
+     * @details Games which use CGB functions run in CGB_MODE, all others in DMG_MODE.
+     */
+    static GBModeFlag select_mode(const dbuffer_t& rom);
+
+    /**
+     * @brief Create machine for a ROM image (previous machine is destroyed)
+     * @param[in] rom cartridge ROM image
+     * @param[in] resource memory resource for the machine arena
+     * @return mode of created machine
+     */
+    GBModeFlag load_rom(dbuffer_t rom, std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+    /** Returns true if any machine is created */
+    inline bool is_loaded() const;
+
+    /** Get mode of current machine */
+    inline GBModeFlag get_mode() const;
+
+    /**
+     * @brief Call visitor with current machine (does nothing if there is no machine)
+     * @param[in] visitor generic callable, which accepts Machine<MODE>&
+     */
+    template <typename _Visitor>
+    inline void visit(_Visitor&& visitor);
+};
+
+inline bool
+AnyMachine::is_loaded() const {
+    return !std::holds_alternative<std::monostate>(__machine);
+}
+
+inline GBModeFlag
+AnyMachine::get_mode() const {
+    return std::holds_alternative<CGBMachine>(__machine) ? CGB_MODE : DMG_MODE;
+}
+
+template <typename _Visitor>
+inline void
+AnyMachine::visit(_Visitor&& visitor) {
+    if (auto* dmg_machine = std::get_if<DMGMachine>(&__machine))
+        visitor(*dmg_machine);
+    else if (auto* cgb_machine = std::get_if<CGBMachine>(&__machine))
+        visitor(*cgb_machine);
+}
+
+}  // namespace GB::core
+
+#endif  // CORE_GB_MACHINE_H_
@@ -0,0 +1,140 @@
+/**
+ * @file GB_rewind.h
+ * @brief Describes rewind buffer of compressed save-states
+ */
+
+#ifndef CORE_GB_REWIND_H_
+# define CORE_GB_REWIND_H_
+
+# include <cstddef>
+# include <vector>
+
+# include "GB_config.h"
+
+# include "common/GB_dbuffer.h"
+
+# include "core/GB_machine.h"
+
+namespace GB::core {
+
+/**
+ * @brief Ring of save-state images, which are compressed within a fixed memory budget
+ *
+ * @details States are split into groups: the first state of a group is a keyframe, which is
+ *          encoded as is, and the next keyframe_interval - 1 states are XOR-deltas against it
+ *          (see delta_codec_t), which are mostly zeros between frames. Encoded states are
+ *          placed one after another in a ring of budget bytes, and the oldest group is dropped
+ *          when the ring is full, so no state is left without its keyframe.
+ *
+ *          Keyframe of the newest group is kept decoded, so stepping back costs a copy of it
+ *          and decoding of one delta. Keyframe of the previous group is decoded only when
+ *          the step crosses the group boundary.
+ *
+ *          Caller decides how often states are pushed (e.g. once per frame or every N frames).
+ *          All images must have the same size, and an image of another size (e.g. of
+ *          another machine) clears the buffer.
+ */
+class Rewind {
+ public:
+    constexpr static unsigned DEFAULT_KEYFRAME_INTERVAL = 60;
+
+ protected:
+    /** Encoded state in the ring */
+    struct Entry {
+        size_t  offset;
+        size_t  size;
+        bool    is_keyframe;
+    };
+
+    constexpr static size_t INIT_ENTRIES_NUM = 256;
+
+    dbuffer_t           __ring;
+    std::vector<Entry>  __entries;          ///< circular queue from the oldest state
+    size_t              __first;
+    size_t              __count;
+    size_t              __used;             ///< encoded bytes in the ring
+    unsigned            __keyframe_interval;
+    unsigned            __group_size;       ///< states in the newest group
+    dbuffer_t           __keyframe;         ///< decoded keyframe of the newest group
+    dbuffer_t           __encoded;          ///< encoding buffer of the worst case size
+    dbuffer_t           __image;            ///< save-state image of a machine
+
+ protected:
+    inline Entry& __entry(size_t idx) { return __entries[(__first + idx) % __entries.size()]; }
+    inline const Entry& __entry(size_t idx) const { return __entries[(__first + idx) % __entries.size()]; }
+
+    /** Encode the image into __encoded, keyframe is encoded without reference */
+    size_t __encode(const dbuffer_t& image, bool is_keyframe);
+
+    /** Find free space of size bytes after the newest state */
+    bool __allocate(size_t size, size_t& offset) const;
+
+    void __append(const Entry& entry);
+    void __drop_oldest_group();
+
+    /** Decode keyframe of the newest group, after its last state is popped */
+    bool __restore_keyframe();
+
+ public:
+    /**
+     * @brief Create rewind buffer
+     * @param[in] budget size of the ring of encoded states (in bytes)
+     * @param[in] keyframe_interval states in a group (keyframe and its deltas)
+     */
+    explicit
+    Rewind(size_t budget, unsigned keyframe_interval = DEFAULT_KEYFRAME_INTERVAL);
+
+    Rewind(const Rewind&) = delete;
+    Rewind& operator=(const Rewind&) = delete;
+
+    /**
+     * @brief Save the image as the newest state
+     * @return false if the image doesn't fit into the budget even as the only keyframe
+     *         (it isn't saved, and no state is dropped)
+     * @details The oldest groups are dropped to free the space.
+     */
+    bool push(const dbuffer_t& image);
+
+    /**
+     * @brief Restore the newest state into the image and drop it
+     * @return false if there is no saved state
+     * @details Owning image is reallocated if its size differs.
+     */
+    bool pop(dbuffer_t& image);
+
+    /** Drop all states */
+    void clear();
+
+    inline size_t size() const { return __count; }
+    inline bool empty() const { return __count == 0; }
+    inline size_t get_budget() const { return __ring.size(); }
+    inline size_t get_used_bytes() const { return __used; }
+
+    /** Save state of the machine as the newest state (see push()) */
+    template <GBModeFlag _Mode>
+    inline bool push(const Machine<_Mode>& machine);
+
+    /**
+     * @brief Restore the machine to the newest state and drop it
+     * @return false if there is no saved state, or it's saved by another machine
+     */
+    template <GBModeFlag _Mode>
+    inline bool step_back(Machine<_Mode>& machine);
+};
+
+template <GBModeFlag _Mode>
+inline bool
+Rewind::push(const Machine<_Mode>& machine) {
+    machine.save_state(__image);
+    return push(__image);
+}
+
+template <GBModeFlag _Mode>
+inline bool
+Rewind::step_back(Machine<_Mode>& machine) {
+    return pop(__image) && machine.load_state(__image);
+}
+
+}  // namespace GB::core
+
+#endif  // CORE_GB_REWIND_H_
@@ -0,0 +1,137 @@
+/**
+ * @file GB_run_ahead.h
+ * @brief Describes run-ahead, which hides input latency of games
+ */
+
+#ifndef CORE_GB_RUN_AHEAD_H_
+# define CORE_GB_RUN_AHEAD_H_
+
+# include <memory_resource>
+
+# include <cstddef>
+
+# include "GB_config.h"
+
+# include "common/GB_dbuffer.h"
+# include "common/GB_types.h"
+
+# include "core/GB_machine.h"
+
+namespace GB::core {
+
+/**
+ * @brief Run-ahead of a machine, which presents the frame emulated some frames ahead
+ *
+ * @details Games react to input one or more frames later, so the presented machine is
+ *          a speculative clone, which runs frames_ahead frames ahead of the machine with
+ *          the current input. Clone is a second machine with the same ROM, which is restored
+ *          from a save-state of the machine, so the speculation never touches the machine.
+ *
+ *          While the input doesn't change, the speculation stays valid, and the clone runs
+ *          one frame per frame as the machine does. Changed input rolls the clone back to
+ *          the machine, and the clone runs all frames ahead again.
+ */
+template <GBModeFlag _Mode>
+class RunAhead {
+ public:
+    using Machine = core::Machine<_Mode>;
+
+ protected:
+    Machine&    __machine;
+    Machine     __ahead;            ///< speculative clone of the machine
+    dbuffer_t   __image;
+    unsigned    __frames_ahead;
+    byte_t      __ahead_key_set;    ///< input of the speculation
+    bool        __is_ahead_valid;
+    size_t      __rollbacks_num;
+
+ protected:
+    /** Restore the clone from the machine, and run it ahead with the current input */
+    inline void __rollback();
+
+ public:
+    /**
+     * @brief Create run-ahead of the machine
+     * @param[in] machine machine, which must outlive the run-ahead
+     * @param[in] frames_ahead frames, which the presented machine runs ahead (0 disables run-ahead)
+     * @param[in] resource memory resource for the clone arena
+     */
+    RunAhead(Machine& machine, unsigned frames_ahead
+           , std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+    RunAhead(const RunAhead&) = delete;
+    RunAhead& operator=(const RunAhead&) = delete;
+
+    /**
+     * @brief Run a frame of the machine with the input
+     * @param[in] key_set pressed keys (see JoyPad::set_pressed_key_set())
+     * @return machine, which must be presented
+     */
+    inline Machine& run_frame(byte_t key_set);
+
+    /** Get machine, which must be presented (it's read only by the presentation) */
+    inline Machine& get_presented() { return (__frames_ahead != 0) ? __ahead : __machine; }
+
+    inline unsigned get_frames_ahead() const { return __frames_ahead; }
+    inline void set_frames_ahead(unsigned frames_ahead);
+
+    /** Get number of rollbacks, which are caused by input changes */
+    inline size_t get_rollbacks_num() const { return __rollbacks_num; }
+
+    /** Drop the speculation, must be called after the machine is changed not by run_frame() (e.g. state load) */
+    inline void invalidate() { __is_ahead_valid = false; }
+};
+
+template <GBModeFlag _Mode>
+RunAhead<_Mode>::RunAhead(Machine& machine, unsigned frames_ahead, std::pmr::memory_resource* resource)
+: __machine(machine)
+, __ahead(dbuffer_t(machine.get_cartridge().get_rom_buffer_ref()), resource)
+, __image(machine.get_state_size())
+, __frames_ahead(frames_ahead)
+, __ahead_key_set(0)
+, __is_ahead_valid(false)
+, __rollbacks_num(0) {
+}
+
+template <GBModeFlag _Mode>
+inline void
+RunAhead<_Mode>::set_frames_ahead(unsigned frames_ahead) {
+    __frames_ahead = frames_ahead;
+    invalidate();
+}
+
+template <GBModeFlag _Mode>
+inline void
+RunAhead<_Mode>::__rollback() {
+    __machine.save_state(__image);
+    __ahead.load_state(__image);
+    for (unsigned frame = 0; frame < __frames_ahead; ++frame)
+        __ahead.run_frame();
+
+    __ahead_key_set = __machine.get_joypad().get_pressed_key_set();
+    __is_ahead_valid = true;
+    ++__rollbacks_num;
+}
+
+/**
+ * @details Clone, which has run frames_ahead frames with the same input, is the machine of
+ *          frames_ahead frames later, so it runs the next frame without rollback.
+ */
+template <GBModeFlag _Mode>
+inline typename RunAhead<_Mode>::Machine&
+RunAhead<_Mode>::run_frame(byte_t key_set) {
+    __machine.get_joypad().set_pressed_key_set(key_set);
+    __machine.run_frame();
+    if (__frames_ahead == 0)
+        return __machine;
+
+    if (__is_ahead_valid && key_set == __ahead_key_set)
+        __ahead.run_frame();
+    else
+        __rollback();
+    return __ahead;
+}
+
+}  // namespace GB::core
+
+#endif  // CORE_GB_RUN_AHEAD_H_
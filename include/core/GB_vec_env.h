@@ -0,0 +1,256 @@
+/**
+ * @file GB_vec_env.h
+ * @brief Describes vectorized environment of many machines for reinforcement learning
+ */
+
+#ifndef CORE_GB_VEC_ENV_H_
+# define CORE_GB_VEC_ENV_H_
+
+# include <memory_resource>
+
+# include <algorithm>
+# include <cstddef>
+# include <memory>
+# include <utility>
+# include <vector>
+
+# include "GB_config.h"
+
+# include "common/GB_dbuffer.h"
+# include "common/GB_memory_resource.h"
+# include "common/GB_types.h"
+# include "common/GB_worker_pool.h"
+
+# include "core/GB_machine.h"
+
+namespace GB::core {
+
+/**
+ * @brief Environment of many machines with the same ROM, which are stepped frame by frame at once
+ *
+ * @details Action of an instance is the set of its pressed keys (see JoyPad::set_pressed_key_set()),
+ *          so an action array has a byte per instance. step() runs frames_per_step frames of every
+ *          instance on a worker pool: instance n is always stepped by worker n % workers_num,
+ *          and workers are pinned to CPUs, so an instance stays in the cache of one core.
+ *
+ *          Observation of an instance is a concatenation of the bus ranges of the config
+ *          (e.g. WRAM of the game state), and observations of all instances form a contiguous
+ *          tensor [instances_num][observation_size]. Reward of an instance is a sum of hooks:
+ *          a hook is a byte (e.g. score or lives in WRAM), which is rewarded by scale per unit
+ *          it has changed during the step.
+ *
+ *          Arenas of all machines, observation, reward and reset buffers are allocated by
+ *          the constructor from a pool, which packs them into huge pages (or into memory of
+ *          the upstream resource), so step() and reset() allocate nothing.
+ */
+template <GBModeFlag _Mode>
+class VecEnv {
+ public:
+    using Machine = core::Machine<_Mode>;
+
+    /** Range of the bus [vaddr:vaddr + len), which is copied to the observation */
+    struct Range {
+        word_t  vaddr;
+        size_t  len;
+    };
+
+    /** Byte of the bus, which change is rewarded */
+    struct RewardHook {
+        word_t  vaddr;
+        float   scale;
+    };
+
+    struct Config {
+        unsigned                    instances_num = 1;
+        unsigned                    frames_per_step = 1;
+        unsigned                    workers_num = 0;    ///< 0 is one worker per CPU (up to instances_num)
+        bool                        is_pinned = true;   ///< bind workers to CPUs
+        std::vector<Range>          observation;
+        std::vector<RewardHook>     rewards;
+    };
+
+ protected:
+    Config                                  __config;
+    hugepage_resource_t                     __hugepages;
+    std::pmr::monotonic_buffer_resource     __pool;         ///< arenas of all machines and env buffers
+    std::vector<std::unique_ptr<Machine>>   __machines;
+    dbuffer_t                               __initial;      ///< save-state image of a new machine
+    size_t                                  __observation_size;
+    dbuffer_t                               __observations;
+    std::pmr::vector<float>                 __rewards;
+    std::pmr::vector<byte_t>                __hook_values;  ///< hook bytes before the step
+    const byte_t*                           __actions;      ///< actions of the current step
+    worker_pool_t                           __workers;
+
+ protected:
+    inline void __observe(unsigned instance);
+    inline void __step(unsigned instance);
+    inline void __reset(unsigned instance);
+
+    /** Call method for every instance of the worker */
+    template <void (VecEnv::*_Method)(unsigned)>
+    static void __job(void* context, unsigned worker_idx);
+
+    static unsigned __workers_num(const Config& config);
+    static size_t __observation_size_of(const Config& config);
+
+ public:
+    /**
+     * @brief Create instances_num machines of the ROM, and observe their initial state
+     * @param[in] rom ROM, which is copied to every machine
+     * @param[in] config environment config
+     * @param[in] upstream upstream of the pool, which must outlive the environment
+     *            (nullptr is huge pages)
+     */
+    VecEnv(const dbuffer_t& rom, Config config, std::pmr::memory_resource* upstream = nullptr);
+
+    VecEnv(const VecEnv&) = delete;
+    VecEnv& operator=(const VecEnv&) = delete;
+
+    /**
+     * @brief Step every instance with its action
+     * @param[in] actions instances_num key sets
+     */
+    void step(const byte_t* actions);
+
+    /** Restore every instance to its initial state */
+    void reset();
+
+    /** Restore the instance to its initial state (e.g. at the end of its episode) */
+    void reset(unsigned instance);
+
+    inline size_t size() const { return __machines.size(); }
+    inline size_t get_observation_size() const { return __observation_size; }
+    inline size_t get_workers_num() const { return __workers.size(); }
+    inline unsigned get_pinned_workers_num() const { return __workers.get_pinned_num(); }
+
+    /** Get observation tensor [size()][get_observation_size()], which is valid until the next step */
+    inline const byte_t* get_observations() const { return __observations.get_data_addr(); }
+    inline const byte_t* get_observation(unsigned instance) const {
+        return __observations.get_data_addr() + instance * __observation_size;
+    }
+
+    /** Get rewards of the last step (zeros after reset) */
+    inline const float* get_rewards() const { return __rewards.data(); }
+
+    inline Machine& get_machine(unsigned instance) { return *__machines[instance]; }
+};
+
+template <GBModeFlag _Mode>
+unsigned
+VecEnv<_Mode>::__workers_num(const Config& config) {
+    unsigned workers_num = config.workers_num;
+
+    if (workers_num == 0)
+        workers_num = worker_pool_t::get_cpus_num();
+    return std::max(std::min(workers_num, config.instances_num), 1u);
+}
+
+template <GBModeFlag _Mode>
+size_t
+VecEnv<_Mode>::__observation_size_of(const Config& config) {
+    size_t observation_size = 0;
+
+    for (const Range& range : config.observation)
+        observation_size += range.len;
+    return observation_size;
+}
+
+template <GBModeFlag _Mode>
+VecEnv<_Mode>::VecEnv(const dbuffer_t& rom, Config config, std::pmr::memory_resource* upstream)
+: __config(std::move(config))
+, __hugepages()
+, __pool(hugepage_resource_t::HUGE_PAGE_SIZE, (upstream != nullptr) ? upstream : &__hugepages)
+, __machines()
+, __initial(0, &__pool)
+, __observation_size(__observation_size_of(__config))
+, __observations(__config.instances_num * __observation_size, &__pool, dbuffer_t::CACHE_LINE_ALIGNMENT)
+, __rewards(__config.instances_num, 0.0f, &__pool)
+, __hook_values(__config.instances_num * __config.rewards.size(), 0x0, &__pool)
+, __actions(nullptr)
+, __workers(__workers_num(__config), __config.is_pinned) {
+    __machines.reserve(__config.instances_num);
+    for (unsigned instance = 0; instance < __config.instances_num; ++instance)
+        __machines.emplace_back(std::make_unique<Machine>(dbuffer_t(rom), &__pool));
+
+    // image is reallocated from its own memory resource (see Machine::save_state())
+    if (!__machines.empty())
+        __machines.front()->save_state(__initial);
+    for (unsigned instance = 0; instance < size(); ++instance)
+        __observe(instance);
+}
+
+template <GBModeFlag _Mode>
+inline void
+VecEnv<_Mode>::__observe(unsigned instance) {
+    const memory::BusInterface& bus = __machines[instance]->get_bus();
+    byte_t* observation = __observations.get_data_addr() + instance * __observation_size;
+    byte_t* hook_values = __hook_values.data() + instance * __config.rewards.size();
+
+    for (const Range& range : __config.observation) {
+        bus.read_block(range.vaddr, observation, range.len);
+        observation += range.len;
+    }
+    for (const RewardHook& hook : __config.rewards)
+        *hook_values++ = bus.read_unlocked(hook.vaddr);
+}
+
+template <GBModeFlag _Mode>
+inline void
+VecEnv<_Mode>::__step(unsigned instance) {
+    Machine& machine = *__machines[instance];
+    const memory::BusInterface& bus = machine.get_bus();
+    const byte_t* hook_values = __hook_values.data() + instance * __config.rewards.size();
+    float reward = 0.0f;
+
+    machine.get_joypad().set_pressed_key_set(__actions[instance]);
+    for (unsigned frame = 0; frame < __config.frames_per_step; ++frame)
+        machine.run_frame();
+
+    for (const RewardHook& hook : __config.rewards)
+        reward += hook.scale * float(int(bus.read_unlocked(hook.vaddr)) - int(*hook_values++));
+    __rewards[instance] = reward;
+    __observe(instance);
+}
+
+template <GBModeFlag _Mode>
+inline void
+VecEnv<_Mode>::__reset(unsigned instance) {
+    __machines[instance]->load_state(__initial);
+    __rewards[instance] = 0.0f;
+    __observe(instance);
+}
+
+template <GBModeFlag _Mode>
+template <void (VecEnv<_Mode>::*_Method)(unsigned)>
+void
+VecEnv<_Mode>::__job(void* context, unsigned worker_idx) {
+    VecEnv& env = *static_cast<VecEnv*>(context);
+
+    for (unsigned instance = worker_idx; instance < env.size(); instance += env.get_workers_num())
+        (env.*_Method)(instance);
+}
+
+template <GBModeFlag _Mode>
+void
+VecEnv<_Mode>::step(const byte_t* actions) {
+    __actions = actions;
+    __workers.run(&VecEnv::__job<&VecEnv::__step>, this);
+    __actions = nullptr;
+}
+
+template <GBModeFlag _Mode>
+void
+VecEnv<_Mode>::reset() {
+    __workers.run(&VecEnv::__job<&VecEnv::__reset>, this);
+}
+
+template <GBModeFlag _Mode>
+void
+VecEnv<_Mode>::reset(unsigned instance) {
+    __reset(instance);
+}
+
+}  // namespace GB::core
+
+#endif  // CORE_GB_VEC_ENV_H_
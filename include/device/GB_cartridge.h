@@ -0,0 +1,153 @@
+/**
+ * @file GB_cartridge.h
+ * @brief Describes cartridge device
+ */
+
+#ifndef DEVICE_GB_CARTRIDGE_H_
+# define DEVICE_GB_CARTRIDGE_H_
+
+# include <utility>
+
+# include "GB_config.h"
+
+# include "common/GB_types.h"
+
+# include "memory/GB_bus.h"
+# include "memory/GB_dirty_pages.h"
+# include "memory/GB_vaddr.h"
+
+namespace GB::device {
+
+/**
+ * @brief ROM only cartridge (no memory bank controller), optionally with RAM
+ *
+ * @details ROM0 and ROMX are mapped directly to the host memory for reading,
+ *          writes to the ROM area are ignored. Cartridge RAM is mapped directly
+ *          to the host memory, when the cartridge has it, except clean pages (see DirtyPages),
+ *          which are mapped for reading only until the first write.
+ */
+class Cartridge {
+ public:
+    /** Cartridge header fields virtual addresses */
+    enum HeaderVAddr : word_t {
+        TITLE_BASE_VADDR    = 0x0134,
+        TITLE_LAST_VADDR    = 0x0143,
+        CGB_FLAG_VADDR      = 0x0143,
+        CART_TYPE_VADDR     = 0x0147,
+        ROM_SIZE_VADDR      = 0x0148,
+        RAM_SIZE_VADDR      = 0x0149,
+    };
+
+    /** Values of CGB flag at the header */
+    enum CGBFlag : byte_t {
+        CGB_SUPPORTED_FLAG  = 0x80,     ///< Game supports CGB functions, but works on DMG too
+        CGB_ONLY_FLAG       = 0xC0,     ///< Game works on CGB only
+    };
+
+    constexpr static unsigned ROM_BANK_SIZE = 16_KBytes;
+    constexpr static unsigned MIN_ROM_SIZE = ROM_BANK_SIZE * 2;
+    constexpr static byte_t ROM_FILL_VALUE = 0xFF;
+
+    /** Cartridge RAM size, which is addressable without memory bank controller */
+    constexpr static unsigned SRAM_WINDOW_SIZE = 8_KBytes;
+
+    /** Only the window of cartridge RAM is writable */
+    using DirtyPages = memory::DirtyPages<SRAM_WINDOW_SIZE>;
+
+ protected:
+    dbuffer_t               __rom;
+    dbuffer_t               __sram;
+    memory::BusInterface*   __bus_link;
+    DirtyPages              __dirty_pages;
+
+    /** Get size of cartridge RAM, which is visible at the window */
+    inline unsigned __get_sram_window_size() const;
+
+    void __map_sram();
+
+ public:
+    /**
+     * @brief Create cartridge from ROM image
+     * @details ROM which is smaller than two banks is padded with ROM_FILL_VALUE.
+     */
+    explicit
+    Cartridge(dbuffer_t rom = dbuffer_t());
+
+    /**
+     * @brief Create cartridge from ROM image with external RAM storage
+     * @param[in] rom ROM image
+     * @param[in] sram buffer (usually an arena view) of sram_size(rom) bytes
+     */
+    Cartridge(dbuffer_t rom, dbuffer_t sram);
+
+    /** Get cartridge RAM size from ROM header (0 if the ROM has no header) */
+    static unsigned sram_size(const dbuffer_t& rom);
+
+    /** Get CGB flag from cartridge header */
+    inline byte_t get_cgb_flag() const;
+
+    /** Returns true if game uses CGB functions */
+    inline bool is_cgb_game() const;
+
+    /** Get ROM buffer */
+    inline const dbuffer_t& get_rom_buffer_ref() const;
+
+    /** Get cartridge RAM buffer */
+    inline const dbuffer_t& get_sram_buffer_ref() const;
+
+    inline byte_t read_sram_phys_addr(word_t phys_addr) const;
+    inline void write_sram_phys_addr(word_t phys_addr, byte_t value);
+
+    /** Get pages of cartridge RAM window, which are written since the last clear_dirty_pages() */
+    inline const DirtyPages::PageSet& get_dirty_pages() const { return __dirty_pages.get(); }
+
+    /** Clear dirty pages, and map them for reading only, so the next write to each page is tracked */
+    void clear_dirty_pages();
+
+    /** Mark the whole cartridge RAM dirty (e.g. after arena load) */
+    void mark_dirty_pages();
+
+    /** Map ROM0, ROMX and cartridge RAM (if there is any) to the memory bus */
+    void map_to_memory(memory::BusInterface& mem_bus);
+};
+
+inline byte_t
+Cartridge::get_cgb_flag() const {
+    return __rom[CGB_FLAG_VADDR];
+}
+
+inline bool
+Cartridge::is_cgb_game() const {
+    return (get_cgb_flag() & CGB_SUPPORTED_FLAG) != 0;
+}
+
+inline const dbuffer_t&
+Cartridge::get_rom_buffer_ref() const {
+    return __rom;
+}
+
+inline const dbuffer_t&
+Cartridge::get_sram_buffer_ref() const {
+    return __sram;
+}
+
+inline unsigned
+Cartridge::__get_sram_window_size() const {
+    return (__sram.size() < SRAM_WINDOW_SIZE) ? __sram.size() : SRAM_WINDOW_SIZE;
+}
+
+inline byte_t
+Cartridge::read_sram_phys_addr(word_t phys_addr) const {
+    return __sram[phys_addr];
+}
+
+inline void
+Cartridge::write_sram_phys_addr(word_t phys_addr, byte_t value) {
+    __sram[phys_addr] = value;
+    if (__dirty_pages.mark(phys_addr) && __bus_link != nullptr)
+        __map_sram();
+}
+
+}  // namespace GB::device
+
+#endif  // DEVICE_GB_CARTRIDGE_H_
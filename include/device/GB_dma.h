@@ -0,0 +1,127 @@
+/**
+ * @file GB_dma.h
+ * @brief Describes OAM DMA controller
+ */
+
+#ifndef DEVICE_GB_DMA_H_
+# define DEVICE_GB_DMA_H_
+
+# include "GB_config.h"
+
+# include "common/GB_clock.h"
+# include "common/GB_scheduler.h"
+# include "common/GB_types.h"
+
+# include "device/GB_oram.h"
+
+# include "memory/GB_bus.h"
+# include "memory/GB_vaddr.h"
+
+namespace GB::device {
+
+/**
+ * @brief OAM DMA controller, which copies 160 bytes from XX00 to OAM in 160 M-cycles
+ *
+ * @details Transfer starts one M-cycle after DMA write and copies a byte per M-cycle.
+ *          While it's active, the bus of the source (external or video) and OAM are locked:
+ *          CPU reads the byte, which is being transferred, from the source bus and 0xFF from OAM,
+ *          and its writes are ignored, so only I/O registers and HRAM are accessible.
+ *
+ *          Transfer is synchronized lazily: transferred bytes are copied when OAM is observed
+ *          (see sync()), when the source is remapped, and at the end of the transfer.
+ *          If nothing observes OAM and the source is host memory (RAM, ROM), the transfer is
+ *          a single block copy at the end.
+ *
+ *          Controller registers its events at the scheduler, and is not copyable.
+ */
+class DMA {
+ public:
+    constexpr static unsigned TRANSFER_SIZE = ORAM_SIZE;
+    constexpr static clk_cycle_t STARTUP_CYCLES = 1_MCycles;
+    constexpr static clk_cycle_t BYTE_CYCLES = 1_MCycles;
+    constexpr static clk_cycle_t TRANSFER_CYCLES = TRANSFER_SIZE * BYTE_CYCLES;
+
+    /** Sources above [E000:FFFF] are read from [C000:DFFF] */
+    constexpr static byte_t ECHO_SOURCE_BASE = 0xE0;
+    constexpr static byte_t ECHO_SOURCE_SHIFT = 0x20;
+
+    /** Trivially copyable controller state (transfer events are saved with the scheduler) */
+    struct State {
+        byte_t          reg;
+        word_t          source;
+        word_t          next_source;
+        clk_cycle_t     start_time;
+        unsigned        copied;
+        bool            is_active;
+    };
+
+    /**
+     * @param[in] oram OAM, which receives transferred bytes
+     * @param[in] scheduler machine scheduler, which gives time and dispatches transfer events
+     */
+    DMA(ORAM* oram, devsync::Scheduler* scheduler);
+
+    DMA(const DMA&) = delete;
+    DMA& operator=(const DMA&) = delete;
+
+    inline byte_t get_DMA_reg() const { return __reg; }
+
+    /** Start transfer from (value << 8), active transfer continues until the new one starts */
+    void set_DMA_reg(byte_t value);
+
+    /** Returns true while the transfer is active (and the bus is locked) */
+    inline bool is_active() const { return __is_active; }
+
+    /** Copy bytes, which are transferred up to the current time (e.g. before OAM scan) */
+    void sync();
+
+    State get_state() const;
+
+    /**
+     * @brief Restore controller state, and lock the bus for the active transfer
+     * @details Bytes, which aren't copied yet, are copied lazily from the restored memory.
+     */
+    void set_state(const State& state);
+
+    /**
+     * @brief Map DMA register to the memory bus
+     * @details Source is read from the bus, which is locked during the transfer.
+     */
+    void map_to_memory(memory::BusInterface& mem_bus);
+
+ protected:
+    ORAM*                           __oram_link;
+    devsync::Scheduler*             __scheduler;
+    memory::BusInterface*           __bus_link;
+    devsync::Scheduler::event_id_t  __start_event;
+    devsync::Scheduler::event_id_t  __end_event;
+
+    byte_t          __reg;
+    word_t          __source;           ///< source of the active transfer
+    word_t          __next_source;      ///< source of the transfer, which is starting
+    clk_cycle_t     __start_time;
+    unsigned        __copied;           ///< bytes, which are copied to OAM
+    bool            __is_active;
+
+    static void __on_start(void* dma, clk_cycle_t deadline);
+    static void __on_end(void* dma, clk_cycle_t deadline);
+    static byte_t __read_locked(void* dma, word_t vaddr);
+    static void __sync_locked(void* dma);
+
+    /** Bytes, which are transferred up to the current time */
+    inline unsigned __get_transferred() const;
+
+    void __copy(unsigned end);
+    void __lock_bus();
+    void __unlock_bus();
+};
+
+inline unsigned
+DMA::__get_transferred() const {
+    const clk_cycle_t elapsed = __scheduler->get_time() - __start_time;
+    return (elapsed >= TRANSFER_CYCLES) ? TRANSFER_SIZE : unsigned(elapsed / BYTE_CYCLES);
+}
+
+}  // namespace GB::device
+
+#endif  // DEVICE_GB_DMA_H_
@@ -0,0 +1,184 @@
+/**
+ * @file GB_hdma.h
+ * @brief Describes CGB VRAM DMA controller (HDMA and GDMA)
+ */
+
+#ifndef DEVICE_GB_HDMA_H_
+# define DEVICE_GB_HDMA_H_
+
+# include <cstring>
+
+# include "GB_config.h"
+
+# include "common/GB_clock.h"
+# include "common/GB_macro.h"
+# include "common/GB_types.h"
+
+# include "device/GB_vram.h"
+
+# include "memory/GB_bus.h"
+# include "memory/GB_vaddr.h"
+
+namespace GB::device {
+
+/**
+ * @brief CGB VRAM DMA controller, specialized for a hardware mode at compile time
+ *
+ * @details Controller copies blocks of 16 bytes from ROM, cartridge RAM or WRAM to the
+ *          currently selected VRAM bank. General purpose DMA (GDMA) copies all blocks at once
+ *          on HDMA5 write, HBlank DMA (HDMA) copies a block on every HBlank (see on_hblank()).
+ *          Blocks are copied as spans: source is read from the bus by pages, and written to
+ *          VRAM by VRAM::write_block(), so there is no per-byte dispatch.
+ *
+ *          CPU is halted while a block is copied, so the controller accumulates these cycles
+ *          for the CPU (see take_stall_cycles()).
+ *
+ *          Modes without CGB banking have no controller, and its registers aren't mapped.
+ */
+template <GBModeFlag _Mode>
+class HDMA {
+ public:
+    constexpr static GBModeFlag MODE = _Mode;
+    constexpr static bool CGB_BANKS = has_cgb_banks(_Mode);
+
+    constexpr static unsigned BLOCK_SIZE = 16;
+    constexpr static unsigned MAX_BLOCKS_NUM = 0x80;
+    constexpr static clk_cycle_t BLOCK_CYCLES = 8_MCycles;     ///< CPU stall per block (single speed)
+
+    constexpr static word_t SOURCE_MASK = 0xFFF0;
+    constexpr static word_t DEST_MASK = 0x1FF0;                  ///< destination is VRAM inner address
+
+    /** HDMA5 bits */
+    constexpr static byte_t HBLANK_MODE_BIT = 7;
+    constexpr static byte_t LENGTH_MASK = 0x7F;
+
+    /** Trivially copyable controller state */
+    struct State {
+        word_t          source;
+        word_t          dest;
+        byte_t          length;
+        bool            is_active;
+        clk_cycle_t     stall_cycles;
+    };
+
+    /**
+     * @param[in] vram VRAM, which receives transferred blocks
+     */
+    explicit
+    HDMA(VRAM<_Mode>* vram);
+
+    HDMA(const HDMA&) = delete;
+    HDMA& operator=(const HDMA&) = delete;
+
+    /** HDMA1-HDMA4 are write only */
+    inline void set_HDMA1_reg(byte_t value);
+    inline void set_HDMA2_reg(byte_t value);
+    inline void set_HDMA3_reg(byte_t value);
+    inline void set_HDMA4_reg(byte_t value);
+
+    /**
+     * @brief Return HDMA5 register value
+     * @details Bit 7 is reset while HBlank DMA is active, bits 0-6 are remaining blocks minus one.
+     *          Register is 0xFF after the transfer is complete.
+     */
+    inline byte_t get_HDMA5_reg() const;
+
+    /**
+     * @brief Start GDMA (bit 7 is reset) or HDMA (bit 7 is set) of (value & 0x7F) + 1 blocks
+     * @details Write with bit 7 reset, while HDMA is active, stops HDMA instead.
+     */
+    void set_HDMA5_reg(byte_t value);
+
+    /** Returns true while HBlank DMA is active */
+    inline bool is_active() const { return __is_active; }
+
+    /** Copy the next block of active HBlank DMA, PPU calls it at the start of every HBlank */
+    void on_hblank();
+
+    /** Get CPU stall cycles of the copied blocks, which aren't taken yet, and reset them */
+    inline clk_cycle_t take_stall_cycles();
+
+    inline State get_state() const;
+    inline void set_state(const State& state);
+
+    /** Map HDMA registers to the memory bus (only in modes with CGB banking) */
+    void map_to_memory(memory::BusInterface& mem_bus);
+
+ protected:
+    VRAM<_Mode>*            __vram_link;
+    memory::BusInterface*   __bus_link;
+
+    word_t          __source;
+    word_t          __dest;
+    byte_t          __length;           ///< remaining blocks minus one
+    bool            __is_active;
+    clk_cycle_t     __stall_cycles;
+
+    void __copy_blocks(unsigned blocks_num);
+};
+
+template <GBModeFlag _Mode>
+inline void
+HDMA<_Mode>::set_HDMA1_reg(byte_t value) {
+    __source = word_t((value << 8) | (__source & 0xFF));
+}
+
+template <GBModeFlag _Mode>
+inline void
+HDMA<_Mode>::set_HDMA2_reg(byte_t value) {
+    __source = word_t((__source & 0xFF00) | (value & SOURCE_MASK));
+}
+
+template <GBModeFlag _Mode>
+inline void
+HDMA<_Mode>::set_HDMA3_reg(byte_t value) {
+    __dest = word_t(((value << 8) & DEST_MASK) | (__dest & 0xFF));
+}
+
+template <GBModeFlag _Mode>
+inline void
+HDMA<_Mode>::set_HDMA4_reg(byte_t value) {
+    __dest = word_t((__dest & 0xFF00) | (value & DEST_MASK & 0xFF));
+}
+
+template <GBModeFlag _Mode>
+inline byte_t
+HDMA<_Mode>::get_HDMA5_reg() const {
+    return __is_active ? __length : byte_t(::bits_set(HBLANK_MODE_BIT) | __length);
+}
+
+template <GBModeFlag _Mode>
+inline typename HDMA<_Mode>::State
+HDMA<_Mode>::get_state() const {
+    State state;
+
+    std::memset(&state, 0, sizeof(State));
+    state.source = __source;
+    state.dest = __dest;
+    state.length = __length;
+    state.is_active = __is_active;
+    state.stall_cycles = __stall_cycles;
+    return state;
+}
+
+template <GBModeFlag _Mode>
+inline void
+HDMA<_Mode>::set_state(const State& state) {
+    __source = state.source;
+    __dest = state.dest;
+    __length = state.length;
+    __is_active = state.is_active;
+    __stall_cycles = state.stall_cycles;
+}
+
+template <GBModeFlag _Mode>
+inline clk_cycle_t
+HDMA<_Mode>::take_stall_cycles() {
+    const clk_cycle_t stall_cycles = __stall_cycles;
+    __stall_cycles = 0;
+    return stall_cycles;
+}
+
+}  // namespace GB::device
+
+#endif  // DEVICE_GB_HDMA_H_
@@ -0,0 +1,84 @@
+/**
+ * @file GB_hram.h
+ * @brief Describes high RAM device
+ */
+
+#ifndef DEVICE_GB_HRAM_H_
+# define DEVICE_GB_HRAM_H_
+
+# include <utility>
+
+# include "GB_config.h"
+
+# include "common/GB_types.h"
+
+# include "memory/GB_bus.h"
+# include "memory/GB_vaddr.h"
+
+namespace GB::device {
+
+/**
+ * @brief High RAM [FF80:FFFE], which stays accessible by CPU during OAM DMA
+ */
+class HRAM {
+ public:
+
+    HRAM() : __memory(HRAM_SIZE), __bus_link(nullptr) {}
+
+    /** Create HRAM with external storage (usually an arena view) of HRAM_SIZE bytes */
+    explicit
+    HRAM(dbuffer_t memory) : __memory(std::move(memory)), __bus_link(nullptr) {}
+
+    /** Copies are not mapped to any bus */
+    HRAM(const HRAM& other) : __memory(other.__memory), __bus_link(nullptr) {}
+    HRAM(HRAM&& other) : __memory(std::move(other.__memory)), __bus_link(nullptr) {}
+    ~HRAM() = default;
+
+    /** Assigned device keeps own bus mapping */
+    inline HRAM& operator=(const HRAM& other);
+    inline HRAM& operator=(HRAM&& other);
+
+    inline byte_t read_phys_addr(word_t phys_addr) const;
+    inline void write_phys_addr(word_t phys_addr, byte_t value);
+
+    /** Map HRAM to the memory bus (directly to the host memory) */
+    void map_to_memory(memory::BusInterface& mem_bus);
+
+ protected:
+    dbuffer_t               __memory;
+    memory::BusInterface*   __bus_link;
+};
+
+inline HRAM&
+HRAM::operator=(const HRAM& other) {
+    if (this != &other) {
+        __memory = other.__memory;
+        if (__bus_link != nullptr)
+            map_to_memory(*__bus_link);
+    }
+    return *this;
+}
+
+inline HRAM&
+HRAM::operator=(HRAM&& other) {
+    if (this != &other) {
+        __memory = std::move(other.__memory);
+        if (__bus_link != nullptr)
+            map_to_memory(*__bus_link);
+    }
+    return *this;
+}
+
+inline byte_t
+HRAM::read_phys_addr(word_t phys_addr) const {
+    return __memory[phys_addr];
+}
+
+inline void
+HRAM::write_phys_addr(word_t phys_addr, byte_t value) {
+    __memory[phys_addr] = value;
+}
+
+}  // namespace GB::device
+
+#endif  // DEVICE_GB_HRAM_H_
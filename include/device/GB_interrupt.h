@@ -13,6 +13,7 @@
 # include "common/GB_types.h"
 # include "common/GB_macro.h"
 
+# include "memory/GB_bus.h"
 # include "memory/GB_vaddr.h"
 
 namespace GB::device {
@@ -122,6 +123,12 @@ class InterruptController {
      */
     InterruptIdx get_highest_priority_interrupt() const;
 
+    /**
+     * @brief Returns true if any enabled interrupt is requested
+     * @details It's the condition, which wakes up halted CPU, so it doesn't depend on IME.
+     */
+    bool has_pending_interrupt() const;
+
     /**  Set IE register */
     void set_IE_reg(byte_t value);
 
@@ -140,6 +147,15 @@ class InterruptController {
     /** Get IME register */
     bool get_IME_reg() const;
 
+    /** Controller state is its registers, which are trivially copyable */
+    using State = Registers;
+
+    inline const State& get_state() const { return __registers; }
+    inline void set_state(const State& state) { __registers = state; }
+
+    /** Map IF and IE registers to the memory bus */
+    void map_to_memory(memory::BusInterface& mem_bus);
+
 };
 
 inline void
@@ -158,6 +174,11 @@ InterruptController::get_highest_priority_interrupt() const {
     return InterruptIdx(bit_lsb(u16(interrupts_to_handle)));
 }
 
+inline bool
+InterruptController::has_pending_interrupt() const {
+    return (__registers.IF & __registers.IE & Registers::REG_MEANINGFUL_BIT_MASK) != 0;
+}
+
 inline void
 InterruptController::set_IE_reg(byte_t value) {
     __registers.IE = value | Registers::REG_RESERVED_BITS;
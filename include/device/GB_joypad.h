@@ -7,13 +7,25 @@
 #ifndef DEVICE_GB_JOYPAD_H_
 # define DEVICE_GB_JOYPAD_H_
 
+# include <cstring>
+
+# include "common/GB_clock.h"
 # include "common/GB_types.h"
 # include "common/GB_macro.h"
 
 # include "device/GB_interrupt.h"
 
+# include "memory/GB_bus.h"
+
 namespace GB::device {
 
+/**
+ * @brief Joypad, which raises interrupt when a key becomes pressed
+ *
+ * @details Joypad with a clock is synchronized lazily: it catches up on P1 access and on key
+ *          state changes, so the interrupt is raised at the time of the key press without
+ *          stepping every cycle. Joypad without a clock must be stepped manually (see step()).
+ */
 class JoyPad {
  public:
     enum KeyIdx: u16 {
@@ -38,12 +50,22 @@ class JoyPad {
 
     constexpr static unsigned P1_RESERVED_BITS = Reg8(~(::bits_set(P10, P11, P12, P13, P14, P15)));
 
+    /** Trivially copyable joypad state */
+    struct State {
+        byte_t          previous_step_key_set;
+        byte_t          pressed_key_set;
+        bool            p14;
+        bool            p15;
+        clk_cycle_t     last_sync;
+    };
+
  protected:
     InterruptController*    __interrupt_link;
     byte_t                  __previous_step_key_set;
     byte_t                  __pressed_key_set;
     bool                    __p14;
     bool                    __p15;
+    devsync::sync_stamp_t   __sync;
 
  protected:
     void __raise_interrupt();
@@ -51,20 +73,41 @@ class JoyPad {
  public:
 
     explicit
-    JoyPad(InterruptController* ic_link = nullptr)  : __interrupt_link(ic_link)
-                                        , __previous_step_key_set(0)
-                                        , __pressed_key_set(0)
-                                        , __p14(true)
-                                        , __p15(false) {}
+    JoyPad(InterruptController* ic_link = nullptr
+         , const clk_cycle_t* clock = nullptr)  : __interrupt_link(ic_link)
+                                                , __previous_step_key_set(0)
+                                                , __pressed_key_set(0)
+                                                , __p14(true)
+                                                , __p15(false)
+                                                , __sync(clock) {}
 
     void unpress_key(KeyIdx keyIdx);
     void press_key(KeyIdx keyIdx);
 
+    /** Get pressed keys (bit n is set for pressed key with KeyIdx n) */
+    inline byte_t get_pressed_key_set() const { return __pressed_key_set; }
+
+    /** Press and release keys at once (see get_pressed_key_set()), e.g. to replay an input */
+    inline void set_pressed_key_set(byte_t key_set);
+
     void set_P1_reg(byte_t value);
     byte_t get_P1_reg() const;
 
     void step();
 
+    inline State get_state() const;
+    inline void set_state(const State& state);
+
+    /**
+     * @brief Catch up for cycles elapsed since the last synchronization
+     * @details Key state is constant between synchronizations, so a single step
+     *          is equal to the stepping of every elapsed cycle.
+     */
+    void sync();
+
+    /** Map P1 register to the memory bus */
+    void map_to_memory(memory::BusInterface& mem_bus);
+
 };
 
 inline void
@@ -86,6 +129,34 @@ JoyPad::step() {
     __previous_step_key_set = __pressed_key_set;
 }
 
+inline JoyPad::State
+JoyPad::get_state() const {
+    State state;
+
+    std::memset(&state, 0, sizeof(State));
+    state.previous_step_key_set = __previous_step_key_set;
+    state.pressed_key_set = __pressed_key_set;
+    state.p14 = __p14;
+    state.p15 = __p15;
+    state.last_sync = __sync.get_last_sync();
+    return state;
+}
+
+inline void
+JoyPad::set_state(const State& state) {
+    __previous_step_key_set = state.previous_step_key_set;
+    __pressed_key_set = state.pressed_key_set;
+    __p14 = state.p14;
+    __p15 = state.p15;
+    __sync.set_last_sync(state.last_sync);
+}
+
+inline void
+JoyPad::sync() {
+    if (__sync.catch_up() != 0)
+        step();
+}
+
 inline void
 JoyPad::__raise_interrupt() {
     __interrupt_link->request_interrupt(GB::device::InterruptController::JOYPAD_INT);
@@ -93,12 +164,26 @@ JoyPad::__raise_interrupt() {
 
 inline void
 JoyPad::press_key(KeyIdx key_idx) {
+    sync();
     __pressed_key_set = ::bit_n_set(key_idx, __pressed_key_set);
+    if (__sync.has_clock())
+        step();
 }
 
 inline void
 JoyPad::unpress_key(KeyIdx key_idx) {
+    sync();
     __pressed_key_set = ::bit_n_reset(key_idx, __pressed_key_set);
+    if (__sync.has_clock())
+        step();
+}
+
+inline void
+JoyPad::set_pressed_key_set(byte_t key_set) {
+    sync();
+    __pressed_key_set = key_set;
+    if (__sync.has_clock())
+        step();
 }
 
 inline void
@@ -1,30 +1,161 @@
 #ifndef DEVICE_GB_ORAM_H_
 # define DEVICE_GB_ORAM_H_
 
+#include <array>
+#include <cassert>
+#include <cstring>
+#include <utility>
+
 #include "GB_config.h"
 
+#include "common/GB_dbuffer.h"
+#include "common/GB_span.h"
+
+#include "memory/GB_bus.h"
+#include "memory/GB_dirty_pages.h"
+
 namespace GB::device {
 
+/**
+ * @brief Object attribute memory, which keeps index of objects on every LCD line
+ *
+ * @details Index is updated on writes of object Y coordinate, so OAM scan of a line is
+ *          a lookup of the objects mask and a walk over at most LINE_OBJECTS_MAX set bits.
+ *          Objects are indexed by halves: upper 8 rows of every object, and lower 8 rows,
+ *          which are visible with 8x16 objects only.
+ */
 class ORAM {
  public:
+    using objects_mask_t = uint64_t;    ///< bit n is set for object n
+
+    constexpr static unsigned BANKS_NUM = 1;
+    constexpr static unsigned OBJECT_SIZE = ORAM_SIZE / ORAM_OBJECTS_NUM;
+    constexpr static unsigned OBJECT_HALF_HEIGHT = 8;
+    constexpr static unsigned OBJECT_Y_OFFSET = 16;     ///< Y of the object, which starts at line 0
+    constexpr static unsigned LINE_OBJECTS_MAX = 10;
+
+    /** OAM is a single page, but it's tracked the same way as other memory devices */
+    using DirtyPages = memory::DirtyPages<ORAM_SIZE>;
 
-    ORAM() : __memory(ORAM_SIZE) {}
-    ORAM(const ORAM& other) = default;
-    ORAM(ORAM&& other) = default;
+    ORAM() : __memory(dbuffer_t::aligned(ORAM_SIZE)), __bus_link(nullptr) {
+        std::memset(__memory.get_data_addr(), 0x0, ORAM_SIZE);
+        rebuild_line_index();
+    }
+
+    /** Create OAM with external storage (usually an arena view) of ORAM_SIZE bytes */
+    explicit
+    ORAM(dbuffer_t memory) : __memory(std::move(memory)), __bus_link(nullptr) {
+        rebuild_line_index();
+    }
+
+    /** Copies are not mapped to any bus */
+    ORAM(const ORAM& other) : __memory(other.__memory), __bus_link(nullptr), __dirty_pages(other.__dirty_pages)
+                            , __top_objects(other.__top_objects), __bottom_objects(other.__bottom_objects) {}
+    ORAM(ORAM&& other) : __memory(std::move(other.__memory)), __bus_link(nullptr), __dirty_pages(other.__dirty_pages)
+                       , __top_objects(other.__top_objects), __bottom_objects(other.__bottom_objects) {}
     ~ORAM() = default;
 
-    ORAM& operator=(const ORAM& other) = default;
-    ORAM& operator=(ORAM&& other) = default;
+    /** Assigned device keeps own bus mapping */
+    inline ORAM& operator=(const ORAM& other);
+    inline ORAM& operator=(ORAM&& other);
 
     inline byte_t read_phys_addr(word_t phys_addr) const;
     inline void write_phys_addr(word_t phys_addr, byte_t value);
 
+    /** Copy block from OAM to dst */
+    inline void read_block(word_t phys_addr, byte_t* dst, size_t len) const;
+
+    /** Copy block from src to OAM, objects index is updated for the written objects */
+    void write_block(word_t phys_addr, const byte_t* src, size_t len);
+
+    /**
+     * @brief Get view of OAM memory without copying
+     * @param[in] bank physical bank, must be 0 (OAM is a single bank, the parameter keeps
+     *            the interface of banked memories)
+     */
+    inline span_t<const byte_t> view_bank(unsigned bank) const;
+
     inline const dbuffer_t& get_memory_buffer_ref() const;
 
+    /** Get mask of objects, which cover the LCD line */
+    inline objects_mask_t get_line_objects(unsigned line, bool tall_objects) const;
+
+    /**
+     * @brief Select objects of the LCD line, as OAM scan does
+     * @param[out] objects indices of at most LINE_OBJECTS_MAX first objects in OAM order
+     * @return number of selected objects
+     */
+    inline unsigned select_line_objects(unsigned line, bool tall_objects, byte_t* objects) const;
+
+    /**
+     * @brief Rebuild objects index from memory
+     * @details Must be called after OAM memory is modified not through the device (e.g. arena load).
+     */
+    void rebuild_line_index();
+
+    /** Get pages, which are written since the last clear_dirty_pages() */
+    inline const DirtyPages::PageSet& get_dirty_pages() const { return __dirty_pages.get(); }
+
+    /** Clear dirty pages (all writes go through the device, so nothing is remapped) */
+    inline void clear_dirty_pages() { __dirty_pages.clear(); }
+
+    /** Mark the whole memory dirty (e.g. after arena load) */
+    inline void mark_dirty_pages() { __dirty_pages.mark_all(); }
+
+    /**
+     * @brief Make memory copy-on-write, so copies of the device share it until the first write
+     * @details Has no effect on OAM with external storage (arena view).
+     */
+    void share_memory();
+
+    /**
+     * @brief Map OAM to the memory bus (directly to the host memory for reading)
+     * @details Writes go through the device to keep the objects index, and the first write
+     *          to shared memory copies it.
+     */
+    void map_to_memory(memory::BusInterface& mem_bus);
+
  protected:
-    dbuffer_t __memory;
+    dbuffer_t               __memory;
+    memory::BusInterface*   __bus_link;
+    DirtyPages              __dirty_pages;
+
+    std::array<objects_mask_t, LCD_HEIGHT>  __top_objects;      ///< objects with upper rows on the line
+    std::array<objects_mask_t, LCD_HEIGHT>  __bottom_objects;   ///< objects with lower rows on the line
+
+    /** Write to shared memory, which copies it to the private memory and remaps it */
+    void __write_shared_memory(word_t phys_addr, byte_t value);
+
+    /** Add (or remove) object with the Y coordinate to (from) the lines index */
+    void __index_object(unsigned object, byte_t y, bool is_present);
 };
 
+inline ORAM&
+ORAM::operator=(const ORAM& other) {
+    if (this != &other) {
+        __memory = other.__memory;
+        __dirty_pages = other.__dirty_pages;
+        __top_objects = other.__top_objects;
+        __bottom_objects = other.__bottom_objects;
+        if (__bus_link != nullptr)
+            map_to_memory(*__bus_link);
+    }
+    return *this;
+}
+
+inline ORAM&
+ORAM::operator=(ORAM&& other) {
+    if (this != &other) {
+        __memory = std::move(other.__memory);
+        __dirty_pages = other.__dirty_pages;
+        __top_objects = other.__top_objects;
+        __bottom_objects = other.__bottom_objects;
+        if (__bus_link != nullptr)
+            map_to_memory(*__bus_link);
+    }
+    return *this;
+}
+
 inline byte_t
 ORAM::read_phys_addr(word_t phys_addr) const {
     return __memory[phys_addr];
@@ -32,15 +163,51 @@ ORAM::read_phys_addr(word_t phys_addr) const {
 
 inline void
 ORAM::write_phys_addr(word_t phys_addr, byte_t value) {
+    const byte_t previous_value = read_phys_addr(phys_addr);
+
+    if (phys_addr % OBJECT_SIZE == 0 && previous_value != value) {
+        __index_object(phys_addr / OBJECT_SIZE, previous_value, false);
+        __index_object(phys_addr / OBJECT_SIZE, value, true);
+    }
+    __dirty_pages.mark(phys_addr);
+    if (__memory.is_shared())
+        return __write_shared_memory(phys_addr, value);
     __memory[phys_addr] = value;
 }
 
-// TODO(dolovnyak) delete if will not be used in oram objects search
+inline void
+ORAM::read_block(word_t phys_addr, byte_t* dst, size_t len) const {
+    std::memcpy(dst, __memory.get_page_rd_addr(0) + phys_addr, len);
+}
+
+inline span_t<const byte_t>
+ORAM::view_bank([[maybe_unused]] unsigned bank) const {
+    assert(bank < BANKS_NUM);
+    return span_t<const byte_t>(__memory.get_page_rd_addr(0), ORAM_SIZE);
+}
+
 inline const dbuffer_t&
 ORAM::get_memory_buffer_ref() const {
     return __memory;
 }
 
+inline ORAM::objects_mask_t
+ORAM::get_line_objects(unsigned line, bool tall_objects) const {
+    return __top_objects[line] | (tall_objects ? __bottom_objects[line] : 0);
+}
+
+inline unsigned
+ORAM::select_line_objects(unsigned line, bool tall_objects, byte_t* objects) const {
+    objects_mask_t line_objects = get_line_objects(line, tall_objects);
+    unsigned objects_num = 0;
+
+    for (; line_objects != 0 && objects_num < LINE_OBJECTS_MAX; ++objects_num) {
+        objects[objects_num] = byte_t(__builtin_ctzll(line_objects));
+        line_objects &= line_objects - 1;
+    }
+    return objects_num;
+}
+
 }   // namespace GB::device
 
 #endif  // DEVICE_GB_ORAM_H_
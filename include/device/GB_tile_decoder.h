@@ -0,0 +1,100 @@
+/**
+ * @file GB_tile_decoder.h
+ * @brief Describes decoder of 2bpp tile rows for the PPU fetch path
+ */
+
+#ifndef DEVICE_GB_TILE_DECODER_H_
+# define DEVICE_GB_TILE_DECODER_H_
+
+# include "GB_config.h"
+
+# include "common/GB_types.h"
+
+namespace GB::device {
+
+/**
+ * @brief Decoder of tile rows to palette indices with SIMD kernels, selected at runtime
+ *
+ * @details Tile row is two bitplane bytes, as it's stored in VRAM: low bitplane gives bit 0
+ *          of the palette index, high bitplane gives bit 1, and the most significant bit is
+ *          the leftmost pixel. SSE2 and AVX2 kernels decode 4 rows per iteration,
+ *          scalar kernel uses a lookup table and is used on other hosts and for tails.
+ */
+class TileDecoder {
+ public:
+    enum Isa : unsigned {
+        SCALAR_ISA = 0,
+        SSE2_ISA,
+        AVX2_ISA,
+        ISA_NUM
+    };
+
+    /** Kernel, which decodes rows (pairs of bitplane bytes) to 8 pixels per row */
+    using Kernel = void(*)(const byte_t* planes, unsigned rows_num, byte_t* pixels);
+
+    constexpr static unsigned TILE_SIZE = 16;
+    constexpr static unsigned TILE_WIDTH = 8;
+    constexpr static unsigned MAP_WIDTH = 32;                   ///< tiles in a row of the tile map
+    constexpr static unsigned LINE_WIDTH = 160;
+    constexpr static unsigned LINE_TILES_NUM = LINE_WIDTH / TILE_WIDTH + 1;   ///< with a scrolled tile
+
+    /** Bits of CGB background map attributes */
+    constexpr static byte_t ATTR_BANK_BIT = 3;
+    constexpr static byte_t ATTR_HFLIP_BIT = 5;
+    constexpr static byte_t ATTR_VFLIP_BIT = 6;
+
+    /** Get the best ISA, which is supported by the host CPU */
+    static Isa get_best_isa();
+
+    /** Returns true if the host CPU supports the ISA */
+    static bool is_supported(Isa isa);
+
+    /**
+     * @brief Create decoder with the kernel of the ISA
+     * @details Unsupported ISA falls back to the best supported one.
+     */
+    explicit
+    TileDecoder(Isa isa = get_best_isa());
+
+    inline Isa get_isa() const { return __isa; }
+
+    /**
+     * @brief Decode tile rows
+     * @param[in] planes rows_num pairs of bitplane bytes
+     * @param[out] pixels 8 palette indices per row
+     */
+    inline void decode_rows(const byte_t* planes, unsigned rows_num, byte_t* pixels) const;
+
+    /**
+     * @brief Fetch background (or window) line
+     *
+     * @details Tile rows of the line are gathered with horizontal flip applied to bitplanes,
+     *          and vertical flip and bank select applied to addresses, then decoded at once.
+     *          Window line is fetched with zero scroll.
+     *
+     * @param[in] vram VRAM memory, bank 1 follows bank 0 in CGB mode
+     * @param[in] map_offset offset of the tile map in the bank (0x1800 or 0x1C00)
+     * @param[in] signed_tiles tile indices are signed relative to 0x1000 (LCDC bit 4 is reset)
+     * @param[in] cgb_attrs tile map has attributes in bank 1
+     * @param[in] scx horizontal scroll
+     * @param[in] y line in the tile map (LY + SCY)
+     * @param[out] pixels LINE_WIDTH palette indices
+     */
+    void fetch_line(const byte_t* vram, word_t map_offset, bool signed_tiles, bool cgb_attrs
+                  , byte_t scx, byte_t y, byte_t* pixels) const;
+
+ protected:
+    Isa     __isa;
+    Kernel  __kernel;
+
+    static Kernel __get_kernel(Isa isa);
+};
+
+inline void
+TileDecoder::decode_rows(const byte_t* planes, unsigned rows_num, byte_t* pixels) const {
+    __kernel(planes, rows_num, pixels);
+}
+
+}  // namespace GB::device
+
+#endif  // DEVICE_GB_TILE_DECODER_H_
@@ -0,0 +1,192 @@
+/**
+ * @file GB_timer.h
+ * @brief Describes DIV/TIMA timer device
+ */
+
+#ifndef DEVICE_GB_TIMER_H_
+# define DEVICE_GB_TIMER_H_
+
+# include <cstring>
+
+# include "GB_config.h"
+
+# include "common/GB_clock.h"
+# include "common/GB_macro.h"
+# include "common/GB_scheduler.h"
+# include "common/GB_types.h"
+
+# include "device/GB_interrupt.h"
+
+# include "memory/GB_bus.h"
+# include "memory/GB_vaddr.h"
+
+namespace GB::device {
+
+/**
+ * @brief Timer, which is computed from clock timestamps instead of stepping every cycle
+ *
+ * @details DIV is the upper byte of the 16-bit system counter, which is incremented every
+ *          clock cycle. TIMA is incremented on the falling edge of the counter bit, which is
+ *          selected by TAC, while the timer is enabled. So the counter is the time elapsed since
+ *          the last DIV reset, and TIMA is synchronized lazily by counting falling edges since
+ *          the last synchronization (on register access).
+ *
+ *          TIMA overflow is a single scheduled event: TIMA is 0x00 for one M-cycle after the
+ *          overflow, then it's reloaded with TMA and the timer interrupt is requested.
+ *          Falling edge glitches are kept: DIV write and TAC write, which turn the selected
+ *          signal from 1 to 0, increment TIMA. TIMA write during the overflow M-cycle cancels
+ *          the reload, TIMA write at the reload M-cycle is ignored, and TMA write at the reload
+ *          M-cycle is loaded to TIMA too.
+ *
+ *          Timer registers its event at the scheduler, and is not copyable.
+ */
+class Timer {
+ public:
+    constexpr static unsigned COUNTER_MASK = 0xFFFF;
+    constexpr static unsigned DIV_SHIFT = 8;
+    constexpr static unsigned TIMA_OVERFLOW = 0x100;
+    constexpr static clk_cycle_t RELOAD_DELAY = 1_MCycles;
+
+    /** TAC bits */
+    constexpr static byte_t TAC_ENABLE_BIT = 2;
+    constexpr static byte_t TAC_CLOCK_MASK = 0b11;
+    constexpr static byte_t TAC_RESERVED_BITS = ::bit_mask(7, 3);
+
+    /** Counter bit, which clocks TIMA, for every TAC clock select */
+    constexpr static unsigned TIMA_COUNTER_BITS[] = { 9, 3, 5, 7 };
+
+    /** Trivially copyable timer state (overflow event is saved with the scheduler) */
+    struct State {
+        clk_cycle_t     origin;
+        clk_cycle_t     reload_time;
+        clk_cycle_t     last_reload;
+        clk_cycle_t     last_sync;
+        unsigned        tima;
+        byte_t          tma;
+        byte_t          tac;
+    };
+
+    /**
+     * @param[in] ic_link interrupt controller, which receives timer interrupt
+     * @param[in] scheduler machine scheduler, which gives time and dispatches overflow event
+     */
+    Timer(InterruptController* ic_link, devsync::Scheduler* scheduler);
+
+    Timer(const Timer&) = delete;
+    Timer& operator=(const Timer&) = delete;
+
+    inline byte_t get_DIV_reg() const;
+    void set_DIV_reg(byte_t value);
+
+    byte_t get_TIMA_reg();
+    void set_TIMA_reg(byte_t value);
+
+    inline byte_t get_TMA_reg() const { return __tma; }
+    void set_TMA_reg(byte_t value);
+
+    inline byte_t get_TAC_reg() const { return __tac | TAC_RESERVED_BITS; }
+    void set_TAC_reg(byte_t value);
+
+    /** Get 16-bit system counter */
+    inline unsigned get_counter() const;
+
+    /** Catch up TIMA for the falling edges since the last synchronization */
+    void sync();
+
+    inline State get_state() const;
+    inline void set_state(const State& state);
+
+    /** Map timer registers to the memory bus */
+    void map_to_memory(memory::BusInterface& mem_bus);
+
+ protected:
+    InterruptController*            __interrupt_link;
+    devsync::Scheduler*             __scheduler;
+    devsync::Scheduler::event_id_t  __event;
+    devsync::sync_stamp_t           __sync;
+
+    clk_cycle_t     __origin;           ///< time of the last counter reset
+    clk_cycle_t     __reload_time;      ///< time of pending TMA reload (NEVER if there is no overflow)
+    clk_cycle_t     __last_reload;      ///< time of the last TMA reload
+    unsigned        __tima;
+    byte_t          __tma;
+    byte_t          __tac;
+
+    static void __on_event(void* timer, clk_cycle_t deadline);
+
+    inline bool __is_enabled() const;
+    inline clk_cycle_t __get_edge_period() const;
+
+    /** Selected counter bit, which is and-ed with enable bit (TIMA clock signal) */
+    inline bool __get_signal() const;
+
+    /** Falling edges of TIMA clock signal in (from:to] */
+    inline clk_cycle_t __count_edges(clk_cycle_t from, clk_cycle_t to) const;
+
+    void __increment();
+    void __schedule_overflow();
+};
+
+inline byte_t
+Timer::get_DIV_reg() const {
+    return byte_t(get_counter() >> DIV_SHIFT);
+}
+
+inline Timer::State
+Timer::get_state() const {
+    State state;
+
+    std::memset(&state, 0, sizeof(State));
+    state.origin = __origin;
+    state.reload_time = __reload_time;
+    state.last_reload = __last_reload;
+    state.last_sync = __sync.get_last_sync();
+    state.tima = __tima;
+    state.tma = __tma;
+    state.tac = __tac;
+    return state;
+}
+
+inline void
+Timer::set_state(const State& state) {
+    __origin = state.origin;
+    __reload_time = state.reload_time;
+    __last_reload = state.last_reload;
+    __sync.set_last_sync(state.last_sync);
+    __tima = state.tima;
+    __tma = state.tma;
+    __tac = state.tac;
+}
+
+inline unsigned
+Timer::get_counter() const {
+    return unsigned(__scheduler->get_time() - __origin) & COUNTER_MASK;
+}
+
+inline bool
+Timer::__is_enabled() const {
+    return ::bit_n(TAC_ENABLE_BIT, __tac);
+}
+
+inline clk_cycle_t
+Timer::__get_edge_period() const {
+    return clk_cycle_t(2) << TIMA_COUNTER_BITS[__tac & TAC_CLOCK_MASK];
+}
+
+inline bool
+Timer::__get_signal() const {
+    return __is_enabled() && ::bit_n(TIMA_COUNTER_BITS[__tac & TAC_CLOCK_MASK], get_counter());
+}
+
+inline clk_cycle_t
+Timer::__count_edges(clk_cycle_t from, clk_cycle_t to) const {
+    if (!__is_enabled())
+        return 0;
+
+    const clk_cycle_t period = __get_edge_period();
+    return (to - __origin) / period - (from - __origin) / period;
+}
+
+}  // namespace GB::device
+
+#endif  // DEVICE_GB_TIMER_H_
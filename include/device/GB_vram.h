@@ -1,11 +1,27 @@
 #ifndef DEVICE_GB_VRAM_H_
 #define DEVICE_GB_VRAM_H_
 
+#include <array>
+#include <utility>
+
 #include "common/GB_macro.h"
 #include "GB_config.h"
 
+#include "memory/GB_bus.h"
+#include "memory/GB_dirty_pages.h"
+
 namespace GB::device {
 
+/**
+ * @brief Video RAM, specialized for a hardware mode at compile time
+ *
+ * @details Modes without CGB banking allocate only VRAM_NON_CGB_SIZE and have no VBK register.
+ *
+ *          VRAM keeps tiles decoded to 8x8 palette indices. Writes to tile data mark only
+ *          the affected tile row dirty, and dirty rows are decoded on the next tile access,
+ *          so renderer doesn't decode 2bpp data on every scanline.
+ */
+template <GBModeFlag _Mode>
 class VRAM {
  public:
     struct Registers {
@@ -17,84 +33,393 @@ class VRAM {
         Registers(Reg8 vbk_init_value = VBK_INIT_VALUE) : VBK(vbk_init_value) {}
     };
 
-    VRAM() : __memory(VRAM_MAX_SIZE), __regs() {}
-    VRAM(const VRAM& other) = default;
-    VRAM(VRAM&& other) = default;
+    constexpr static GBModeFlag MODE = _Mode;
+    constexpr static bool CGB_BANKS = has_cgb_banks(_Mode);
+
+    constexpr static unsigned MAX_SIZE = vram_size(_Mode);
+    constexpr static unsigned BANK_OFFSET_MASK = VRAM_BANK_SIZE - 1;
+
+    /** Bank consists of two copy-on-write pages, which are copied together */
+    constexpr static unsigned PAGES_NUM = VRAM_BANK_SIZE / dbuffer_t::PAGE_SIZE;
+    constexpr static unsigned PAGE_IDX_SHIFT = 12;
+    constexpr static unsigned PAGE_OFFSET_MASK = dbuffer_t::PAGE_SIZE - 1;
+
+    /** Tile data [8000:97FF] of every bank, each tile is 8 rows of two bitplane bytes */
+    constexpr static unsigned BANKS_NUM = CGB_BANKS ? 2 : 1;
+    constexpr static unsigned TILES_NUM = 384;
+    constexpr static unsigned TILE_SIZE = 16;
+    constexpr static unsigned TILE_ROWS_NUM = 8;
+    constexpr static unsigned TILE_ROW_SIZE = TILE_SIZE / TILE_ROWS_NUM;
+    constexpr static unsigned TILE_DATA_SIZE = TILES_NUM * TILE_SIZE;
+    constexpr static unsigned TILE_PIXELS_NUM = 8 * TILE_ROWS_NUM;
+
+    using DirtyPages = memory::DirtyPages<MAX_SIZE>;
+
+    VRAM() : __memory(dbuffer_t::aligned(MAX_SIZE)), __regs(), __bus_link(nullptr)
+           , __tile_cache() {
+        __update_bank_ptr();
+        invalidate_tile_cache();
+    }
+
+    /**
+     * @brief Create VRAM with external storage
+     * @param[in] memory buffer (usually an arena view) of MAX_SIZE bytes
+     */
+    explicit
+    VRAM(dbuffer_t memory) : __memory(std::move(memory)), __regs(), __bus_link(nullptr)
+                           , __tile_cache() {
+        __update_bank_ptr();
+        invalidate_tile_cache();
+    }
+
+    /**
+     * @brief Copies are not mapped to any bus
+     * @details Tile cache isn't copied: it's allocated and decoded again by the first tile access
+     *          of the copy, so a fork costs a copy of the memory (which is shared until written).
+     */
+    VRAM(const VRAM& other) : __memory(other.__memory), __regs(other.__regs), __bus_link(nullptr)
+                            , __dirty_pages(other.__dirty_pages), __tile_cache() {
+        __update_bank_ptr();
+        invalidate_tile_cache();
+    }
+
+    VRAM(VRAM&& other) : __memory(std::move(other.__memory)), __regs(other.__regs), __bus_link(nullptr)
+                       , __dirty_pages(other.__dirty_pages)
+                       , __tile_cache(std::move(other.__tile_cache)), __dirty_rows(other.__dirty_rows) {
+        __update_bank_ptr();
+    }
+
     ~VRAM() = default;
 
-    VRAM& operator=(const VRAM& other) = default;
-    VRAM& operator=(VRAM&& other) = default;
+    /** Assigned device keeps own bus mapping */
+    inline VRAM& operator=(const VRAM& other);
+    inline VRAM& operator=(VRAM&& other);
 
     inline byte_t get_VBK_reg() const;
     inline void set_VBK_reg(byte_t value);
 
+    /** VRAM state is its registers (memory is saved with the arena) */
+    using State = Registers;
+
+    inline const State& get_state() const { return __regs; }
+
+    /** Restore registers and remap the selected bank, the memory is restored too, so tile cache is dropped */
+    inline void set_state(const State& state);
+
     inline byte_t read_inner_vaddr(word_t inner_vaddr) const;
     inline void write_inner_vaddr(word_t inner_vaddr, byte_t value);
 
     inline byte_t read_phys_addr(word_t phys_addr) const;
     inline void write_phys_addr(word_t phys_addr, byte_t value);
 
+    /**
+     * @brief Copy block from the currently selected bank to dst
+     * @details Inner address wraps at the end of the bank.
+     */
+    void read_block(word_t inner_vaddr, byte_t* dst, size_t len) const;
+
+    /**
+     * @brief Copy block from src to the currently selected bank (see read_block())
+     * @details Only the tile rows, which are covered by the block, are marked dirty.
+     */
+    void write_block(word_t inner_vaddr, const byte_t* src, size_t len);
+
+    /**
+     * @brief Get view of the bank memory without copying
+     * @param[in] bank physical bank (less than BANKS_NUM)
+     * @details View is invalidated by the first write to a frozen bank of shared memory.
+     */
+    inline span_t<const byte_t> view_bank(unsigned bank) const;
+
+    /** Get host address of the currently selected bank */
+    inline const byte_t* get_bank_addr() const;
+
+    /**
+     * @brief Get decoded tile row
+     * @param[in] bank VRAM bank of the tile (less than BANKS_NUM)
+     * @param[in] tile index of the tile in the bank tile data (less than TILES_NUM)
+     * @param[in] row row of the tile (less than TILE_ROWS_NUM)
+     * @return 8 palette indices of the row pixels from left to right
+     */
+    inline const byte_t* get_tile_row(unsigned bank, unsigned tile, unsigned row) const;
+
+    /** Get decoded tile, which is TILE_PIXELS_NUM palette indices row by row (see get_tile_row()) */
+    inline const byte_t* get_tile(unsigned bank, unsigned tile) const;
+
+    /**
+     * @brief Mark every tile dirty
+     * @details Must be called after VRAM memory is modified not through the device (e.g. arena load).
+     */
+    inline void invalidate_tile_cache();
+
+    /** Get physical pages, which are written since the last clear_dirty_pages() */
+    inline const typename DirtyPages::PageSet& get_dirty_pages() const { return __dirty_pages.get(); }
+
+    /** Clear dirty pages, and map them for reading only, so the next write to each page is tracked */
+    void clear_dirty_pages();
+
+    /** Mark the whole memory dirty (e.g. after arena load) */
+    void mark_dirty_pages();
+
+    /**
+     * @brief Make memory copy-on-write, so copies of the device share not modified pages
+     * @details Has no effect on VRAM with external storage (arena view).
+     */
+    void share_memory();
+
+    /**
+     * @brief Map VBK register and VRAM to the memory bus
+     *
+     * @details VRAM is mapped directly to the host memory of the current bank,
+     *          and remapped on every VBK write. Tile data, frozen pages of shared memory and
+     *          clean pages (see DirtyPages) are mapped for reading only, so writes to them
+     *          go through the device.
+     *          VBK is mapped only in modes with CGB banking.
+     */
+    void map_to_memory(memory::BusInterface& mem_bus);
+
  protected:
-    dbuffer_t   __memory;
-    Registers __regs;
+    dbuffer_t               __memory;
+    Registers               __regs;
+    memory::BusInterface*   __bus_link;
+    DirtyPages              __dirty_pages;
+
+    /**
+     * @brief Host addresses of the selected bank pages, updated on VBK writes only
+     * @details Write address is nullptr while the page is frozen page of shared memory.
+     */
+    const byte_t*           __page_ptrs[PAGES_NUM];
+    byte_t*                 __page_wr_ptrs[PAGES_NUM];
+
+    /**
+     * @brief Decoded tiles, and bitset of dirty rows of every tile. Cache isn't a state of the device
+     * @details Cache is allocated by the first decoding, so copies allocate it only when they are drawn.
+     */
+    mutable dbuffer_t                                   __tile_cache;
+    mutable std::array<byte_t, BANKS_NUM * TILES_NUM>   __dirty_rows;
+
+    inline u32 __get_bank_base() const;
+    inline void __update_bank_ptr();
+
+    static inline dbuffer_t __make_tile_cache();
+    inline void __mark_tile_row_dirty(u32 phys_addr);
+    inline void __decode_tile_row(unsigned tile_idx, unsigned row) const;
 
-    inline unsigned __calc_phys_addr(word_t inner_vaddr) const;
+    void __map_bank_pages();
+
+    /** Map the page, which is marked dirty, directly to the host memory (if it's visible) */
+    void __map_dirty_page(u32 phys_addr);
+
+    /** Write to shared memory, which copies frozen bank to the private memory and remaps it */
+    void __write_shared_memory(u32 phys_addr, byte_t value);
 };
 
+template <GBModeFlag _Mode>
+inline VRAM<_Mode>&
+VRAM<_Mode>::operator=(const VRAM& other) {
+    if (this != &other) {
+        __memory = other.__memory;
+        __regs = other.__regs;
+        __dirty_pages = other.__dirty_pages;
+        invalidate_tile_cache();
+        __update_bank_ptr();
+        if (__bus_link != nullptr)
+            map_to_memory(*__bus_link);
+    }
+    return *this;
+}
+
+template <GBModeFlag _Mode>
+inline VRAM<_Mode>&
+VRAM<_Mode>::operator=(VRAM&& other) {
+    if (this != &other) {
+        __memory = std::move(other.__memory);
+        __regs = other.__regs;
+        __dirty_pages = other.__dirty_pages;
+        __tile_cache = std::move(other.__tile_cache);
+        __dirty_rows = other.__dirty_rows;
+        __update_bank_ptr();
+        if (__bus_link != nullptr)
+            map_to_memory(*__bus_link);
+    }
+    return *this;
+}
+
 /**
  * @brief   Return VBK register value (only zero bit readable).
  *
- * @details Only zero bit matter and can return different values, other always set in '1' 0b1111111{ZERO_BIT_VALUE}
+ * @details Only zero bit matter and can return different values, other always set in '1' 0b1111111{ZERO_BIT_VALUE}.
+ *          Without CGB banking (DMG, CGB_DMG_MODE) the register is not connected and all bits are read as 1.
  */
-// TODO(hgranule, dolovnyak):   DMG/CGB_DMG_MODE conflicts.
-//                              Behavior which described above correct for CGB/CGB_DMG_MODE behavior.
-//                              In DMG_MODE this function must return 0xFF (0xFA now).
-//                              I think we will define the correct behavior after or during
-//                              the implementation of the membus mapping.
+template <GBModeFlag _Mode>
 inline byte_t
-VRAM::get_VBK_reg() const {
+VRAM<_Mode>::get_VBK_reg() const {
+    if constexpr (!CGB_BANKS)
+        return memory::BusInterface::OPEN_BUS_VALUE;
+
     return __regs.VBK | Registers::RESERVED_BITS;
 }
 
 /**
  * @brief   Write value to VBK register (only zero bit writable).
  *
- * @details Only zero bit will rewrite.
+ * @details Only zero bit will rewrite. Ignored without CGB banking.
  */
+template <GBModeFlag _Mode>
 inline void
-VRAM::set_VBK_reg(byte_t value) {
+VRAM<_Mode>::set_VBK_reg(byte_t value) {
+    if constexpr (!CGB_BANKS)
+        return;
+
     __regs.VBK = ::bit_n(0, value);
+    __update_bank_ptr();
+    if (__bus_link != nullptr)
+        __map_bank_pages();
+}
+
+template <GBModeFlag _Mode>
+inline void
+VRAM<_Mode>::set_state(const State& state) {
+    set_VBK_reg(state.VBK);
+    invalidate_tile_cache();
 }
 
+template <GBModeFlag _Mode>
 inline byte_t
-VRAM::read_inner_vaddr(word_t inner_vaddr) const {
-    return read_phys_addr(__calc_phys_addr(inner_vaddr));
+VRAM<_Mode>::read_inner_vaddr(word_t inner_vaddr) const {
+    const unsigned page = (inner_vaddr >> PAGE_IDX_SHIFT) & (PAGES_NUM - 1);
+    return __page_ptrs[page][inner_vaddr & PAGE_OFFSET_MASK];
 }
 
+template <GBModeFlag _Mode>
 inline void
-VRAM::write_inner_vaddr(word_t inner_vaddr, byte_t value) {
-    write_phys_addr(__calc_phys_addr(inner_vaddr), value);
+VRAM<_Mode>::write_inner_vaddr(word_t inner_vaddr, byte_t value) {
+    const unsigned page = (inner_vaddr >> PAGE_IDX_SHIFT) & (PAGES_NUM - 1);
+    byte_t* const page_ptr = __page_wr_ptrs[page];
+    const u32 phys_addr = __get_bank_base() + (inner_vaddr & BANK_OFFSET_MASK);
+
+    __mark_tile_row_dirty(phys_addr);
+    if (page_ptr == nullptr)
+        return __write_shared_memory(phys_addr, value);
+    page_ptr[inner_vaddr & PAGE_OFFSET_MASK] = value;
+    if (__dirty_pages.mark(phys_addr))
+        __map_dirty_page(phys_addr);
 }
 
+template <GBModeFlag _Mode>
 inline byte_t
-VRAM::read_phys_addr(word_t phys_addr) const {
+VRAM<_Mode>::read_phys_addr(word_t phys_addr) const {
     return __memory[phys_addr];
 }
 
+template <GBModeFlag _Mode>
 inline void
-VRAM::write_phys_addr(word_t phys_addr, byte_t value) {
+VRAM<_Mode>::write_phys_addr(word_t phys_addr, byte_t value) {
+    __mark_tile_row_dirty(phys_addr);
+    if (__memory.is_shared())
+        return __write_shared_memory(phys_addr, value);
     __memory[phys_addr] = value;
+    if (__dirty_pages.mark(phys_addr))
+        __map_dirty_page(phys_addr);
+}
+
+template <GBModeFlag _Mode>
+inline span_t<const byte_t>
+VRAM<_Mode>::view_bank(unsigned bank) const {
+    // pages of a bank are copied together, so they are contiguous
+    return span_t<const byte_t>(__memory.get_page_rd_addr(bank * PAGES_NUM), VRAM_BANK_SIZE);
+}
+
+template <GBModeFlag _Mode>
+inline const byte_t*
+VRAM<_Mode>::get_bank_addr() const {
+    return __page_ptrs[0];
+}
+
+template <GBModeFlag _Mode>
+inline const byte_t*
+VRAM<_Mode>::get_tile_row(unsigned bank, unsigned tile, unsigned row) const {
+    const unsigned tile_idx = bank * TILES_NUM + tile;
+
+    if (::bit_n(row, __dirty_rows[tile_idx]))
+        __decode_tile_row(tile_idx, row);
+    return __tile_cache.get_data_addr() + tile_idx * TILE_PIXELS_NUM + row * 8;
+}
+
+template <GBModeFlag _Mode>
+inline const byte_t*
+VRAM<_Mode>::get_tile(unsigned bank, unsigned tile) const {
+    const unsigned tile_idx = bank * TILES_NUM + tile;
+
+    for (unsigned row = 0; __dirty_rows[tile_idx] != 0; ++row) {
+        if (::bit_n(row, __dirty_rows[tile_idx]))
+            __decode_tile_row(tile_idx, row);
+    }
+    return __tile_cache.get_data_addr() + tile_idx * TILE_PIXELS_NUM;
+}
+
+template <GBModeFlag _Mode>
+inline void
+VRAM<_Mode>::invalidate_tile_cache() {
+    __dirty_rows.fill(0xFF);
 }
 
-inline unsigned
-VRAM::__calc_phys_addr(word_t inner_vaddr) const {
-    const u32 bank_offset = inner_vaddr % VRAM_BANK_SIZE;
-    const u32 bank_base = (::bit_n(0, __regs.VBK)) ? VRAM_BANK_SIZE : 0;
+template <GBModeFlag _Mode>
+inline dbuffer_t
+VRAM<_Mode>::__make_tile_cache() {
+    return dbuffer_t::aligned(BANKS_NUM * TILES_NUM * TILE_PIXELS_NUM);
+}
+
+template <GBModeFlag _Mode>
+inline void
+VRAM<_Mode>::__mark_tile_row_dirty(u32 phys_addr) {
+    const u32 bank_offset = phys_addr & BANK_OFFSET_MASK;
 
-    return bank_base + bank_offset;
+    if (bank_offset < TILE_DATA_SIZE) {
+        const unsigned tile_idx = (phys_addr / VRAM_BANK_SIZE) * TILES_NUM + bank_offset / TILE_SIZE;
+        __dirty_rows[tile_idx] |= ::bits_set((bank_offset % TILE_SIZE) / TILE_ROW_SIZE);
+    }
+}
+
+/**
+ * @brief Decode row of two bitplanes to palette indices
+ * @details Low bitplane gives bit 0 of the index, high bitplane gives bit 1,
+ *          and the most significant bit is the leftmost pixel.
+ */
+template <GBModeFlag _Mode>
+inline void
+VRAM<_Mode>::__decode_tile_row(unsigned tile_idx, unsigned row) const {
+    const u32 phys_addr = (tile_idx / TILES_NUM) * VRAM_BANK_SIZE
+                        + (tile_idx % TILES_NUM) * TILE_SIZE + row * TILE_ROW_SIZE;
+    const byte_t low = __memory[phys_addr];
+    const byte_t high = __memory[phys_addr + 1];
+    if (__tile_cache.size() == 0)
+        __tile_cache = __make_tile_cache();
+
+    byte_t* const pixels = __tile_cache.get_data_addr() + tile_idx * TILE_PIXELS_NUM + row * 8;
+
+    for (unsigned x = 0; x < 8; ++x)
+        pixels[x] = byte_t((::bit_n(7 - x, high) << 1) | ::bit_n(7 - x, low));
+    __dirty_rows[tile_idx] = ::bit_n_reset(row, __dirty_rows[tile_idx]);
+}
+
+template <GBModeFlag _Mode>
+inline u32
+VRAM<_Mode>::__get_bank_base() const {
+    return (CGB_BANKS && ::bit_n(0, __regs.VBK)) ? VRAM_BANK_SIZE : 0;
+}
+
+template <GBModeFlag _Mode>
+inline void
+VRAM<_Mode>::__update_bank_ptr() {
+    const u32 first_page = __get_bank_base() / dbuffer_t::PAGE_SIZE;
+
+    for (unsigned page = 0; page < PAGES_NUM; ++page) {
+        __page_ptrs[page] = __memory.get_page_rd_addr(first_page + page);
+        __page_wr_ptrs[page] = __memory.get_page_wr_addr(first_page + page);
+    }
 }
 
 }  // namespace GB::device
 
 #endif  // DEVICE_GB_VRAM_H_
-
@@ -6,16 +6,27 @@
 #ifndef DEVICE_GB_WRAM_H_
 # define DEVICE_GB_WRAM_H_
 
+# include <utility>
+
 # include "GB_config.h"
 
 # include "common/GB_types.h"
 # include "common/GB_macro.h"
 
+# include "memory/GB_bus.h"
+# include "memory/GB_dirty_pages.h"
 # include "memory/GB_vaddr.h"
 
 
 namespace GB::device {
 
+/**
+ * @brief Work RAM, specialized for a hardware mode at compile time
+ *
+ * @details Modes without CGB banking allocate only WRAM_NON_CGB_SIZE, have WRAMX fixed
+ *          to bank 1 and ignore SVBK register, so there is no bank select logic at all.
+ */
+template <GBModeFlag _Mode>
 class WRAM {
  public:
     struct Registers {
@@ -27,79 +38,292 @@ class WRAM {
         Registers(Reg8 svbk_init_val = SVBK_INIT_VALUE) : SVBK(svbk_init_val) {}
     };
 
-    constexpr static unsigned MAX_SIZE = WRAM_CGB_SIZE;
+    constexpr static GBModeFlag MODE = _Mode;
+    constexpr static bool CGB_BANKS = has_cgb_banks(_Mode);
+
+    constexpr static unsigned MAX_SIZE = wram_size(_Mode);
     constexpr static unsigned BANK_SIZE = WRAM_CGB_BANK_SIZE;
+    constexpr static unsigned BANKS_NUM = MAX_SIZE / BANK_SIZE;
+
+    /** Inner address space [0x0000:0x1FFF] consists of two windows: WRAM0 and WRAMX */
+    constexpr static unsigned WINDOWS_NUM = 2;
+    constexpr static unsigned WINDOW_IDX_SHIFT = 12;
+    constexpr static unsigned WINDOW_OFFSET_MASK = BANK_SIZE - 1;
+    constexpr static unsigned INNER_VADDR_MASK = WINDOWS_NUM * BANK_SIZE - 1;
+
+    using DirtyPages = memory::DirtyPages<MAX_SIZE>;
 
  protected:
-    dbuffer_t   __memory;
-    Registers   __regs;
+    dbuffer_t               __memory;
+    Registers               __regs;
+    memory::BusInterface*   __bus_link;
+    DirtyPages              __dirty_pages;
+
+    /**
+     * @brief Host addresses of banks which are visible at WRAM0/WRAMX windows
+     * @details Updated on SVBK writes only, so inner address translation costs a single load.
+     *          Write address is nullptr while the bank is a frozen page of shared memory.
+     */
+    const byte_t*           __bank_ptrs[WINDOWS_NUM];
+    byte_t*                 __bank_wr_ptrs[WINDOWS_NUM];
+    u32                     __bank_bases[WINDOWS_NUM];      ///< physical addresses of the banks
 
  protected:
     inline u32 __get_bank_idx_bits() const;
     inline u32 __get_current_bank_idx() const;
-    inline u32 __calc_phys_addr(word_t inner_vaddr) const;
+    inline u32 __get_window_bank_idx(unsigned window) const;
+
+    inline void __update_bank_ptrs();
+    void __map_window(unsigned window);
+    void __map_bank_pages();
+
+    /** Map the page, which is marked dirty, directly to the host memory (if it's visible) */
+    void __map_dirty_page(u32 phys_addr);
+
+    /** Write to shared memory, which copies frozen bank to the private memory and remaps it */
+    void __write_shared_memory(u32 phys_addr, byte_t data);
 
  public:
-    WRAM(): __memory(MAX_SIZE), __regs() {}
+    WRAM(): __memory(dbuffer_t::aligned(MAX_SIZE)), __regs(), __bus_link(nullptr) {
+        __update_bank_ptrs();
+    }
+
+    /**
+     * @brief Create WRAM with external storage
+     * @param[in] memory buffer (usually an arena view) of MAX_SIZE bytes
+     */
+    explicit
+    WRAM(dbuffer_t memory) : __memory(std::move(memory)), __regs(), __bus_link(nullptr) {
+        __update_bank_ptrs();
+    }
+
+    /** Copies are not mapped to any bus */
+    WRAM(const WRAM& other) : __memory(other.__memory), __regs(other.__regs), __bus_link(nullptr)
+                            , __dirty_pages(other.__dirty_pages) {
+        __update_bank_ptrs();
+    }
+
+    WRAM(WRAM&& other) : __memory(std::move(other.__memory)), __regs(other.__regs), __bus_link(nullptr)
+                       , __dirty_pages(other.__dirty_pages) {
+        __update_bank_ptrs();
+    }
+
+    /** Assigned device keeps own bus mapping */
+    inline WRAM& operator=(const WRAM& other);
+    inline WRAM& operator=(WRAM&& other);
 
     inline byte_t get_SVBK_reg() const;
     inline void set_SVBK_reg(byte_t value);
 
+    /** WRAM state is its registers (memory is saved with the arena) */
+    using State = Registers;
+
+    inline const State& get_state() const { return __regs; }
+
+    /** Restore registers, and remap the selected bank */
+    inline void set_state(const State& state) { set_SVBK_reg(state.SVBK); }
+
     inline byte_t read_inner_vaddr(word_t inner_vaddr) const;
     inline void write_inner_vaddr(word_t inner_vaddr, byte_t data);
 
     inline byte_t read_phys_addr(word_t paddr) const;
     inline void write_phys_addr(word_t paddr, byte_t data);
 
+    /**
+     * @brief Copy block from inner address space to dst
+     * @details Block is copied by windows, so it's split at the end of WRAM0 into the selected
+     *          WRAMX bank, and inner address wraps at the end of WRAMX.
+     */
+    void read_block(word_t inner_vaddr, byte_t* dst, size_t len) const;
+
+    /**
+     * @brief Copy block from src to inner address space (see read_block())
+     * @details The first write to a frozen bank of shared memory copies it.
+     */
+    void write_block(word_t inner_vaddr, const byte_t* src, size_t len);
+
+    /**
+     * @brief Get view of the bank memory without copying
+     * @param[in] bank physical bank (less than BANKS_NUM)
+     * @details View is invalidated by the first write to a frozen bank of shared memory.
+     */
+    inline span_t<const byte_t> view_bank(unsigned bank) const;
+
+    /** Get host address of WRAM0 bank */
+    inline const byte_t* get_bank0_addr() const;
+
+    /** Get host address of the bank, which is currently selected for WRAMX */
+    inline const byte_t* get_bankx_addr() const;
+
+    /** Get physical pages, which are written since the last clear_dirty_pages() */
+    inline const typename DirtyPages::PageSet& get_dirty_pages() const { return __dirty_pages.get(); }
+
+    /** Clear dirty pages, and map them for reading only, so the next write to each page is tracked */
+    void clear_dirty_pages();
+
+    /** Mark the whole memory dirty (e.g. after arena load) */
+    void mark_dirty_pages();
+
+    /**
+     * @brief Make memory copy-on-write, so copies of the device share not modified banks
+     * @details Has no effect on WRAM with external storage (arena view).
+     */
+    void share_memory();
+
+    /**
+     * @brief Map SVBK register, WRAM and its echo to the memory bus
+     *
+     * @details WRAM0 and WRAMX are mapped directly to the host memory, WRAMX pages are
+     *          remapped on every SVBK write. Echo pages are aliases of the same host memory,
+     *          so echo access costs the same single load/store as WRAM access.
+     *          Frozen banks of shared memory and clean pages (see DirtyPages) are mapped for
+     *          reading only, and the first write to such bank copies it, and the first write
+     *          to such page marks it dirty. SVBK is mapped only in modes with CGB banking.
+     */
+    void map_to_memory(memory::BusInterface& mem_bus);
+
 };
 
+template <GBModeFlag _Mode>
+inline WRAM<_Mode>&
+WRAM<_Mode>::operator=(const WRAM& other) {
+    if (this != &other) {
+        __memory = other.__memory;
+        __regs = other.__regs;
+        __dirty_pages = other.__dirty_pages;
+        __update_bank_ptrs();
+        if (__bus_link != nullptr)
+            map_to_memory(*__bus_link);
+    }
+    return *this;
+}
+
+template <GBModeFlag _Mode>
+inline WRAM<_Mode>&
+WRAM<_Mode>::operator=(WRAM&& other) {
+    if (this != &other) {
+        __memory = std::move(other.__memory);
+        __regs = other.__regs;
+        __dirty_pages = other.__dirty_pages;
+        __update_bank_ptrs();
+        if (__bus_link != nullptr)
+            map_to_memory(*__bus_link);
+    }
+    return *this;
+}
+
+template <GBModeFlag _Mode>
 inline u32
-WRAM::__get_bank_idx_bits() const {
+WRAM<_Mode>::__get_bank_idx_bits() const {
     return ::bit_slice(2, 0, __regs.SVBK);
 }
 
+template <GBModeFlag _Mode>
 inline u32
-WRAM::__get_current_bank_idx() const {
+WRAM<_Mode>::__get_current_bank_idx() const {
+    if constexpr (!CGB_BANKS)
+        return 0x1;
+
     const u32 bank_bits = __get_bank_idx_bits();
     return (bank_bits == 0x0) ? 0x1 : bank_bits;
 }
 
+template <GBModeFlag _Mode>
 inline u32
-WRAM::__calc_phys_addr(word_t inner_vaddr) const {
-    const u32 bank_idx = (inner_vaddr >= memory::WRAMX_BASE_VADDR)
-                            ? __get_current_bank_idx() : 0x0;
-    const u32 bank_offset = inner_vaddr % BANK_SIZE;
-    return (bank_idx * BANK_SIZE) + bank_offset;
+WRAM<_Mode>::__get_window_bank_idx(unsigned window) const {
+    return (window == 0) ? 0x0 : __get_current_bank_idx();
+}
+
+template <GBModeFlag _Mode>
+inline void
+WRAM<_Mode>::__update_bank_ptrs() {
+    static_assert(BANK_SIZE == dbuffer_t::PAGE_SIZE, "WRAM bank must be a single copy-on-write page");
+
+    for (unsigned window = 0; window < WINDOWS_NUM; ++window) {
+        __bank_ptrs[window] = __memory.get_page_rd_addr(__get_window_bank_idx(window));
+        __bank_wr_ptrs[window] = __memory.get_page_wr_addr(__get_window_bank_idx(window));
+        __bank_bases[window] = __get_window_bank_idx(window) * BANK_SIZE;
+    }
 }
 
+/**
+ * @brief Return SVBK register value
+ * @details Without CGB banking the register is not connected, so all bits are read as 1.
+ */
+template <GBModeFlag _Mode>
 inline byte_t
-WRAM::get_SVBK_reg() const {
+WRAM<_Mode>::get_SVBK_reg() const {
+    if constexpr (!CGB_BANKS)
+        return memory::BusInterface::OPEN_BUS_VALUE;
+
     return __regs.SVBK | Registers::RESERVED_BITS;
 }
 
+template <GBModeFlag _Mode>
 inline void
-WRAM::set_SVBK_reg(byte_t value) {
+WRAM<_Mode>::set_SVBK_reg(byte_t value) {
+    if constexpr (!CGB_BANKS)
+        return;
+
     __regs.SVBK = value;
+    __update_bank_ptrs();
+    if (__bus_link != nullptr)
+        __map_bank_pages();
 }
 
+template <GBModeFlag _Mode>
 inline byte_t
-WRAM::read_inner_vaddr(word_t inner_vaddr) const {
-    return read_phys_addr(__calc_phys_addr(inner_vaddr));
+WRAM<_Mode>::read_inner_vaddr(word_t inner_vaddr) const {
+    const unsigned window = (inner_vaddr >> WINDOW_IDX_SHIFT) & (WINDOWS_NUM - 1);
+    return __bank_ptrs[window][inner_vaddr & WINDOW_OFFSET_MASK];
 }
 
+template <GBModeFlag _Mode>
 inline void
-WRAM::write_inner_vaddr(word_t inner_vaddr, byte_t data) {
-    write_phys_addr(__calc_phys_addr(inner_vaddr), data);
+WRAM<_Mode>::write_inner_vaddr(word_t inner_vaddr, byte_t data) {
+    const unsigned window = (inner_vaddr >> WINDOW_IDX_SHIFT) & (WINDOWS_NUM - 1);
+    byte_t* const bank = __bank_wr_ptrs[window];
+    const u32 phys_addr = __bank_bases[window] + (inner_vaddr & WINDOW_OFFSET_MASK);
+
+    if (bank == nullptr)
+        return __write_shared_memory(phys_addr, data);
+    bank[inner_vaddr & WINDOW_OFFSET_MASK] = data;
+    if (__dirty_pages.mark(phys_addr))
+        __map_dirty_page(phys_addr);
 }
 
+template <GBModeFlag _Mode>
 inline byte_t
-WRAM::read_phys_addr(word_t phys_addr) const {
+WRAM<_Mode>::read_phys_addr(word_t phys_addr) const {
     return __memory[phys_addr];
 }
 
+template <GBModeFlag _Mode>
 inline void
-WRAM::write_phys_addr(word_t phys_addr, byte_t data) {
+WRAM<_Mode>::write_phys_addr(word_t phys_addr, byte_t data) {
+    if (__memory.is_shared())
+        return __write_shared_memory(phys_addr, data);
     __memory[phys_addr] = data;
+    if (__dirty_pages.mark(phys_addr))
+        __map_dirty_page(phys_addr);
+}
+
+template <GBModeFlag _Mode>
+inline span_t<const byte_t>
+WRAM<_Mode>::view_bank(unsigned bank) const {
+    return span_t<const byte_t>(__memory.get_page_rd_addr(bank), BANK_SIZE);
+}
+
+template <GBModeFlag _Mode>
+inline const byte_t*
+WRAM<_Mode>::get_bank0_addr() const {
+    return __bank_ptrs[0];
+}
+
+template <GBModeFlag _Mode>
+inline const byte_t*
+WRAM<_Mode>::get_bankx_addr() const {
+    return __bank_ptrs[1];
 }
 
 }  // namespace GB::device
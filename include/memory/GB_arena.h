@@ -0,0 +1,165 @@
+/**
+ * @file GB_arena.h
+ * @brief Describes memory arena, which keeps storage of all machine devices
+ */
+
+#ifndef MEMORY_GB_ARENA_H_
+# define MEMORY_GB_ARENA_H_
+
+# include <memory_resource>
+
+# include <cstring>
+
+# include "GB_config.h"
+
+# include "common/GB_types.h"
+
+namespace GB::memory {
+
+/**
+ * @brief One contiguous cache line aligned block with WRAM, VRAM, OAM, HRAM, I/O registers and SRAM
+ *
+ * @details Devices hold views (see dbuffer_t::view) of their regions, so creation of
+ *          a machine costs one allocation, and a snapshot of the whole machine memory
+ *          is one memcpy. Layout of fixed regions is known at compile time for the mode,
+ *          cartridge RAM goes last, because its size depends on the cartridge.
+ *          Arena is allocated from a memory resource, so arenas of many machines can
+ *          be packed into huge pages (see hugepage_resource_t).
+ *          Arena is not copyable and not movable, because devices point into it.
+ */
+template <GBModeFlag _Mode>
+class Arena {
+ public:
+    enum Region : unsigned {
+        WRAM_REGION = 0,
+        VRAM_REGION,
+        OAM_REGION,
+        HRAM_REGION,
+        IO_REGION,
+        SRAM_REGION,
+        REGIONS_NUM
+    };
+
+    constexpr static size_t CACHE_LINE_SIZE = 64;
+    constexpr static size_t IO_REGS_SIZE = 128_Bytes;   ///< [FF00:FF7F]
+
+    /** Offset of the region in the arena (every region starts at a cache line) */
+    constexpr static inline size_t region_offset(Region region);
+
+    /** Size of the fixed region (SRAM size is known at runtime only) */
+    constexpr static inline size_t region_size(Region region);
+
+ protected:
+    constexpr static inline size_t __align_up(size_t size);
+
+    dbuffer_t   __data;
+    size_t      __sram_size;
+    size_t      __size;
+
+ public:
+    /**
+     * @brief Allocate zeroed arena
+     * @param[in] sram_size size of cartridge RAM
+     * @param[in] resource memory resource, which must outlive the arena
+     */
+    explicit
+    Arena(size_t sram_size = 0, std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+    : __data(region_offset(SRAM_REGION) + __align_up(sram_size), resource, CACHE_LINE_SIZE)
+    , __sram_size(sram_size)
+    , __size(region_offset(SRAM_REGION) + __align_up(sram_size)) {
+        std::memset(__data.get_data_addr(), 0x0, __size);
+    }
+
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    /** Get view of the region memory */
+    inline dbuffer_t view(Region region);
+
+    /** Get host address of the region */
+    inline byte_t* get_region_addr(Region region);
+
+    /** Get host address of the arena */
+    inline byte_t* get_data_addr() { return __data.get_data_addr(); }
+    inline const byte_t* get_data_addr() const { return __data.get_data_addr(); }
+
+    /** Get size of the whole arena */
+    inline size_t size() const { return __size; }
+
+    /** Get size of cartridge RAM region */
+    inline size_t get_sram_size() const { return __sram_size; }
+
+    /**
+     * @brief Copy whole arena to the buffer
+     * @details Owning buffer is reallocated if its size differs, view must have the arena size.
+     */
+    inline void save(dbuffer_t& snapshot) const;
+
+    /**
+     * @brief Restore whole arena from the buffer, which was made by save()
+     * @return false if the buffer size differs from the arena size (arena isn't changed)
+     */
+    inline bool load(const dbuffer_t& snapshot);
+};
+
+template <GBModeFlag _Mode>
+constexpr inline size_t
+Arena<_Mode>::__align_up(size_t size) {
+    return (size + CACHE_LINE_SIZE - 1) & ~(CACHE_LINE_SIZE - 1);
+}
+
+template <GBModeFlag _Mode>
+constexpr inline size_t
+Arena<_Mode>::region_size(Region region) {
+    switch (region) {
+        case WRAM_REGION:   return wram_size(_Mode);
+        case VRAM_REGION:   return vram_size(_Mode);
+        case OAM_REGION:    return ORAM_SIZE;
+        case HRAM_REGION:   return HRAM_SIZE;
+        case IO_REGION:     return IO_REGS_SIZE;
+        default:            return 0;
+    }
+}
+
+template <GBModeFlag _Mode>
+constexpr inline size_t
+Arena<_Mode>::region_offset(Region region) {
+    size_t offset = 0;
+    for (unsigned idx = WRAM_REGION; idx < region; ++idx)
+        offset += __align_up(region_size(Region(idx)));
+    return offset;
+}
+
+template <GBModeFlag _Mode>
+inline byte_t*
+Arena<_Mode>::get_region_addr(Region region) {
+    return __data.get_data_addr() + region_offset(region);
+}
+
+template <GBModeFlag _Mode>
+inline dbuffer_t
+Arena<_Mode>::view(Region region) {
+    const size_t size = (region == SRAM_REGION) ? __sram_size : region_size(region);
+    return dbuffer_t::view(get_region_addr(region), size);
+}
+
+template <GBModeFlag _Mode>
+inline void
+Arena<_Mode>::save(dbuffer_t& snapshot) const {
+    if (snapshot.size() != __size)
+        snapshot = dbuffer_t(__size, snapshot.get_memory_resource(), snapshot.get_alignment());
+    std::memcpy(snapshot.get_data_addr(), __data.get_data_addr(), __size);
+}
+
+template <GBModeFlag _Mode>
+inline bool
+Arena<_Mode>::load(const dbuffer_t& snapshot) {
+    if (snapshot.size() != __size)
+        return false;
+    std::memcpy(__data.get_data_addr(), snapshot.get_data_addr(), __size);
+    return true;
+}
+
+}  // namespace GB::memory
+
+#endif  // MEMORY_GB_ARENA_H_
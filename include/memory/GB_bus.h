@@ -0,0 +1,239 @@
+/**
+ * @file GB_bus.h
+ * @brief Describes memory bus with page table dispatching
+ */
+
+#ifndef MEMORY_GB_BUS_H_
+# define MEMORY_GB_BUS_H_
+
+# include <array>
+# include <bitset>
+# include <cstddef>
+# include <memory>
+
+# include "common/GB_types.h"
+
+# include "memory/GB_vaddr.h"
+
+namespace GB::memory {
+
+/**
+ * @brief Memory bus of the GameBoy, which maps 64 KiB virtual address space to devices
+ *
+ * @details Address space is split into 256 pages of 256 bytes. Each page is described by a slot:
+ *          - slot with a host pointer is served by a plain load/store, without any indirect call
+ *            (WRAM, VRAM, ROM banks ...)
+ *          - slot without a host pointer is served by page read/write commands
+ *          - page with per-address cells (OAM, I/O + HRAM page) is served by a cell, which could
+ *            also have a host pointer to a byte, or read/write commands of some device register
+ *
+ *          Unmapped addresses are read as OPEN_BUS_VALUE and writes to them are ignored.
+ *
+ *          Pages could be locked by a bus master (OAM DMA), so CPU access goes to the master
+ *          handlers. Locked pages are served by the lock view: a second page table, which has
+ *          master slots for locked pages and mirrors device mapping of other pages. Lock and
+ *          unlock switch the table, so devices remap pages as usual, the master reads them
+ *          through read_unlocked(), and repeated locks of the same pages cost no page copies.
+ */
+class BusInterface {
+ public:
+    using ReadCmd   = byte_t (*)(void* owner, word_t vaddr);              ///< device read handler
+    using WriteCmd  = void (*)(void* owner, word_t vaddr, byte_t data);   ///< device write handler
+    using SyncCmd   = void (*)(void* owner);                              ///< lock owner sync handler
+
+    constexpr static unsigned PAGE_SIZE = 0x100;
+    constexpr static unsigned PAGES_NUM = 0x100;
+    constexpr static unsigned PAGE_OFFSET_MASK = PAGE_SIZE - 1;
+    constexpr static unsigned PAGE_IDX_SHIFT = 8;
+
+    constexpr static byte_t OPEN_BUS_VALUE = 0xFF;
+
+    using PageSet = std::bitset<PAGES_NUM>;     ///< bit n is set for page n
+
+ protected:
+    /**
+     * @brief Description of a page or a single address (cell) mapping
+     *
+     * @details For a page rd_host/wr_host point to the first byte of the page,
+     *          for a cell they point to the byte of the cell.
+     */
+    struct Slot {
+        const byte_t*   rd_host;
+        byte_t*         wr_host;
+        ReadCmd         rd_cmd;
+        WriteCmd        wr_cmd;
+        void*           owner;
+    };
+
+    using Cells = std::array<Slot, PAGE_SIZE>;
+
+    /** Device mapping */
+    std::array<Slot, PAGES_NUM>                     __pages;
+    std::array<std::unique_ptr<Cells>, PAGES_NUM>   __cells;
+
+    /** Lock view: master slot for locked pages and device mapping of other pages */
+    std::array<Slot, PAGES_NUM>                     __lock_pages;
+    std::array<const Cells*, PAGES_NUM>             __lock_cells;
+    PageSet                                         __lock_set;
+    Slot                                            __lock_slot;
+    SyncCmd                                         __lock_sync_cmd;
+    bool                                            __is_lock_active;
+
+    const Slot*                                     __view_pages;   ///< pages, which serve CPU access
+
+ protected:
+    static byte_t __read_open_bus(void*, word_t);
+    static void __write_ignore(void*, word_t, byte_t);
+
+    constexpr static unsigned __page_idx(word_t vaddr) { return vaddr >> PAGE_IDX_SHIFT; }
+    constexpr static unsigned __page_offset(word_t vaddr) { return vaddr & PAGE_OFFSET_MASK; }
+
+    static Cells& __get_cells(Slot& page, std::unique_ptr<Cells>& cells);
+    void __map(word_t base_vaddr, word_t last_vaddr, const Slot& proto);
+    void __sync_lock_owner();
+    void __update_lock_view(unsigned page_idx);
+
+    byte_t __read_slow(word_t vaddr) const;
+    void __write_slow(word_t vaddr, byte_t data);
+
+ public:
+    BusInterface();
+    BusInterface(const BusInterface&) = delete;
+    BusInterface& operator=(const BusInterface&) = delete;
+
+    /**
+     * @brief Map a single virtual address to a device register
+     * @param[in] vaddr virtual address
+     * @param[in] rd_cmd read handler, called with owner and vaddr
+     * @param[in] wr_cmd write handler, called with owner, vaddr and data
+     * @param[in] owner device which handles access
+     */
+    void MapVAddr(word_t vaddr, ReadCmd rd_cmd, WriteCmd wr_cmd, void* owner);
+
+    /**
+     * @brief Map a range [base_vaddr:last_vaddr] to read/write handlers of a device
+     */
+    void MapVAddr(word_t base_vaddr, word_t last_vaddr, ReadCmd rd_cmd, WriteCmd wr_cmd, void* owner);
+
+    /**
+     * @brief Map a range [base_vaddr:last_vaddr] directly to the host memory
+     * @param[in] host address of host memory which corresponds to base_vaddr
+     *
+     * @details Access to mapped range costs a single load/store. Device must remap
+     *          range, if host memory changes (bank switching for example).
+     */
+    void MapMemory(word_t base_vaddr, word_t last_vaddr, byte_t* host);
+
+    /**
+     * @brief Map a range [base_vaddr:last_vaddr] to the host memory for reading only
+     * @param[in] host address of host memory which corresponds to base_vaddr
+     * @param[in] wr_cmd write handler (nullptr if writes must be ignored)
+     * @param[in] owner device which handles writes
+     */
+    void MapMemory(word_t base_vaddr, word_t last_vaddr, const byte_t* host, WriteCmd wr_cmd, void* owner);
+
+    /**
+     * @brief Unmap range [base_vaddr:last_vaddr]
+     */
+    void Unmap(word_t base_vaddr, word_t last_vaddr);
+
+    /** Get set of pages, which cover range [base_vaddr:last_vaddr] */
+    static inline PageSet get_page_set(word_t base_vaddr, word_t last_vaddr);
+
+    /**
+     * @brief Lock pages, so access to them goes to the handlers of the lock owner
+     *
+     * @details There is one lock owner at a time, and the new lock replaces the previous one.
+     *          Lock owner is synchronized (see sync_cmd) before any remap of locked pages,
+     *          so it could read them lazily.
+     *
+     * @param[in] pages set of locked pages
+     * @param[in] rd_cmd read handler (nullptr if locked pages are read as OPEN_BUS_VALUE)
+     * @param[in] wr_cmd write handler (nullptr if writes must be ignored)
+     * @param[in] sync_cmd lock owner synchronization handler (nullptr if not needed)
+     */
+    void Lock(const PageSet& pages, ReadCmd rd_cmd, WriteCmd wr_cmd, SyncCmd sync_cmd, void* owner);
+
+    /** Unlock all pages */
+    void Unlock();
+
+    inline bool is_locked(word_t vaddr) const { return __is_lock_active && __lock_set[__page_idx(vaddr)]; }
+
+    /** Read a byte from the device mapped to virtual address, even if the page is locked */
+    byte_t read_unlocked(word_t vaddr) const;
+
+    /**
+     * @brief Copy range [vaddr:vaddr + len) from the devices mapped to it, even if pages are locked
+     * @details Pages mapped to host memory are copied at once, other addresses are read byte by byte.
+     *          Range wraps at the end of the address space.
+     */
+    void read_block(word_t vaddr, byte_t* dst, size_t len) const;
+
+    /**
+     * @brief Get host address of the byte in the page, which is mapped to host memory for reading
+     * @return host address (even if the page is locked) or nullptr if the page isn't mapped
+     *         to host memory as a whole
+     */
+    const byte_t* get_read_host(word_t vaddr) const;
+
+    /** Read a byte from virtual address */
+    inline byte_t read(word_t vaddr) const;
+
+    /** Write a byte to virtual address */
+    inline void write(word_t vaddr, byte_t data);
+};
+
+inline BusInterface::PageSet
+BusInterface::get_page_set(word_t base_vaddr, word_t last_vaddr) {
+    PageSet pages;
+    for (unsigned page_idx = __page_idx(base_vaddr); page_idx <= __page_idx(last_vaddr); ++page_idx)
+        pages.set(page_idx);
+    return pages;
+}
+
+inline byte_t
+BusInterface::read(word_t vaddr) const {
+    const Slot& page = __view_pages[__page_idx(vaddr)];
+    if (page.rd_host != nullptr)
+        return page.rd_host[__page_offset(vaddr)];
+    return __read_slow(vaddr);
+}
+
+inline void
+BusInterface::write(word_t vaddr, byte_t data) {
+    const Slot& page = __view_pages[__page_idx(vaddr)];
+    if (page.wr_host != nullptr) {
+        page.wr_host[__page_offset(vaddr)] = data;
+        return;
+    }
+    __write_slow(vaddr, data);
+}
+
+inline byte_t
+BusInterface::__read_slow(word_t vaddr) const {
+    const unsigned page_idx = __page_idx(vaddr);
+    const Cells* cells = __is_lock_active ? __lock_cells[page_idx] : __cells[page_idx].get();
+    const Slot& slot = (cells != nullptr) ? (*cells)[__page_offset(vaddr)] : __view_pages[page_idx];
+
+    // NOTE: page slot without cells has no host pointer here, so only a cell could be served by a load
+    if (slot.rd_host != nullptr)
+        return *slot.rd_host;
+    return slot.rd_cmd(slot.owner, vaddr);
+}
+
+inline void
+BusInterface::__write_slow(word_t vaddr, byte_t data) {
+    const unsigned page_idx = __page_idx(vaddr);
+    const Cells* cells = __is_lock_active ? __lock_cells[page_idx] : __cells[page_idx].get();
+    const Slot& slot = (cells != nullptr) ? (*cells)[__page_offset(vaddr)] : __view_pages[page_idx];
+
+    if (slot.wr_host != nullptr) {
+        *slot.wr_host = data;
+        return;
+    }
+    slot.wr_cmd(slot.owner, vaddr, data);
+}
+
+}  // namespace GB::memory
+
+#endif  // MEMORY_GB_BUS_H_
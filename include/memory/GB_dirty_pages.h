@@ -0,0 +1,108 @@
+/**
+ * @file GB_dirty_pages.h
+ * @brief Describes bitmap of modified pages of device memory
+ */
+
+#ifndef MEMORY_GB_DIRTY_PAGES_H_
+# define MEMORY_GB_DIRTY_PAGES_H_
+
+# include <bitset>
+# include <cstddef>
+
+# include "common/GB_types.h"
+
+# include "memory/GB_bus.h"
+
+namespace GB::memory {
+
+/**
+ * @brief Bitmap of device memory pages, which are written since the last clear()
+ *
+ * @details Page is a bus page (BusInterface::PAGE_SIZE bytes of physical memory), so bus
+ *          writes are tracked by mapping: device maps clean pages for reading only, the first
+ *          write of a page goes through the device, which marks the page and maps it directly
+ *          to the host memory. So writes to dirty pages cost a plain store, and a consumer
+ *          (incremental snapshot, state hash) touches only the marked pages.
+ *          Memory is dirty until the first clear(), because nobody has seen it yet.
+ */
+template <size_t _MemorySize>
+class DirtyPages {
+ public:
+    constexpr static unsigned PAGE_SIZE = BusInterface::PAGE_SIZE;
+    constexpr static unsigned PAGE_IDX_SHIFT = BusInterface::PAGE_IDX_SHIFT;
+    constexpr static size_t PAGES_NUM = (_MemorySize + PAGE_SIZE - 1) / PAGE_SIZE;
+
+    using PageSet = std::bitset<PAGES_NUM>;     ///< bit n is set for page n
+
+ protected:
+    PageSet __pages;
+
+ public:
+    DirtyPages() : __pages() { __pages.set(); }
+
+    inline static u32 page_idx(u32 phys_addr) { return phys_addr >> PAGE_IDX_SHIFT; }
+
+    inline bool is_dirty(u32 page) const { return __pages[page]; }
+    inline bool any() const { return __pages.any(); }
+    inline const PageSet& get() const { return __pages; }
+
+    /** Mark page of the address, returns true if it was clean (so its mapping is changed) */
+    inline bool mark(u32 phys_addr);
+
+    /** Mark pages of a block [phys_addr:phys_addr + len), returns true if any of them was clean */
+    inline bool mark_block(u32 phys_addr, size_t len);
+
+    inline void mark_all() { __pages.set(); }
+    inline void clear() { __pages.reset(); }
+
+    /**
+     * @brief Call map(first_page, last_page, is_dirty) for every run of pages [first_page:last_page]
+     *        with the same state, so clean (or dirty) memory is remapped at once
+     */
+    template <typename _Map>
+    inline void for_each_run(u32 first_page, u32 last_page, _Map&& map) const;
+};
+
+template <size_t _MemorySize>
+inline bool
+DirtyPages<_MemorySize>::mark(u32 phys_addr) {
+    const u32 page = page_idx(phys_addr);
+
+    if (__pages[page])
+        return false;
+    __pages.set(page);
+    return true;
+}
+
+template <size_t _MemorySize>
+inline bool
+DirtyPages<_MemorySize>::mark_block(u32 phys_addr, size_t len) {
+    bool is_changed = false;
+
+    if (len == 0)
+        return false;
+    for (u32 page = page_idx(phys_addr); page <= page_idx(phys_addr + len - 1); ++page) {
+        is_changed = is_changed || !__pages[page];
+        __pages.set(page);
+    }
+    return is_changed;
+}
+
+template <size_t _MemorySize>
+template <typename _Map>
+inline void
+DirtyPages<_MemorySize>::for_each_run(u32 first_page, u32 last_page, _Map&& map) const {
+    while (first_page <= last_page) {
+        const bool is_run_dirty = __pages[first_page];
+        u32 run_last = first_page;
+
+        while (run_last < last_page && __pages[run_last + 1] == is_run_dirty)
+            ++run_last;
+        map(first_page, run_last, is_run_dirty);
+        first_page = run_last + 1;
+    }
+}
+
+}  // namespace GB::memory
+
+#endif  // MEMORY_GB_DIRTY_PAGES_H_
@@ -120,7 +120,7 @@ enum VirtualAddress : word_t {
 
     /* High stack RAM */
     HRAM_BASE_VADDR = 0xFF80,
-    HRAM_LAST_VADDR = 0xFFEF,
+    HRAM_LAST_VADDR = 0xFFFE,
 
     /* Cartrige ROM */
     ROM0_BASE_VADDR = 0x0000,
@@ -0,0 +1,179 @@
+#include <algorithm>
+#include <cstring>
+
+#include "memory/GB_bus.h"
+
+namespace GB::memory {
+
+using Bus = BusInterface;
+
+byte_t Bus::__read_open_bus(void*, word_t) {
+    return OPEN_BUS_VALUE;
+}
+
+void Bus::__write_ignore(void*, word_t, byte_t) {}
+
+Bus::BusInterface() : __pages(), __cells(), __lock_pages(), __lock_cells(), __lock_set()
+                     , __lock_slot{nullptr, nullptr, &__read_open_bus, &__write_ignore, nullptr}
+                     , __lock_sync_cmd(nullptr), __is_lock_active(false), __view_pages(__pages.data()) {
+    Unmap(0x0000, 0xFFFF);
+}
+
+Bus::Cells& Bus::__get_cells(Slot& page, std::unique_ptr<Cells>& page_cells) {
+    if (page_cells == nullptr) {
+        // split the page into cells, which inherit mapping of the page
+        page_cells = std::make_unique<Cells>();
+
+        Cells& cells = *page_cells;
+        for (unsigned offset = 0; offset < PAGE_SIZE; ++offset) {
+            cells[offset] = page;
+            cells[offset].rd_host = (page.rd_host != nullptr) ? page.rd_host + offset : nullptr;
+            cells[offset].wr_host = (page.wr_host != nullptr) ? page.wr_host + offset : nullptr;
+        }
+
+        // page with cells is always served by the slow path
+        page = Slot{nullptr, nullptr, &__read_open_bus, &__write_ignore, nullptr};
+    }
+    return *page_cells;
+}
+
+void Bus::__sync_lock_owner() {
+    // lock owner could remap pages during synchronization
+    const SyncCmd sync_cmd = __lock_sync_cmd;
+
+    if (sync_cmd != nullptr) {
+        __lock_sync_cmd = nullptr;
+        sync_cmd(__lock_slot.owner);
+        __lock_sync_cmd = sync_cmd;
+    }
+}
+
+void Bus::__update_lock_view(unsigned page_idx) {
+    if (__lock_set[page_idx]) {
+        __lock_pages[page_idx] = __lock_slot;
+        __lock_cells[page_idx] = nullptr;
+    } else {
+        __lock_pages[page_idx] = __pages[page_idx];
+        __lock_cells[page_idx] = __cells[page_idx].get();
+    }
+}
+
+void Bus::__map(word_t base_vaddr, word_t last_vaddr, const Slot& proto) {
+    auto shifted = [&proto, base_vaddr](unsigned vaddr) {
+        const unsigned offset = vaddr - base_vaddr;
+        return Slot {
+            (proto.rd_host != nullptr) ? proto.rd_host + offset : nullptr,
+            (proto.wr_host != nullptr) ? proto.wr_host + offset : nullptr,
+            proto.rd_cmd, proto.wr_cmd, proto.owner
+        };
+    };
+
+    unsigned vaddr = base_vaddr;
+    while (vaddr <= last_vaddr) {
+        const unsigned page_idx = __page_idx(vaddr);
+        const unsigned page_last = vaddr | PAGE_OFFSET_MASK;
+        Slot& page = __pages[page_idx];
+
+        if (is_locked(vaddr))
+            __sync_lock_owner();
+
+        if (__page_offset(vaddr) == 0 && page_last <= last_vaddr) {
+            // whole page is covered by the range
+            __cells[page_idx].reset();
+            page = shifted(vaddr);
+            vaddr = page_last + 1;
+        } else {
+            Cells& cells = __get_cells(page, __cells[page_idx]);
+            for (; vaddr <= last_vaddr && vaddr <= page_last; ++vaddr) {
+                cells[__page_offset(vaddr)] = shifted(vaddr);
+            }
+        }
+        __update_lock_view(page_idx);
+    }
+}
+
+void Bus::MapVAddr(word_t vaddr, ReadCmd rd_cmd, WriteCmd wr_cmd, void* owner) {
+    MapVAddr(vaddr, vaddr, rd_cmd, wr_cmd, owner);
+}
+
+void Bus::MapVAddr(word_t base_vaddr, word_t last_vaddr, ReadCmd rd_cmd, WriteCmd wr_cmd, void* owner) {
+    __map(base_vaddr, last_vaddr, Slot{nullptr, nullptr, rd_cmd, wr_cmd, owner});
+}
+
+void Bus::MapMemory(word_t base_vaddr, word_t last_vaddr, byte_t* host) {
+    __map(base_vaddr, last_vaddr, Slot{host, host, &__read_open_bus, &__write_ignore, nullptr});
+}
+
+void Bus::MapMemory(word_t base_vaddr, word_t last_vaddr, const byte_t* host, WriteCmd wr_cmd, void* owner) {
+    wr_cmd = (wr_cmd != nullptr) ? wr_cmd : &__write_ignore;
+    __map(base_vaddr, last_vaddr, Slot{host, nullptr, &__read_open_bus, wr_cmd, owner});
+}
+
+void Bus::Unmap(word_t base_vaddr, word_t last_vaddr) {
+    __map(base_vaddr, last_vaddr, Slot{nullptr, nullptr, &__read_open_bus, &__write_ignore, nullptr});
+}
+
+void Bus::Lock(const PageSet& pages, ReadCmd rd_cmd, WriteCmd wr_cmd, SyncCmd sync_cmd, void* owner) {
+    rd_cmd = (rd_cmd != nullptr) ? rd_cmd : &__read_open_bus;
+    wr_cmd = (wr_cmd != nullptr) ? wr_cmd : &__write_ignore;
+
+    // lock view is kept after unlock, so only pages with changed lock state are updated
+    const bool is_slot_changed = (rd_cmd != __lock_slot.rd_cmd || wr_cmd != __lock_slot.wr_cmd
+                               || owner != __lock_slot.owner);
+    const PageSet changed_pages = is_slot_changed ? (pages | __lock_set) : (pages ^ __lock_set);
+
+    __lock_slot = Slot{nullptr, nullptr, rd_cmd, wr_cmd, owner};
+    __lock_set = pages;
+    if (changed_pages.any()) {
+        for (unsigned page_idx = 0; page_idx < PAGES_NUM; ++page_idx) {
+            if (changed_pages[page_idx])
+                __update_lock_view(page_idx);
+        }
+    }
+
+    __lock_sync_cmd = sync_cmd;
+    __is_lock_active = true;
+    __view_pages = __lock_pages.data();
+}
+
+void Bus::Unlock() {
+    __lock_sync_cmd = nullptr;
+    __is_lock_active = false;
+    __view_pages = __pages.data();
+}
+
+byte_t Bus::read_unlocked(word_t vaddr) const {
+    const Cells* cells = __cells[__page_idx(vaddr)].get();
+    const Slot& slot = (cells != nullptr) ? (*cells)[__page_offset(vaddr)] : __pages[__page_idx(vaddr)];
+
+    if (slot.rd_host != nullptr)
+        return (cells != nullptr) ? *slot.rd_host : slot.rd_host[__page_offset(vaddr)];
+    return slot.rd_cmd(slot.owner, vaddr);
+}
+
+void Bus::read_block(word_t vaddr, byte_t* dst, size_t len) const {
+    while (len != 0) {
+        const size_t chunk = std::min<size_t>(len, PAGE_SIZE - __page_offset(vaddr));
+        const byte_t* const host = get_read_host(vaddr);
+
+        if (host != nullptr) {
+            std::memcpy(dst, host, chunk);
+        } else {
+            for (size_t offset = 0; offset < chunk; ++offset)
+                dst[offset] = read_unlocked(word_t(vaddr + offset));
+        }
+        vaddr = word_t(vaddr + chunk);
+        dst += chunk;
+        len -= chunk;
+    }
+}
+
+const byte_t* Bus::get_read_host(word_t vaddr) const {
+    const Slot& page = __pages[__page_idx(vaddr)];
+
+    if (__cells[__page_idx(vaddr)] != nullptr || page.rd_host == nullptr)
+        return nullptr;
+    return page.rd_host + __page_offset(vaddr);
+}
+
+}  // namespace GB::memory
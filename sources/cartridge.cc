@@ -0,0 +1,88 @@
+#include <cstring>
+
+#include "device/GB_cartridge.h"
+#include "memory/GB_vaddr.h"
+
+namespace GB::device {
+
+static void write_trapped_sram(void* dev, word_t vaddr, byte_t value) {
+    static_cast<Cartridge*>(dev)->write_sram_phys_addr(vaddr - memory::SRAM_BASE_VADDR, value);
+}
+
+Cartridge::Cartridge(dbuffer_t rom) : Cartridge(std::move(rom), dbuffer_t()) {}
+
+Cartridge::Cartridge(dbuffer_t rom, dbuffer_t sram)
+: __rom(std::move(rom))
+, __sram(std::move(sram))
+, __bus_link(nullptr)
+, __dirty_pages() {
+    if (__rom.size() < MIN_ROM_SIZE) {
+        dbuffer_t padded(MIN_ROM_SIZE);
+
+        std::memset(padded.get_data_addr(), ROM_FILL_VALUE, padded.size());
+        if (__rom.size() != 0)
+            std::memcpy(padded.get_data_addr(), __rom.get_data_addr(), __rom.size());
+        __rom = std::move(padded);
+    }
+}
+
+unsigned Cartridge::sram_size(const dbuffer_t& rom) {
+    if (rom.size() <= RAM_SIZE_VADDR)
+        return 0;
+
+    switch (rom[RAM_SIZE_VADDR]) {
+        case 0x01:  return 2_KBytes;
+        case 0x02:  return 8_KBytes;
+        case 0x03:  return 32_KBytes;
+        case 0x04:  return 128_KBytes;
+        case 0x05:  return 64_KBytes;
+        default:    return 0;
+    }
+}
+
+/** Dirty pages are mapped directly to the host memory, clean pages are mapped for reading only */
+void Cartridge::__map_sram() {
+    const unsigned window = __get_sram_window_size();
+    byte_t* const sram = __sram.get_data_addr();
+
+    auto map_run = [this, sram](u32 run_first, u32 run_last, bool is_dirty) {
+        const u32 offset = run_first * DirtyPages::PAGE_SIZE;
+        const word_t base = word_t(memory::SRAM_BASE_VADDR + offset);
+        const word_t last = word_t(memory::SRAM_BASE_VADDR + (run_last + 1) * DirtyPages::PAGE_SIZE - 1);
+
+        if (is_dirty) {
+            __bus_link->MapMemory(base, last, sram + offset);
+        } else {
+            __bus_link->MapMemory(base, last, sram + offset
+                                , memory::BusInterface::WriteCmd(write_trapped_sram), this);
+        }
+    };
+
+    if (window != 0)
+        __dirty_pages.for_each_run(0, DirtyPages::page_idx(window - 1), map_run);
+}
+
+void Cartridge::clear_dirty_pages() {
+    __dirty_pages.clear();
+    if (__bus_link != nullptr)
+        __map_sram();
+}
+
+void Cartridge::mark_dirty_pages() {
+    if (__dirty_pages.get().all())
+        return;
+    __dirty_pages.mark_all();
+    if (__bus_link != nullptr)
+        __map_sram();
+}
+
+void Cartridge::map_to_memory(memory::BusInterface& mem_bus) {
+    const byte_t* const rom = __rom.get_data_addr();
+
+    __bus_link = &mem_bus;
+    mem_bus.MapMemory(memory::ROM0_BASE_VADDR, memory::ROM0_LAST_VADDR, rom, nullptr, nullptr);
+    mem_bus.MapMemory(memory::ROMX_BASE_VADDR, memory::ROMX_LAST_VADDR, rom + ROM_BANK_SIZE, nullptr, nullptr);
+    __map_sram();
+}
+
+}  // namespace GB::device
@@ -0,0 +1,981 @@
+#include <array>
+#include <memory>
+#include <utility>
+
+#include "core/GB_cpu.h"
+
+#include "memory/GB_vaddr.h"
+
+namespace GB::core {
+
+using IC = device::InterruptController;
+using Bus = memory::BusInterface;
+using Vaddr = memory::VirtualAddress;
+
+/**
+ * Opcode prices in M-cycles: conditional branches aren't taken, and CB-prefixed opcodes
+ * pay for the prefix fetch here
+ */
+constexpr static u8 OPCODE_MCYCLES[] = {
+//  x0 x1 x2 x3 x4 x5 x6 x7 x8 x9 xA xB xC xD xE xF
+    1, 3, 2, 2, 1, 1, 2, 1, 5, 2, 2, 2, 1, 1, 2, 1,     // 0x
+    1, 3, 2, 2, 1, 1, 2, 1, 3, 2, 2, 2, 1, 1, 2, 1,     // 1x
+    2, 3, 2, 2, 1, 1, 2, 1, 2, 2, 2, 2, 1, 1, 2, 1,     // 2x
+    2, 3, 2, 2, 3, 3, 3, 1, 2, 2, 2, 2, 1, 1, 2, 1,     // 3x
+    1, 1, 1, 1, 1, 1, 2, 1, 1, 1, 1, 1, 1, 1, 2, 1,     // 4x
+    1, 1, 1, 1, 1, 1, 2, 1, 1, 1, 1, 1, 1, 1, 2, 1,     // 5x
+    1, 1, 1, 1, 1, 1, 2, 1, 1, 1, 1, 1, 1, 1, 2, 1,     // 6x
+    2, 2, 2, 2, 2, 2, 1, 2, 1, 1, 1, 1, 1, 1, 2, 1,     // 7x
+    1, 1, 1, 1, 1, 1, 2, 1, 1, 1, 1, 1, 1, 1, 2, 1,     // 8x
+    1, 1, 1, 1, 1, 1, 2, 1, 1, 1, 1, 1, 1, 1, 2, 1,     // 9x
+    1, 1, 1, 1, 1, 1, 2, 1, 1, 1, 1, 1, 1, 1, 2, 1,     // Ax
+    1, 1, 1, 1, 1, 1, 2, 1, 1, 1, 1, 1, 1, 1, 2, 1,     // Bx
+    2, 3, 3, 4, 3, 4, 2, 4, 2, 4, 3, 1, 3, 6, 2, 4,     // Cx
+    2, 3, 3, 1, 3, 4, 2, 4, 2, 4, 3, 1, 3, 1, 2, 4,     // Dx
+    3, 3, 2, 1, 1, 4, 2, 4, 4, 1, 4, 1, 1, 1, 2, 4,     // Ex
+    3, 3, 2, 1, 1, 4, 2, 4, 3, 2, 4, 1, 1, 1, 2, 4,     // Fx
+};
+
+/** Extra cycles of taken conditional branches */
+constexpr static clk_cycle_t JUMP_TAKEN_CYCLES = 1_MCycles;
+constexpr static clk_cycle_t CALL_TAKEN_CYCLES = 3_MCycles;
+constexpr static clk_cycle_t RET_TAKEN_CYCLES = 3_MCycles;
+
+/** CB-prefixed opcode price in M-cycles (after the prefix) */
+constexpr static u8
+cb_opcode_mcycles(byte_t opcode) {
+    if ((opcode & 0b111) != 0b110)
+        return 1;
+    return ((opcode >> 6) == 0b01) ? 2 : 3;     // BIT (HL) doesn't write back
+}
+
+/** Block limits: micro-ops of a block, and micro-ops and blocks of the cache before it's dropped */
+constexpr static u32 BLOCK_MAX_OPS = 32;
+constexpr static u32 BLOCK_CACHE_MAX_OPS = 32768;
+constexpr static u32 BLOCK_CACHE_MAX_BLOCKS = BLOCK_CACHE_MAX_OPS / 4;
+
+/** Pages, which blocks are decoded from: ROM, cartridge RAM and WRAM */
+constexpr static unsigned ROM_PAGES_END = Vaddr::VRAM_BASE_VADDR >> Bus::PAGE_IDX_SHIFT;
+constexpr static unsigned RAM_FIRST_PAGE = Vaddr::SRAM_BASE_VADDR >> Bus::PAGE_IDX_SHIFT;
+
+/** Echo pages mirror WRAM pages */
+constexpr static unsigned WRAM_FIRST_PAGE = Vaddr::WRAM0_BASE_VADDR >> Bus::PAGE_IDX_SHIFT;
+constexpr static unsigned ECHO_FIRST_PAGE = Vaddr::WRAM0_ECHO_BASE_VADDR >> Bus::PAGE_IDX_SHIFT;
+constexpr static unsigned ECHO_LAST_PAGE = Vaddr::WRAMX_ECHO_LAST_VADDR >> Bus::PAGE_IDX_SHIFT;
+constexpr static unsigned ECHO_PAGES_OFFSET = ECHO_FIRST_PAGE - WRAM_FIRST_PAGE;
+
+/** Instruction length in bytes */
+constexpr static unsigned
+instruction_length(byte_t opcode) {
+    const unsigned x = opcode >> 6;
+    const unsigned y = (opcode >> 3) & 0b111;
+    const unsigned z = opcode & 0b111;
+
+    if (x == 0b00 && z == 0)
+        return (y == 0) ? 1 : (y == 1) ? 3 : 2;     // NOP, LD (nn),SP, STOP and JR
+    if (x == 0b00)
+        return (z == 1 && !(y & 0b1)) ? 3 : (z == 6) ? 2 : 1;
+    if (x != 0b11)
+        return 1;
+
+    switch (z) {
+        case 0: return (y < 4) ? 1 : 2;
+        case 2: return (y < 4 || (y & 0b1)) ? 3 : 1;
+        case 3: return (y == 0) ? 3 : (y == 1) ? 2 : 1;
+        case 4: return (y < 4) ? 3 : 1;
+        case 5: return (y == 1) ? 3 : 1;
+        case 6: return 2;
+        default: return 1;
+    }
+}
+
+/** Instructions, which end a block: they change PC, halt or lock CPU, or schedule IME */
+constexpr static bool
+is_block_end(byte_t opcode) {
+    const unsigned x = opcode >> 6;
+    const unsigned y = (opcode >> 3) & 0b111;
+    const unsigned z = opcode & 0b111;
+
+    if (x == 0b00)
+        return z == 0 && y >= 2;                    // STOP and JR
+    if (x != 0b11)
+        return opcode == 0x76;                      // HALT
+
+    switch (z) {
+        case 0: return y < 4;                       // RET cc
+        case 1: return (y & 0b1) && y != 7;         // RET, RETI and JP HL
+        case 2: return y < 4;                       // JP cc
+        case 3: return y != 1 && y != 6;            // JP, EI and illegal opcodes
+        case 4: return true;                        // CALL cc and illegal opcodes
+        case 5: return y & 0b1;                     // CALL and illegal opcodes
+        case 6: return false;
+        default: return true;                       // RST
+    }
+}
+
+/** Extra cycles of the instruction, if its branch is taken */
+constexpr static clk_cycle_t
+branch_taken_cycles(byte_t opcode) {
+    const unsigned x = opcode >> 6;
+    const unsigned y = (opcode >> 3) & 0b111;
+    const unsigned z = opcode & 0b111;
+
+    if (x == 0b00)
+        return (z == 0 && y >= 4) ? JUMP_TAKEN_CYCLES : 0;
+    if (x != 0b11 || y >= 4)
+        return 0;
+    return (z == 0) ? RET_TAKEN_CYCLES : (z == 2) ? JUMP_TAKEN_CYCLES : (z == 4) ? CALL_TAKEN_CYCLES : 0;
+}
+
+/**
+ * @brief Instruction handlers, which are generated from opcode bit fields
+ *
+ * @details Opcode is split into fields xx yyy zzz (yyy is pp q), where zzz and yyy select
+ *          8-bit operands (B, C, D, E, H, L, (HL), A), pp selects a register pair,
+ *          yyy selects ALU operation, rotation or bit index, and the low bits of yyy select
+ *          branch condition (NZ, Z, NC, C).
+ *
+ *          Decoded handlers take opcode operands from the micro-op instead of the fetch,
+ *          commit block cycles before accesses to OAM and I/O, and find PC set to the next
+ *          instruction (see CPU::execute_block()).
+ */
+template <bool _Decoded>
+struct CPU::__Instructions {
+    using Handler = void (*)(CPU* cpu);
+
+    enum Operand : unsigned { B_REG, C_REG, D_REG, E_REG, H_REG, L_REG, HL_PTR, A_REG };
+    enum Pair : unsigned { BC_PAIR, DE_PAIR, HL_PAIR, SP_PAIR, AF_PAIR = SP_PAIR };
+    enum Condition : unsigned { NZ_COND, Z_COND, NC_COND, C_COND, ALWAYS };
+    enum AluOp : unsigned { ADD_OP, ADC_OP, SUB_OP, SBC_OP, AND_OP, XOR_OP, OR_OP, CP_OP };
+    enum ShiftOp : unsigned { RLC_OP, RRC_OP, RL_OP, RR_OP, SLA_OP, SRA_OP, SWAP_OP, SRL_OP };
+
+    /** Registers of 8-bit operands ((HL) is a memory operand) */
+    constexpr static byte_t Registers::* const OPERAND_REGS[] = {
+        &Registers::B, &Registers::C, &Registers::D, &Registers::E,
+        &Registers::H, &Registers::L, nullptr, &Registers::A
+    };
+
+    /** Registers of pairs BC, DE, HL, AF (SP is a 16-bit register) */
+    constexpr static byte_t Registers::* const PAIR_MSB_REGS[] = { &Registers::B, &Registers::D, &Registers::H, &Registers::A };
+    constexpr static byte_t Registers::* const PAIR_LSB_REGS[] = { &Registers::C, &Registers::E, &Registers::L, &Registers::F };
+
+    static const std::array<Handler, 256> OPCODES;
+    static const std::array<Handler, 256> CB_OPCODES;
+
+    /* Memory access */
+
+    /** OAM and I/O are lazily synchronized with time, HRAM isn't */
+    static inline bool
+    is_synchronized(word_t vaddr) {
+        return vaddr >= Vaddr::OAM_RAM_BASE_VADDR && (vaddr < Vaddr::HRAM_BASE_VADDR || vaddr == Vaddr::IE_VADDR);
+    }
+
+    static inline byte_t
+    read(CPU* cpu, word_t vaddr) {
+        if (_Decoded && is_synchronized(vaddr))
+            cpu->__commit_block_cycles();
+        return cpu->__bus->read(vaddr);
+    }
+
+    static inline void
+    write(CPU* cpu, word_t vaddr, byte_t value) {
+        if (_Decoded && is_synchronized(vaddr))
+            cpu->__commit_block_cycles();
+        if (cpu->__ram_code_pages[vaddr >> Bus::PAGE_IDX_SHIFT])
+            cpu->__invalidate_code_page(vaddr >> Bus::PAGE_IDX_SHIFT);
+        cpu->__bus->write(vaddr, value);
+    }
+
+    static inline byte_t
+    fetch(CPU* cpu) {
+        if constexpr (_Decoded)
+            return *cpu->__operands++;
+        else
+            return read(cpu, cpu->__registers.PC++);
+    }
+
+    static inline word_t
+    fetch_word(CPU* cpu) {
+        const byte_t lsb = fetch(cpu);
+        return word_t((fetch(cpu) << 8) | lsb);
+    }
+
+    static inline void
+    push(CPU* cpu, word_t value) {
+        write(cpu, --cpu->__registers.SP, byte_t(value >> 8));
+        write(cpu, --cpu->__registers.SP, byte_t(value));
+    }
+
+    static inline word_t
+    pop(CPU* cpu) {
+        const byte_t lsb = read(cpu, cpu->__registers.SP++);
+        return word_t((read(cpu, cpu->__registers.SP++) << 8) | lsb);
+    }
+
+    /* Operands */
+
+    template <unsigned _Operand>
+    static inline byte_t
+    get_operand(CPU* cpu) {
+        if constexpr (_Operand == HL_PTR)
+            return read(cpu, cpu->__registers.get_HL());
+        else
+            return cpu->__registers.*OPERAND_REGS[_Operand];
+    }
+
+    template <unsigned _Operand>
+    static inline void
+    set_operand(CPU* cpu, byte_t value) {
+        if constexpr (_Operand == HL_PTR)
+            write(cpu, cpu->__registers.get_HL(), value);
+        else
+            cpu->__registers.*OPERAND_REGS[_Operand] = value;
+    }
+
+    /** Get register pair (BC, DE, HL, SP), or (BC, DE, HL, AF) for stack operations */
+    template <unsigned _Pair, bool _WithAF = false>
+    static inline word_t
+    get_pair(CPU* cpu) {
+        const Registers& regs = cpu->__registers;
+
+        if constexpr (_Pair == SP_PAIR && !_WithAF)
+            return regs.SP;
+        else
+            return word_t((regs.*PAIR_MSB_REGS[_Pair] << 8) | regs.*PAIR_LSB_REGS[_Pair]);
+    }
+
+    template <unsigned _Pair, bool _WithAF = false>
+    static inline void
+    set_pair(CPU* cpu, word_t value) {
+        Registers& regs = cpu->__registers;
+
+        if constexpr (_Pair == SP_PAIR && !_WithAF) {
+            regs.SP = value;
+        } else {
+            regs.*PAIR_MSB_REGS[_Pair] = byte_t(value >> 8);
+            regs.*PAIR_LSB_REGS[_Pair] = byte_t(value) & (_Pair == AF_PAIR ? F_REG_MASK : 0xFF);
+        }
+    }
+
+    static inline void
+    set_HL(CPU* cpu, word_t value) {
+        set_pair<HL_PAIR>(cpu, value);
+    }
+
+    /* Flags */
+
+    static inline byte_t
+    make_flags(bool zero, bool sub, bool half_carry, bool carry) {
+        return byte_t((zero << Z_FLAG) | (sub << N_FLAG) | (half_carry << H_FLAG) | (carry << C_FLAG));
+    }
+
+    template <unsigned _Condition>
+    static inline bool
+    check(CPU* cpu) {
+        const Registers& regs = cpu->__registers;
+
+        if constexpr (_Condition == NZ_COND) return !regs.get_flag(Z_FLAG);
+        else if constexpr (_Condition == Z_COND) return regs.get_flag(Z_FLAG);
+        else if constexpr (_Condition == NC_COND) return !regs.get_flag(C_FLAG);
+        else if constexpr (_Condition == C_COND) return regs.get_flag(C_FLAG);
+        else
+            return true;
+    }
+
+    /* Arithmetic */
+
+    static inline void
+    add(CPU* cpu, byte_t value, unsigned carry) {
+        Registers& regs = cpu->__registers;
+        const unsigned acc = regs.A;
+        const unsigned result = acc + value + carry;
+
+        regs.A = byte_t(result);
+        regs.F = make_flags(regs.A == 0, false, (acc & 0xF) + (value & 0xF) + carry > 0xF, result > 0xFF);
+    }
+
+    /** Subtract value with carry from A, and store the result if it isn't a comparison */
+    template <bool _Store>
+    static inline void
+    sub(CPU* cpu, byte_t value, unsigned carry) {
+        Registers& regs = cpu->__registers;
+        const unsigned acc = regs.A;
+        const byte_t result = byte_t(acc - value - carry);
+
+        if constexpr (_Store)
+            regs.A = result;
+        regs.F = make_flags(result == 0, true, (acc & 0xF) < (value & 0xF) + carry, acc < value + carry);
+    }
+
+    static inline void
+    logic(CPU* cpu, byte_t result, bool half_carry) {
+        cpu->__registers.A = result;
+        cpu->__registers.F = make_flags(result == 0, false, half_carry, false);
+    }
+
+    template <unsigned _AluOp>
+    static inline void
+    alu(CPU* cpu, byte_t value) {
+        const Registers& regs = cpu->__registers;
+        const unsigned carry = regs.get_flag(C_FLAG);
+
+        if constexpr (_AluOp == ADD_OP || _AluOp == ADC_OP)
+            add(cpu, value, (_AluOp == ADC_OP) ? carry : 0);
+        else if constexpr (_AluOp == SUB_OP || _AluOp == SBC_OP || _AluOp == CP_OP)
+            sub<_AluOp != CP_OP>(cpu, value, (_AluOp == SBC_OP) ? carry : 0);
+        else if constexpr (_AluOp == AND_OP)
+            logic(cpu, regs.A & value, true);
+        else if constexpr (_AluOp == XOR_OP)
+            logic(cpu, regs.A ^ value, false);
+        else
+            logic(cpu, regs.A | value, false);
+    }
+
+    template <unsigned _ShiftOp>
+    static inline byte_t
+    shift(CPU* cpu, byte_t value) {
+        constexpr bool LEFT = (_ShiftOp == RLC_OP || _ShiftOp == RL_OP || _ShiftOp == SLA_OP);
+
+        Registers& regs = cpu->__registers;
+        const unsigned carry = regs.get_flag(C_FLAG);
+        const bool carry_out = (_ShiftOp != SWAP_OP) && ::bit_n(LEFT ? 7 : 0, value);
+        byte_t result;
+
+        if constexpr (_ShiftOp == RLC_OP)
+            result = byte_t((value << 1) | carry_out);
+        else if constexpr (_ShiftOp == RRC_OP)
+            result = byte_t((value >> 1) | (carry_out << 7));
+        else if constexpr (_ShiftOp == RL_OP)
+            result = byte_t((value << 1) | carry);
+        else if constexpr (_ShiftOp == RR_OP)
+            result = byte_t((value >> 1) | (carry << 7));
+        else if constexpr (_ShiftOp == SLA_OP)
+            result = byte_t(value << 1);
+        else if constexpr (_ShiftOp == SRA_OP)
+            result = byte_t((value >> 1) | (value & 0x80));
+        else if constexpr (_ShiftOp == SWAP_OP)
+            result = byte_t((value << 4) | (value >> 4));
+        else
+            result = byte_t(value >> 1);
+
+        regs.F = make_flags(result == 0, false, false, carry_out);
+        return result;
+    }
+
+    /** RLCA, RRCA, RLA, RRA always reset Z flag */
+    template <unsigned _ShiftOp>
+    static inline void
+    shift_A(CPU* cpu) {
+        Registers& regs = cpu->__registers;
+
+        regs.A = shift<_ShiftOp>(cpu, regs.A);
+        regs.F = byte_t(::bit_n_reset(Z_FLAG, regs.F));
+    }
+
+    template <unsigned _Operand, bool _Decrement>
+    static inline void
+    inc_dec(CPU* cpu) {
+        Registers& regs = cpu->__registers;
+        const byte_t result = byte_t(get_operand<_Operand>(cpu) + (_Decrement ? -1 : 1));
+        const bool half_carry = (result & 0xF) == (_Decrement ? 0xF : 0x0);
+
+        set_operand<_Operand>(cpu, result);
+        regs.F = make_flags(result == 0, _Decrement, half_carry, regs.get_flag(C_FLAG));
+    }
+
+    static inline void
+    add_HL(CPU* cpu, word_t value) {
+        Registers& regs = cpu->__registers;
+        const unsigned hl = regs.get_HL();
+        const unsigned result = hl + value;
+
+        regs.F = make_flags(regs.get_flag(Z_FLAG), false, (hl & 0xFFF) + (value & 0xFFF) > 0xFFF, result > 0xFFFF);
+        set_HL(cpu, word_t(result));
+    }
+
+    /** SP + signed immediate (ADD SP,e and LD HL,SP+e), flags are computed for the low byte */
+    static inline word_t
+    add_SP_offset(CPU* cpu) {
+        Registers& regs = cpu->__registers;
+        const byte_t offset = fetch(cpu);
+        const unsigned sp = regs.SP;
+
+        regs.F = make_flags(false, false, (sp & 0xF) + (offset & 0xF) > 0xF, (sp & 0xFF) + offset > 0xFF);
+        return word_t(sp + i8(offset));
+    }
+
+    static inline void
+    daa(CPU* cpu) {
+        Registers& regs = cpu->__registers;
+        const bool sub = regs.get_flag(N_FLAG);
+        const bool half_carry = regs.get_flag(H_FLAG);
+        bool carry = regs.get_flag(C_FLAG);
+        unsigned correction = 0x0;
+
+        if (half_carry || (!sub && (regs.A & 0xF) > 0x9))
+            correction |= 0x06;
+        if (carry || (!sub && regs.A > 0x99)) {
+            correction |= 0x60;
+            carry = true;
+        }
+        regs.A = byte_t(sub ? regs.A - correction : regs.A + correction);
+        regs.F = make_flags(regs.A == 0, sub, false, carry);
+    }
+
+    static inline void
+    cpl(CPU* cpu) {
+        Registers& regs = cpu->__registers;
+
+        regs.A = byte_t(~regs.A);
+        regs.F = make_flags(regs.get_flag(Z_FLAG), true, true, regs.get_flag(C_FLAG));
+    }
+
+    /** SCF sets carry, CCF complements it */
+    template <bool _Set>
+    static inline void
+    set_carry(CPU* cpu) {
+        Registers& regs = cpu->__registers;
+
+        regs.F = make_flags(regs.get_flag(Z_FLAG), false, false, _Set || !regs.get_flag(C_FLAG));
+    }
+
+    /* Loads */
+
+    /** LD (nn),SP */
+    static inline void
+    store_SP(CPU* cpu) {
+        const word_t vaddr = fetch_word(cpu);
+
+        write(cpu, vaddr, byte_t(cpu->__registers.SP));
+        write(cpu, word_t(vaddr + 1), byte_t(cpu->__registers.SP >> 8));
+    }
+
+    /** LD A with (BC), (DE), (HL+), (HL-) */
+    template <unsigned _Pair, bool _Load>
+    static inline void
+    load_indirect(CPU* cpu) {
+        Registers& regs = cpu->__registers;
+        const word_t vaddr = get_pair<(_Pair < HL_PAIR) ? _Pair : unsigned(HL_PAIR)>(cpu);
+
+        if constexpr (_Pair == 2)
+            set_HL(cpu, word_t(vaddr + 1));
+        else if constexpr (_Pair == 3)
+            set_HL(cpu, word_t(vaddr - 1));
+
+        if constexpr (_Load)
+            regs.A = read(cpu, vaddr);
+        else
+            write(cpu, vaddr, regs.A);
+    }
+
+    /* Control flow */
+
+    static inline void
+    jump(CPU* cpu, word_t vaddr) {
+        cpu->__registers.PC = vaddr;
+    }
+
+    static inline void
+    call(CPU* cpu, word_t vaddr) {
+        push(cpu, cpu->__registers.PC);
+        cpu->__registers.PC = vaddr;
+    }
+
+    static inline void
+    ret(CPU* cpu) {
+        cpu->__registers.PC = pop(cpu);
+    }
+
+    /** Relative jump, taken conditional jump pays extra cycles */
+    template <unsigned _Condition>
+    static inline void
+    jr_if(CPU* cpu) {
+        const i8 offset = i8(fetch(cpu));
+        const word_t target = word_t(cpu->__registers.PC + offset);
+
+        if constexpr (_Condition == ALWAYS)
+            jump(cpu, target);
+        else if (check<_Condition>(cpu))
+            devsync::Action<JUMP_TAKEN_CYCLES>()(cpu->__clock, &jump, cpu, target);
+    }
+
+    template <unsigned _Condition>
+    static inline void
+    jp_if(CPU* cpu) {
+        const word_t target = fetch_word(cpu);
+
+        if constexpr (_Condition == ALWAYS)
+            jump(cpu, target);
+        else if (check<_Condition>(cpu))
+            devsync::Action<JUMP_TAKEN_CYCLES>()(cpu->__clock, &jump, cpu, target);
+    }
+
+    template <unsigned _Condition>
+    static inline void
+    call_if(CPU* cpu) {
+        const word_t target = fetch_word(cpu);
+
+        if constexpr (_Condition == ALWAYS)
+            call(cpu, target);
+        else if (check<_Condition>(cpu))
+            devsync::Action<CALL_TAKEN_CYCLES>()(cpu->__clock, &call, cpu, target);
+    }
+
+    template <unsigned _Condition>
+    static inline void
+    ret_if(CPU* cpu) {
+        if (check<_Condition>(cpu))
+            devsync::Action<RET_TAKEN_CYCLES>()(cpu->__clock, &ret, cpu);
+    }
+
+    /** RETI enables interrupts at once */
+    static inline void
+    reti(CPU* cpu) {
+        ret(cpu);
+        cpu->__interrupt_link->set_IME_reg(true);
+    }
+
+    /* CPU control */
+
+    static inline void
+    halt(CPU* cpu) {
+        const IC* const int_ctrl = cpu->__interrupt_link;
+
+        if (int_ctrl->get_IME_reg() || !int_ctrl->has_pending_interrupt())
+            cpu->__is_halted = true;
+        else
+            cpu->__has_halt_bug = true;
+    }
+
+    /** STOP skips the next byte, and waits for an interrupt like HALT */
+    static inline void
+    stop(CPU* cpu) {
+        fetch(cpu);
+        cpu->__is_halted = true;
+    }
+
+    static inline void
+    di(CPU* cpu) {
+        cpu->__interrupt_link->set_IME_reg(false);
+        cpu->__is_ime_scheduled = false;
+    }
+
+    static inline void
+    ei(CPU* cpu) {
+        cpu->__is_ime_scheduled = true;
+    }
+
+    static inline void
+    lock(CPU* cpu) {
+        cpu->__is_locked = true;
+    }
+
+    /* Opcodes */
+
+    template <unsigned _Y, unsigned _Z>
+    static inline void execute_block0(CPU* cpu);
+
+    template <unsigned _Y, unsigned _Z>
+    static inline void execute_block3(CPU* cpu);
+
+    template <byte_t _Opcode>
+    static void execute(CPU* cpu);
+
+    template <byte_t _Opcode>
+    static void execute_cb(CPU* cpu);
+
+    template <byte_t _Opcode>
+    static void
+    dispatch(CPU* cpu) {
+        devsync::Action<OPCODE_MCYCLES[_Opcode] * 1_MCycles>()(cpu->__clock, &execute<_Opcode>, cpu);
+    }
+
+    template <byte_t _Opcode>
+    static void
+    dispatch_cb(CPU* cpu) {
+        devsync::Action<cb_opcode_mcycles(_Opcode) * 1_MCycles>()(cpu->__clock, &execute_cb<_Opcode>, cpu);
+    }
+
+    template <size_t... _Opcodes>
+    constexpr static std::array<Handler, 256>
+    make_opcodes(std::index_sequence<_Opcodes...>) {
+        return {{ &dispatch<byte_t(_Opcodes)>... }};
+    }
+
+    template <size_t... _Opcodes>
+    constexpr static std::array<Handler, 256>
+    make_cb_opcodes(std::index_sequence<_Opcodes...>) {
+        return {{ &dispatch_cb<byte_t(_Opcodes)>... }};
+    }
+};
+
+/** Opcodes [00:3F]: 16-bit loads, INC/DEC, immediate loads, relative jumps and accumulator ops */
+template <bool _Decoded>
+template <unsigned _Y, unsigned _Z>
+inline void
+CPU::__Instructions<_Decoded>::execute_block0(CPU* cpu) {
+    constexpr unsigned P = _Y >> 1;
+    constexpr bool Q = _Y & 0b1;
+
+    if constexpr (_Z == 0 && _Y == 0)
+        return;
+    else if constexpr (_Z == 0 && _Y == 1)
+        store_SP(cpu);
+    else if constexpr (_Z == 0 && _Y == 2)
+        stop(cpu);
+    else if constexpr (_Z == 0)
+        jr_if<(_Y == 3) ? unsigned(ALWAYS) : _Y - 4>(cpu);
+    else if constexpr (_Z == 1 && !Q)
+        set_pair<P>(cpu, fetch_word(cpu));
+    else if constexpr (_Z == 1)
+        add_HL(cpu, get_pair<P>(cpu));
+    else if constexpr (_Z == 2)
+        load_indirect<P, Q>(cpu);
+    else if constexpr (_Z == 3)
+        set_pair<P>(cpu, word_t(get_pair<P>(cpu) + (Q ? -1 : 1)));
+    else if constexpr (_Z == 4 || _Z == 5)
+        inc_dec<_Y, _Z == 5>(cpu);
+    else if constexpr (_Z == 6)
+        set_operand<_Y>(cpu, fetch(cpu));
+    else if constexpr (_Y < 4)
+        shift_A<_Y>(cpu);
+    else if constexpr (_Y == 4)
+        daa(cpu);
+    else if constexpr (_Y == 5)
+        cpl(cpu);
+    else
+        set_carry<_Y == 6>(cpu);
+}
+
+/** Opcodes [C0:FF]: control flow, stack, high page loads, immediate ALU ops and CPU control */
+template <bool _Decoded>
+template <unsigned _Y, unsigned _Z>
+inline void
+CPU::__Instructions<_Decoded>::execute_block3(CPU* cpu) {
+    constexpr unsigned P = _Y >> 1;
+    constexpr bool Q = _Y & 0b1;
+
+    Registers& regs = cpu->__registers;
+
+    if constexpr (_Z == 0 && _Y < 4)
+        ret_if<_Y>(cpu);
+    else if constexpr (_Z == 0 && _Y == 4)
+        write(cpu, word_t(HIGH_PAGE_VADDR | fetch(cpu)), regs.A);
+    else if constexpr (_Z == 0 && _Y == 5)
+        regs.SP = add_SP_offset(cpu);
+    else if constexpr (_Z == 0 && _Y == 6)
+        regs.A = read(cpu, word_t(HIGH_PAGE_VADDR | fetch(cpu)));
+    else if constexpr (_Z == 0)
+        set_HL(cpu, add_SP_offset(cpu));
+    else if constexpr (_Z == 1 && !Q)
+        set_pair<P, true>(cpu, pop(cpu));
+    else if constexpr (_Z == 1 && P == 0)
+        ret(cpu);
+    else if constexpr (_Z == 1 && P == 1)
+        reti(cpu);
+    else if constexpr (_Z == 1 && P == 2)
+        jump(cpu, regs.get_HL());
+    else if constexpr (_Z == 1)
+        regs.SP = regs.get_HL();
+    else if constexpr (_Z == 2 && _Y < 4)
+        jp_if<_Y>(cpu);
+    else if constexpr (_Z == 2 && _Y == 4)
+        write(cpu, word_t(HIGH_PAGE_VADDR | regs.C), regs.A);
+    else if constexpr (_Z == 2 && _Y == 5)
+        write(cpu, fetch_word(cpu), regs.A);
+    else if constexpr (_Z == 2 && _Y == 6)
+        regs.A = read(cpu, word_t(HIGH_PAGE_VADDR | regs.C));
+    else if constexpr (_Z == 2)
+        regs.A = read(cpu, fetch_word(cpu));
+    else if constexpr (_Z == 3 && _Y == 0)
+        jp_if<ALWAYS>(cpu);
+    else if constexpr (_Z == 3 && _Y == 1)
+        CB_OPCODES[fetch(cpu)](cpu);
+    else if constexpr (_Z == 3 && _Y == 6)
+        di(cpu);
+    else if constexpr (_Z == 3 && _Y == 7)
+        ei(cpu);
+    else if constexpr (_Z == 4 && _Y < 4)
+        call_if<_Y>(cpu);
+    else if constexpr (_Z == 5 && !Q)
+        push(cpu, get_pair<P, true>(cpu));
+    else if constexpr (_Z == 5 && P == 0)
+        call_if<ALWAYS>(cpu);
+    else if constexpr (_Z == 6)
+        alu<_Y>(cpu, fetch(cpu));
+    else if constexpr (_Z == 7)
+        call(cpu, word_t(_Y << 3));
+    else
+        lock(cpu);
+}
+
+template <bool _Decoded>
+template <byte_t _Opcode>
+void
+CPU::__Instructions<_Decoded>::execute(CPU* cpu) {
+    constexpr unsigned X = _Opcode >> 6;
+    constexpr unsigned Y = (_Opcode >> 3) & 0b111;
+    constexpr unsigned Z = _Opcode & 0b111;
+
+    // LD (HL),(HL) is HALT
+    if constexpr (X == 0b01 && Y == HL_PTR && Z == HL_PTR)
+        halt(cpu);
+    else if constexpr (X == 0b01)
+        set_operand<Y>(cpu, get_operand<Z>(cpu));
+    else if constexpr (X == 0b10)
+        alu<Y>(cpu, get_operand<Z>(cpu));
+    else if constexpr (X == 0b00)
+        execute_block0<Y, Z>(cpu);
+    else
+        execute_block3<Y, Z>(cpu);
+}
+
+template <bool _Decoded>
+template <byte_t _Opcode>
+void
+CPU::__Instructions<_Decoded>::execute_cb(CPU* cpu) {
+    constexpr unsigned X = _Opcode >> 6;
+    constexpr unsigned Y = (_Opcode >> 3) & 0b111;
+    constexpr unsigned Z = _Opcode & 0b111;
+
+    Registers& regs = cpu->__registers;
+    const byte_t value = get_operand<Z>(cpu);
+
+    if constexpr (X == 0b00)
+        set_operand<Z>(cpu, shift<Y>(cpu, value));
+    else if constexpr (X == 0b01)
+        regs.F = make_flags(!::bit_n(Y, value), false, true, regs.get_flag(C_FLAG));
+    else if constexpr (X == 0b10)
+        set_operand<Z>(cpu, byte_t(::bit_n_reset(Y, value)));
+    else
+        set_operand<Z>(cpu, byte_t(::bit_n_set(Y, value)));
+}
+
+template <bool _Decoded>
+const std::array<typename CPU::__Instructions<_Decoded>::Handler, 256>
+CPU::__Instructions<_Decoded>::OPCODES = CPU::__Instructions<_Decoded>::make_opcodes(std::make_index_sequence<256>());
+
+template <bool _Decoded>
+const std::array<typename CPU::__Instructions<_Decoded>::Handler, 256>
+CPU::__Instructions<_Decoded>::CB_OPCODES = CPU::__Instructions<_Decoded>::make_cb_opcodes(std::make_index_sequence<256>());
+
+CPU::CPU(memory::BusInterface* bus, IC* ic_link, const Registers& regs)
+: __registers(regs)
+, __bus(bus)
+, __interrupt_link(ic_link)
+, __clock(0)
+, __is_halted(false)
+, __is_locked(false)
+, __is_ime_scheduled(false)
+, __has_halt_bug(false)
+, __ops()
+, __blocks()
+, __code_pages()
+, __ram_code_pages()
+, __block_scheduler(nullptr)
+, __operands(nullptr)
+, __op_clock(0)
+, __committed(0)
+, __is_block_break(false) {
+    // the whole block cache is allocated here, so running new code allocates nothing
+    __ops.reserve(BLOCK_CACHE_MAX_OPS);
+    __blocks.reserve(BLOCK_CACHE_MAX_BLOCKS);
+    for (unsigned page_idx = 0; page_idx < ECHO_FIRST_PAGE; ++page_idx) {
+        if (page_idx < ROM_PAGES_END || page_idx >= RAM_FIRST_PAGE)
+            __code_pages[page_idx] = std::make_unique<__CodePage>();    // no host and no blocks
+    }
+}
+
+/**
+ * @details Pending interrupt wakes up halted CPU even if IME is reset, and is dispatched
+ *          if IME is set. EI schedules IME for the end of the next instruction, unless the
+ *          instruction is DI.
+ */
+clk_cycle_t CPU::step() {
+    if (__is_locked)
+        return IDLE_CYCLES;
+
+    if (__interrupt_link->has_pending_interrupt()) {
+        __is_halted = false;
+        if (__interrupt_link->get_IME_reg()) {
+            __clock = 0;
+            devsync::Action<INTERRUPT_CYCLES>()(__clock, &CPU::__dispatch_interrupt, this);
+            return -__clock;
+        }
+    } else if (__is_halted) {
+        return IDLE_CYCLES;
+    }
+
+    const bool is_ime_scheduled = __is_ime_scheduled;
+    const byte_t opcode = __bus->read(__registers.PC);
+
+    // HALT bug: the byte after HALT is read twice
+    if (__has_halt_bug)
+        __has_halt_bug = false;
+    else
+        ++__registers.PC;
+
+    __clock = 0;
+    __Instructions<false>::OPCODES[opcode](this);
+
+    if (is_ime_scheduled && __is_ime_scheduled) {
+        __is_ime_scheduled = false;
+        __interrupt_link->set_IME_reg(true);
+    }
+    return -__clock;
+}
+
+void CPU::__dispatch_interrupt() {
+    const IC::InterruptIdx interrupt = __interrupt_link->get_highest_priority_interrupt();
+
+    __interrupt_link->set_IME_reg(false);
+    __interrupt_link->reset_interrupt(interrupt);
+    __Instructions<false>::call(this, IC::INTERRUPTS_ADDR[interrupt]);
+}
+
+clk_cycle_t CPU::execute_block(devsync::Scheduler& scheduler, clk_cycle_t limit) {
+    const bool needs_step = __is_locked || __is_halted || __is_ime_scheduled || __has_halt_bug
+                          || (__interrupt_link->has_pending_interrupt() && __interrupt_link->get_IME_reg())
+                          || __bus->is_locked(__registers.PC);
+    const __Block* const block = needs_step ? nullptr : __find_block(__registers.PC);
+
+    if (block == nullptr || block->max_cycles > scheduler.get_budget(limit - scheduler.get_time())) {
+        const clk_cycle_t cycles = step();
+
+        scheduler.advance(cycles);
+        return cycles;
+    }
+
+    const __MicroOp* op = &__ops[block->first_op];
+    const __MicroOp* const last_op = op + block->ops_num;
+
+    __block_scheduler = &scheduler;
+    __clock = 0;
+    __committed = 0;
+    __is_block_break = false;
+    do {
+        __op_clock = -__clock;
+        __operands = op->operands;
+        __registers.PC = op->next_pc;
+        op->handler(this);
+    } while (++op != last_op && !__is_block_break);
+
+    scheduler.advance(-__clock - __committed);
+    return -__clock;
+}
+
+void CPU::invalidate_blocks() {
+    for (unsigned page_idx = 0; page_idx < ECHO_FIRST_PAGE; ++page_idx) {
+        if (__ram_code_pages[page_idx])
+            __code_pages[page_idx]->blocks.fill(0);
+    }
+    __ram_code_pages.reset();
+    __is_block_break = true;
+}
+
+/**
+ * @details Blocks are decoded only from ROM and from RAM, which is written by CPU only
+ *          (cartridge RAM and WRAM without echo), and the page must be mapped to host memory.
+ */
+const CPU::__Block*
+CPU::__find_block(word_t pc) {
+    const bool is_rom = pc < Vaddr::VRAM_BASE_VADDR;
+    const bool is_ram = pc >= Vaddr::SRAM_BASE_VADDR && pc < Vaddr::WRAM0_ECHO_BASE_VADDR;
+    const byte_t* const host = (is_rom || is_ram) ? __bus->get_read_host(pc) : nullptr;
+
+    if (host == nullptr)
+        return nullptr;
+    if (__ops.size() + BLOCK_MAX_OPS > BLOCK_CACHE_MAX_OPS || __blocks.size() == BLOCK_CACHE_MAX_BLOCKS)
+        __flush_blocks();
+
+    const unsigned page_idx = pc >> Bus::PAGE_IDX_SHIFT;
+    const unsigned offset = pc & Bus::PAGE_OFFSET_MASK;
+    __CodePage& page = *__code_pages[page_idx];
+
+    if (page.host != host - offset) {
+        // the first block of the page, or another bank is mapped to it
+        page.blocks.fill(0);
+        page.host = host - offset;
+    }
+
+    u32& block_idx = page.blocks[offset];
+
+    if (block_idx == 0) {
+        block_idx = __decode_block(pc, host);
+        if (is_ram && block_idx != 0) {
+            __ram_code_pages.set(page_idx);
+            if (page_idx >= WRAM_FIRST_PAGE && page_idx + ECHO_PAGES_OFFSET <= ECHO_LAST_PAGE)
+                __ram_code_pages.set(page_idx + ECHO_PAGES_OFFSET);
+        }
+    }
+    return (block_idx != 0) ? &__blocks[block_idx - 1] : nullptr;
+}
+
+/**
+ * @details Instruction, which crosses the page end, isn't decoded: it would be invalidated
+ *          with another page.
+ * @return block index + 1, or 0 if there is nothing to decode
+ */
+u32 CPU::__decode_block(word_t pc, const byte_t* host) {
+    const unsigned page_left = Bus::PAGE_SIZE - (pc & Bus::PAGE_OFFSET_MASK);
+    __Block block = { u32(__ops.size()), 0, 0 };
+    unsigned offset = 0;
+
+    while (block.ops_num < BLOCK_MAX_OPS) {
+        const byte_t opcode = host[offset];
+        const unsigned length = instruction_length(opcode);
+
+        if (offset + length > page_left)
+            break;
+
+        __MicroOp op = { __Instructions<true>::OPCODES[opcode], word_t(pc + offset + length), { 0x0, 0x0 } };
+
+        for (unsigned idx = 1; idx < length; ++idx)
+            op.operands[idx - 1] = host[offset + idx];
+        block.max_cycles += OPCODE_MCYCLES[opcode] * 1_MCycles + branch_taken_cycles(opcode);
+        if (opcode == 0xCB)
+            block.max_cycles += cb_opcode_mcycles(op.operands[0]) * 1_MCycles;
+
+        __ops.push_back(op);
+        ++block.ops_num;
+        offset += length;
+        if (is_block_end(opcode))
+            break;
+    }
+
+    if (block.ops_num == 0)
+        return 0;
+    __blocks.push_back(block);
+    return u32(__blocks.size());
+}
+
+void CPU::__flush_blocks() {
+    for (std::unique_ptr<__CodePage>& page : __code_pages) {
+        if (page != nullptr)
+            page->blocks.fill(0);
+    }
+    __ops.clear();
+    __blocks.clear();
+    __ram_code_pages.reset();
+}
+
+/** Writes to echo pages invalidate blocks of WRAM */
+void CPU::__invalidate_code_page(unsigned page_idx) {
+    if (page_idx >= ECHO_FIRST_PAGE)
+        page_idx -= ECHO_PAGES_OFFSET;
+
+    __code_pages[page_idx]->blocks.fill(0);
+    __ram_code_pages.reset(page_idx);
+    if (page_idx >= WRAM_FIRST_PAGE && page_idx + ECHO_PAGES_OFFSET <= ECHO_LAST_PAGE)
+        __ram_code_pages.reset(page_idx + ECHO_PAGES_OFFSET);
+    __is_block_break = true;
+}
+
+/** Commit cycles of the previous micro-ops of the block, and end the block after this one */
+void CPU::__commit_block_cycles() {
+    __block_scheduler->advance(__op_clock - __committed);
+    __committed = __op_clock;
+    __is_block_break = true;
+}
+
+}  // namespace GB::core
@@ -0,0 +1,122 @@
+#include <cstring>
+
+#include "common/GB_delta_codec.h"
+
+namespace {
+
+inline uint64_t load_word(const uint8_t* src) {
+    uint64_t word;
+
+    std::memcpy(&word, src, sizeof(word));
+    return word;
+}
+
+inline void store_word(uint8_t* dst, uint64_t word) {
+    std::memcpy(dst, &word, sizeof(word));
+}
+
+inline void store_run(uint8_t* dst, size_t run) {
+    const uint16_t value = static_cast<uint16_t>(run);
+
+    std::memcpy(dst, &value, sizeof(value));
+}
+
+inline size_t load_run(const uint8_t* src) {
+    uint16_t value;
+
+    std::memcpy(&value, src, sizeof(value));
+    return value;
+}
+
+/** Reference is a template parameter, so encoding of the image itself doesn't load zeros */
+template <bool _HasReference>
+size_t encode_delta(const uint8_t* image, const uint8_t* reference, size_t len, uint8_t* dst) {
+    constexpr size_t WORD_SIZE = delta_codec_t::WORD_SIZE;
+
+    const size_t words_num = len / WORD_SIZE;
+    uint8_t* out = dst;
+    size_t idx = 0;
+
+    auto delta_word = [image, reference](size_t word_idx) {
+        const uint64_t word = load_word(image + word_idx * WORD_SIZE);
+
+        if constexpr (_HasReference)
+            return word ^ load_word(reference + word_idx * WORD_SIZE);
+        return word;
+    };
+
+    while (idx < words_num) {
+        uint8_t* const header = out;
+        size_t zeros = 0;
+        size_t literals = 0;
+
+        while (idx < words_num && zeros < delta_codec_t::MAX_RUN && delta_word(idx) == 0) {
+            ++zeros;
+            ++idx;
+        }
+
+        out += delta_codec_t::TOKEN_HEADER_SIZE;
+        for (; idx < words_num && literals < delta_codec_t::MAX_RUN; ++idx, ++literals, out += WORD_SIZE) {
+            const uint64_t word = delta_word(idx);
+
+            if (word == 0)
+                break;
+            store_word(out, word);
+        }
+
+        store_run(header, zeros);
+        store_run(header + sizeof(uint16_t), literals);
+    }
+
+    for (size_t offset = words_num * WORD_SIZE; offset < len; ++offset) {
+        if constexpr (_HasReference)
+            *out++ = image[offset] ^ reference[offset];
+        else
+            *out++ = image[offset];
+    }
+    return out - dst;
+}
+
+}  // namespace
+
+size_t delta_codec_t::encode(const uint8_t* image, const uint8_t* reference, size_t len, uint8_t* dst) {
+    if (reference == nullptr)
+        return encode_delta<false>(image, nullptr, len, dst);
+    return encode_delta<true>(image, reference, len, dst);
+}
+
+bool delta_codec_t::decode(const uint8_t* src, size_t src_len, uint8_t* buffer, size_t len) {
+    const size_t words_num = len / WORD_SIZE;
+    const size_t tail_len = len % WORD_SIZE;
+
+    if (src_len < tail_len)
+        return false;
+
+    const uint8_t* const tokens_end = src + src_len - tail_len;
+    size_t idx = 0;
+
+    while (src != tokens_end) {
+        if (size_t(tokens_end - src) < TOKEN_HEADER_SIZE)
+            return false;
+
+        const size_t zeros = load_run(src);
+        const size_t literals = load_run(src + sizeof(uint16_t));
+
+        src += TOKEN_HEADER_SIZE;
+        idx += zeros;
+        if (idx + literals > words_num || size_t(tokens_end - src) < literals * WORD_SIZE)
+            return false;
+
+        for (size_t end = idx + literals; idx < end; ++idx, src += WORD_SIZE) {
+            uint8_t* const word_addr = buffer + idx * WORD_SIZE;
+
+            store_word(word_addr, load_word(word_addr) ^ load_word(src));
+        }
+    }
+
+    if (idx > words_num)
+        return false;
+    for (size_t offset = words_num * WORD_SIZE; offset < len; ++offset)
+        buffer[offset] ^= *src++;
+    return true;
+}
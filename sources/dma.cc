@@ -0,0 +1,154 @@
+#include <algorithm>
+#include <cstring>
+
+#include "device/GB_dma.h"
+
+namespace GB::device {
+
+using Bus = memory::BusInterface;
+
+static byte_t read_DMA_reg(void* dma, word_t) {
+    return static_cast<DMA*>(dma)->get_DMA_reg();
+}
+
+static void write_DMA_reg(void* dma, word_t, byte_t value) {
+    static_cast<DMA*>(dma)->set_DMA_reg(value);
+}
+
+DMA::DMA(ORAM* oram, devsync::Scheduler* scheduler)
+: __oram_link(oram)
+, __scheduler(scheduler)
+, __bus_link(nullptr)
+, __start_event(scheduler->register_event(&DMA::__on_start, this))
+, __end_event(scheduler->register_event(&DMA::__on_end, this))
+, __reg(0x0)
+, __source(0x0)
+, __next_source(0x0)
+, __start_time(0)
+, __copied(TRANSFER_SIZE)
+, __is_active(false) {}
+
+void DMA::set_DMA_reg(byte_t value) {
+    const byte_t source_page = (value >= ECHO_SOURCE_BASE) ? value - ECHO_SOURCE_SHIFT : value;
+
+    __reg = value;
+    __next_source = word_t(source_page << 8);
+    __scheduler->schedule_in(__start_event, STARTUP_CYCLES);
+}
+
+void DMA::sync() {
+    if (__is_active)
+        __copy(__get_transferred());
+}
+
+DMA::State DMA::get_state() const {
+    State state;
+
+    std::memset(&state, 0, sizeof(State));
+    state.reg = __reg;
+    state.source = __source;
+    state.next_source = __next_source;
+    state.start_time = __start_time;
+    state.copied = __copied;
+    state.is_active = __is_active;
+    return state;
+}
+
+void DMA::set_state(const State& state) {
+    if (__is_active)
+        __unlock_bus();
+
+    __reg = state.reg;
+    __source = state.source;
+    __next_source = state.next_source;
+    __start_time = state.start_time;
+    __copied = state.copied;
+    __is_active = state.is_active;
+
+    if (__is_active)
+        __lock_bus();
+}
+
+void DMA::map_to_memory(Bus& mem_bus) {
+    __bus_link = &mem_bus;
+    mem_bus.MapVAddr(memory::DMA_VADDR, Bus::ReadCmd(read_DMA_reg), Bus::WriteCmd(write_DMA_reg), this);
+}
+
+void DMA::__on_start(void* dma_ptr, clk_cycle_t deadline) {
+    DMA* const dma = static_cast<DMA*>(dma_ptr);
+
+    // restarted transfer copies bytes of the previous one up to now
+    dma->sync();
+    dma->__source = dma->__next_source;
+    dma->__start_time = deadline;
+    dma->__copied = 0;
+    dma->__is_active = true;
+    dma->__lock_bus();
+    dma->__scheduler->schedule(dma->__end_event, deadline + TRANSFER_CYCLES);
+}
+
+void DMA::__on_end(void* dma_ptr, clk_cycle_t) {
+    DMA* const dma = static_cast<DMA*>(dma_ptr);
+
+    dma->__copy(TRANSFER_SIZE);
+    dma->__is_active = false;
+    dma->__unlock_bus();
+}
+
+/**
+ * @details CPU reads the byte, which is being transferred, from the source bus, and 0xFF from OAM.
+ */
+byte_t DMA::__read_locked(void* dma_ptr, word_t vaddr) {
+    const DMA* const dma = static_cast<const DMA*>(dma_ptr);
+
+    if (vaddr >= memory::OAM_RAM_BASE_VADDR)
+        return Bus::OPEN_BUS_VALUE;
+    const unsigned idx = std::min(dma->__get_transferred(), TRANSFER_SIZE - 1);
+    return dma->__bus_link->read_unlocked(dma->__source + idx);
+}
+
+void DMA::__sync_locked(void* dma) {
+    static_cast<DMA*>(dma)->sync();
+}
+
+void DMA::__copy(unsigned end) {
+    if (__bus_link == nullptr || __copied >= end)
+        return;
+
+    // OAM remap could synchronize the transfer again, so bytes are marked as copied first
+    const unsigned begin = __copied;
+    const byte_t* const host = __bus_link->get_read_host(__source + begin);
+
+    __copied = end;
+    if (host != nullptr) {
+        // source page is host memory, which is copied at once
+        __oram_link->write_block(begin, host, end - begin);
+        return;
+    }
+    for (unsigned idx = begin; idx < end; ++idx)
+        __oram_link->write_phys_addr(idx, __bus_link->read_unlocked(__source + idx));
+}
+
+void DMA::__lock_bus() {
+    // OAM is locked with the bus of the source
+    static const Bus::PageSet VIDEO_BUS_PAGES =
+        Bus::get_page_set(memory::VRAM_BASE_VADDR, memory::VRAM_LAST_VADDR)
+        | Bus::get_page_set(memory::OAM_RAM_BASE_VADDR, memory::OAM_RAM_LAST_VADDR);
+    static const Bus::PageSet EXTERNAL_BUS_PAGES =
+        Bus::get_page_set(0x0000, memory::VRAM_BASE_VADDR - 1)
+        | Bus::get_page_set(memory::VRAM_LAST_VADDR + 1, memory::OAM_RAM_LAST_VADDR);
+
+    if (__bus_link == nullptr)
+        return;
+
+    const bool is_video_source = (__source >= memory::VRAM_BASE_VADDR && __source <= memory::VRAM_LAST_VADDR);
+    __bus_link->Lock(is_video_source ? VIDEO_BUS_PAGES : EXTERNAL_BUS_PAGES
+                   , Bus::ReadCmd(__read_locked), nullptr, &DMA::__sync_locked, this);
+}
+
+void DMA::__unlock_bus() {
+    if (__bus_link != nullptr)
+        __bus_link->Unlock();
+}
+
+}  // namespace GB::device
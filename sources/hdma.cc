@@ -0,0 +1,120 @@
+#include <algorithm>
+
+#include "device/GB_hdma.h"
+
+namespace GB::device {
+
+using Bus = memory::BusInterface;
+
+/** HDMA1-HDMA4 are write only */
+static byte_t read_HDMA_source_dest_reg(void*, word_t) {
+    return Bus::OPEN_BUS_VALUE;
+}
+
+template <GBModeFlag _Mode>
+static byte_t read_HDMA5_reg(void* dev, word_t) {
+    return static_cast<HDMA<_Mode>*>(dev)->get_HDMA5_reg();
+}
+
+template <GBModeFlag _Mode>
+static void write_HDMA_reg(void* dev, word_t vaddr, byte_t value) {
+    HDMA<_Mode>* const hdma = static_cast<HDMA<_Mode>*>(dev);
+
+    switch (vaddr) {
+        case memory::HDMA1_VADDR: return hdma->set_HDMA1_reg(value);
+        case memory::HDMA2_VADDR: return hdma->set_HDMA2_reg(value);
+        case memory::HDMA3_VADDR: return hdma->set_HDMA3_reg(value);
+        case memory::HDMA4_VADDR: return hdma->set_HDMA4_reg(value);
+        default: return hdma->set_HDMA5_reg(value);
+    }
+}
+
+template <GBModeFlag _Mode>
+HDMA<_Mode>::HDMA(VRAM<_Mode>* vram)
+: __vram_link(vram)
+, __bus_link(nullptr)
+, __source(0x0)
+, __dest(0x0)
+, __length(LENGTH_MASK)
+, __is_active(false)
+, __stall_cycles(0) {}
+
+template <GBModeFlag _Mode>
+void HDMA<_Mode>::set_HDMA5_reg(byte_t value) {
+    if (__is_active && !::bit_n(HBLANK_MODE_BIT, value)) {
+        // stopped transfer keeps the remaining length
+        __is_active = false;
+        return;
+    }
+
+    __length = value & LENGTH_MASK;
+    if (::bit_n(HBLANK_MODE_BIT, value)) {
+        __is_active = true;
+        return;
+    }
+    __copy_blocks(__length + 1);
+    __length = LENGTH_MASK;
+}
+
+template <GBModeFlag _Mode>
+void HDMA<_Mode>::on_hblank() {
+    if (!__is_active)
+        return;
+
+    __copy_blocks(1);
+    if (__length == 0) {
+        __length = LENGTH_MASK;
+        __is_active = false;
+    } else {
+        --__length;
+    }
+}
+
+template <GBModeFlag _Mode>
+void HDMA<_Mode>::map_to_memory(Bus& mem_bus) {
+    __bus_link = &mem_bus;
+
+    if constexpr (CGB_BANKS) {
+        mem_bus.MapVAddr(memory::HDMA1_VADDR, memory::HDMA4_VADDR
+                        , Bus::ReadCmd(read_HDMA_source_dest_reg), Bus::WriteCmd(write_HDMA_reg<_Mode>), this);
+        mem_bus.MapVAddr(memory::HDMA5_VADDR
+                        , Bus::ReadCmd(read_HDMA5_reg<_Mode>), Bus::WriteCmd(write_HDMA_reg<_Mode>), this);
+    }
+}
+
+/**
+ * @details Blocks are copied by chunks, which don't cross a source page and the end of
+ *          the VRAM bank, so a chunk of host memory (ROM, RAM) is copied directly to VRAM.
+ */
+template <GBModeFlag _Mode>
+void HDMA<_Mode>::__copy_blocks(unsigned blocks_num) {
+    byte_t chunk_data[Bus::PAGE_SIZE];
+    size_t len = blocks_num * BLOCK_SIZE;
+
+    __stall_cycles += blocks_num * BLOCK_CYCLES;
+    if (__bus_link == nullptr)
+        return;
+
+    while (len != 0) {
+        const size_t chunk = std::min<size_t>({len, Bus::PAGE_SIZE - (__source & Bus::PAGE_OFFSET_MASK)
+                                             , VRAM_BANK_SIZE - __dest});
+
+        const byte_t* src = __bus_link->get_read_host(__source);
+
+        if (src == nullptr) {
+            __bus_link->read_block(__source, chunk_data, chunk);
+            src = chunk_data;
+        }
+        __vram_link->write_block(__dest, src, chunk);
+        __source = word_t(__source + chunk);
+        __dest = word_t((__dest + chunk) & DEST_MASK);
+        len -= chunk;
+    }
+}
+
+template class HDMA<DMG_MODE>;
+template class HDMA<MGB_MODE>;
+template class HDMA<CGB_DMG_MODE>;
+template class HDMA<CGB_MODE>;
+
+}  // namespace GB::device
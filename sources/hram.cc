@@ -0,0 +1,13 @@
+#include "device/GB_hram.h"
+#include "memory/GB_vaddr.h"
+
+namespace GB::device {
+
+void HRAM::map_to_memory(memory::BusInterface& mem_bus) {
+    __bus_link = &mem_bus;
+
+    mem_bus.MapMemory(memory::HRAM_BASE_VADDR, memory::HRAM_LAST_VADDR
+                    , __memory.get_data_addr());
+}
+
+}  // namespace GB::device
@@ -3,19 +3,21 @@
 
 namespace GB::device {
 
-    // static byte_t read_P1_reg(JoyPad* jp, word_t) {
-    //     return jp->get_P1_reg();
-    // }
+    static byte_t read_P1_reg(void* jp, word_t) {
+        static_cast<JoyPad*>(jp)->sync();
+        return static_cast<JoyPad*>(jp)->get_P1_reg();
+    }
 
-    // static void write_P1_reg(JoyPad* jp, word_t, byte_t data) {
-    //     jp->set_P1_reg(data);
-    // }
+    static void write_P1_reg(void* jp, word_t, byte_t data) {
+        static_cast<JoyPad*>(jp)->sync();
+        static_cast<JoyPad*>(jp)->set_P1_reg(data);
+    }
 
-    // void JoyPad::map_to_memory(::GB::memory::BusInterface& mem_bus) {
-    //     mem_bus.MapVAddr(::GB::memory::VirtualAddress::P1_VADDR
-    //                    , ::GB::memory::BusInterface::ReadCmd(&read_P1_reg)
-    //                    , ::GB::memory::BusInterface::WriteCmd(&write_P1_reg)
-    //                    , this);
-    // }
+    void JoyPad::map_to_memory(::GB::memory::BusInterface& mem_bus) {
+        mem_bus.MapVAddr(::GB::memory::VirtualAddress::P1_VADDR
+                       , ::GB::memory::BusInterface::ReadCmd(&read_P1_reg)
+                       , ::GB::memory::BusInterface::WriteCmd(&write_P1_reg)
+                       , this);
+    }
 
 }  // namespace GB::device
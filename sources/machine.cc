@@ -0,0 +1,23 @@
+#include "core/GB_machine.h"
+
+namespace GB::core {
+
+GBModeFlag AnyMachine::select_mode(const dbuffer_t& rom) {
+    if (rom.size() <= device::Cartridge::CGB_FLAG_VADDR)
+        return DMG_MODE;
+
+    const byte_t cgb_flag = rom[device::Cartridge::CGB_FLAG_VADDR];
+    return (cgb_flag & device::Cartridge::CGB_SUPPORTED_FLAG) ? CGB_MODE : DMG_MODE;
+}
+
+GBModeFlag AnyMachine::load_rom(dbuffer_t rom, std::pmr::memory_resource* resource) {
+    const GBModeFlag mode = select_mode(rom);
+
+    if (mode == CGB_MODE)
+        __machine.emplace<CGBMachine>(std::move(rom), resource);
+    else
+        __machine.emplace<DMGMachine>(std::move(rom), resource);
+    return mode;
+}
+
+}  // namespace GB::core
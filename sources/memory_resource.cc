@@ -0,0 +1,51 @@
+#include <sys/mman.h>
+
+#include <cstdint>
+#include <new>
+
+#include "common/GB_memory_resource.h"
+
+bool hugepage_resource_t::is_hugepage_supported() {
+#ifdef MADV_HUGEPAGE
+    return true;
+#else
+    return false;
+#endif
+}
+
+void* hugepage_resource_t::do_allocate(size_t bytes, size_t alignment) {
+    if (alignment > HUGE_PAGE_SIZE)
+        throw std::bad_alloc();
+
+    // over-allocate one huge page to align the mapping, then unmap the rest
+    const size_t size = __round_up(bytes != 0 ? bytes : 1);
+    const size_t map_size = size + HUGE_PAGE_SIZE;
+    void* const mapping = mmap(nullptr, map_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+    if (mapping == MAP_FAILED)
+        throw std::bad_alloc();
+
+    const uintptr_t map_base = reinterpret_cast<uintptr_t>(mapping);
+    const uintptr_t base = (map_base + HUGE_PAGE_SIZE - 1) & ~uintptr_t(HUGE_PAGE_SIZE - 1);
+    const size_t head = base - map_base;
+    const size_t tail = map_size - head - size;
+
+    if (head != 0)
+        munmap(mapping, head);
+    if (tail != 0)
+        munmap(reinterpret_cast<void*>(base + size), tail);
+
+#ifdef MADV_HUGEPAGE
+    madvise(reinterpret_cast<void*>(base), size, MADV_HUGEPAGE);
+#endif
+    return reinterpret_cast<void*>(base);
+}
+
+void hugepage_resource_t::do_deallocate(void* ptr, size_t bytes, size_t) {
+    munmap(ptr, __round_up(bytes != 0 ? bytes : 1));
+}
+
+bool hugepage_resource_t::do_is_equal(const std::pmr::memory_resource& other) const noexcept {
+    // any instance can free memory of another one
+    return dynamic_cast<const hugepage_resource_t*>(&other) != nullptr;
+}
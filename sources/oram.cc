@@ -0,0 +1,73 @@
+#include <cstring>
+
+#include "device/GB_oram.h"
+#include "memory/GB_vaddr.h"
+
+namespace GB::device {
+
+static void write_trapped_vaddr(void* dev, word_t vaddr, byte_t value) {
+    static_cast<ORAM*>(dev)->write_phys_addr(vaddr - memory::OAM_RAM_BASE_VADDR, value);
+}
+
+void ORAM::__index_object(unsigned object, byte_t y, bool is_present) {
+    const objects_mask_t object_bit = objects_mask_t(1) << object;
+    // upper rows start at line (Y - 16), lower rows follow them
+    const int top_line = int(y) - int(OBJECT_Y_OFFSET);
+
+    for (unsigned row = 0; row < OBJECT_HALF_HEIGHT * 2; ++row) {
+        const int line = top_line + int(row);
+        if (line < 0 || line >= int(LCD_HEIGHT))
+            continue;
+
+        objects_mask_t& line_objects = (row < OBJECT_HALF_HEIGHT) ? __top_objects[line] : __bottom_objects[line];
+        line_objects = is_present ? (line_objects | object_bit) : (line_objects & ~object_bit);
+    }
+}
+
+void ORAM::rebuild_line_index() {
+    __top_objects.fill(0);
+    __bottom_objects.fill(0);
+    for (unsigned object = 0; object < ORAM_OBJECTS_NUM; ++object)
+        __index_object(object, read_phys_addr(object * OBJECT_SIZE), true);
+}
+
+void ORAM::write_block(word_t phys_addr, const byte_t* src, size_t len) {
+    const bool was_shared = __memory.is_shared();
+    byte_t* const memory = __memory.get_data_addr();    // shared memory is copied here
+
+    for (size_t offset = phys_addr; offset < phys_addr + len; ++offset) {
+        const byte_t value = src[offset - phys_addr];
+        if (offset % OBJECT_SIZE == 0 && memory[offset] != value) {
+            __index_object(offset / OBJECT_SIZE, memory[offset], false);
+            __index_object(offset / OBJECT_SIZE, value, true);
+        }
+    }
+    std::memcpy(memory + phys_addr, src, len);
+    __dirty_pages.mark_block(phys_addr, len);
+
+    if (was_shared && __bus_link != nullptr)
+        map_to_memory(*__bus_link);
+}
+
+void ORAM::__write_shared_memory(word_t phys_addr, byte_t value) {
+    __memory[phys_addr] = value;
+    if (__bus_link != nullptr)
+        map_to_memory(*__bus_link);
+}
+
+void ORAM::share_memory() {
+    __memory.share();
+    if (__bus_link != nullptr)
+        map_to_memory(*__bus_link);
+}
+
+void ORAM::map_to_memory(memory::BusInterface& mem_bus) {
+    __bus_link = &mem_bus;
+
+    // writes are trapped to keep the objects index
+    mem_bus.MapMemory(memory::OAM_RAM_BASE_VADDR, memory::OAM_RAM_LAST_VADDR
+                    , __memory.get_page_rd_addr(0)
+                    , memory::BusInterface::WriteCmd(write_trapped_vaddr), this);
+}
+
+}  // namespace GB::device
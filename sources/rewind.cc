@@ -0,0 +1,167 @@
+#include <cstring>
+
+#include "common/GB_delta_codec.h"
+
+#include "core/GB_rewind.h"
+
+namespace GB::core {
+
+Rewind::Rewind(size_t budget, unsigned keyframe_interval)
+: __ring(budget)
+, __entries(INIT_ENTRIES_NUM)
+, __first(0)
+, __count(0)
+, __used(0)
+, __keyframe_interval(keyframe_interval != 0 ? keyframe_interval : 1)
+, __group_size(0)
+, __keyframe()
+, __encoded()
+, __image() {
+}
+
+void Rewind::clear() {
+    __first = 0;
+    __count = 0;
+    __used = 0;
+    __group_size = 0;
+}
+
+size_t Rewind::__encode(const dbuffer_t& image, bool is_keyframe) {
+    const uint8_t* const reference = is_keyframe ? nullptr : __keyframe.get_data_addr();
+
+    return delta_codec_t::encode(image.get_data_addr(), reference, image.size(), __encoded.get_data_addr());
+}
+
+/**
+ * @details States are placed in the order of pushes, so free space is after the newest state
+ *          up to the oldest one (or to the end of the ring, and then from the beginning).
+ */
+bool Rewind::__allocate(size_t size, size_t& offset) const {
+    if (__count == 0) {
+        offset = 0;
+        return size <= __ring.size();
+    }
+
+    const Entry& oldest = __entry(0);
+    const Entry& newest = __entry(__count - 1);
+    const size_t head = newest.offset + newest.size;
+
+    if (newest.offset >= oldest.offset) {
+        if (head + size <= __ring.size())
+            offset = head;
+        else if (size <= oldest.offset)
+            offset = 0;
+        else
+            return false;
+        return true;
+    }
+
+    offset = head;
+    return head + size <= oldest.offset;
+}
+
+void Rewind::__append(const Entry& entry) {
+    if (__count == __entries.size()) {
+        std::vector<Entry> entries(2 * __entries.size());
+
+        for (size_t idx = 0; idx < __count; ++idx)
+            entries[idx] = __entry(idx);
+        __entries.swap(entries);
+        __first = 0;
+    }
+    __entries[(__first + __count) % __entries.size()] = entry;
+    ++__count;
+    __used += entry.size;
+}
+
+void Rewind::__drop_oldest_group() {
+    do {
+        __used -= __entry(0).size;
+        __first = (__first + 1) % __entries.size();
+        --__count;
+    } while (__count != 0 && !__entry(0).is_keyframe);
+
+    if (__count == 0)
+        __group_size = 0;
+}
+
+bool Rewind::push(const dbuffer_t& image) {
+    if (image.size() != __keyframe.size()) {
+        clear();
+        __keyframe = dbuffer_t(image.size());
+        __encoded = dbuffer_t(delta_codec_t::max_encoded_size(image.size()));
+    }
+
+    bool is_keyframe = (__count == 0 || __group_size >= __keyframe_interval);
+    size_t size = __encode(image, is_keyframe);
+    size_t offset;
+
+    // delta, which doesn't fit even into the empty ring, may fit as a keyframe of a new group
+    if (size > __ring.size() && !is_keyframe) {
+        is_keyframe = true;
+        size = __encode(image, is_keyframe);
+    }
+    // check before dropping, so the history isn't lost for an image, which never fits
+    if (size > __ring.size())
+        return false;
+
+    while (!__allocate(size, offset)) {
+        __drop_oldest_group();
+        // delta is useless without its keyframe
+        if (__count == 0 && !is_keyframe) {
+            is_keyframe = true;
+            size = __encode(image, is_keyframe);
+        }
+    }
+
+    std::memcpy(__ring.get_data_addr() + offset, __encoded.get_data_addr(), size);
+    __append(Entry{offset, size, is_keyframe});
+
+    if (is_keyframe) {
+        std::memcpy(__keyframe.get_data_addr(), image.get_data_addr(), image.size());
+        __group_size = 1;
+    } else {
+        ++__group_size;
+    }
+    return true;
+}
+
+bool Rewind::__restore_keyframe() {
+    size_t idx = __count - 1;
+
+    while (!__entry(idx).is_keyframe)
+        --idx;
+    __group_size = __count - idx;
+
+    const Entry& keyframe = __entry(idx);
+
+    std::memset(__keyframe.get_data_addr(), 0, __keyframe.size());
+    return delta_codec_t::decode(__ring.get_data_addr() + keyframe.offset, keyframe.size
+                               , __keyframe.get_data_addr(), __keyframe.size());
+}
+
+/** Decoded keyframe is the newest keyframe itself, so only deltas are decoded */
+bool Rewind::pop(dbuffer_t& image) {
+    if (__count == 0)
+        return false;
+
+    const Entry newest = __entry(__count - 1);
+    bool is_decoded = true;
+
+    if (image.size() != __keyframe.size())
+        image = dbuffer_t(__keyframe.size(), image.get_memory_resource(), image.get_alignment());
+    std::memcpy(image.get_data_addr(), __keyframe.get_data_addr(), __keyframe.size());
+    if (!newest.is_keyframe) {
+        is_decoded = delta_codec_t::decode(__ring.get_data_addr() + newest.offset, newest.size
+                                         , image.get_data_addr(), image.size());
+    }
+
+    --__count;
+    --__group_size;
+    __used -= newest.size;
+    if (newest.is_keyframe && __count != 0)
+        is_decoded = __restore_keyframe() && is_decoded;
+    return is_decoded;
+}
+
+}  // namespace GB::core
@@ -0,0 +1,201 @@
+#include <array>
+#include <cstdint>
+#include <cstring>
+
+#include "common/GB_macro.h"
+#include "device/GB_tile_decoder.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+# define GB_TILE_DECODER_X86_
+# include <immintrin.h>
+#endif
+
+namespace GB::device {
+
+namespace {
+
+/** Row of 8 pixels with bits of the bitplane byte, leftmost pixel goes first in memory */
+constexpr std::array<uint64_t, 256>
+make_spread_table() {
+    std::array<uint64_t, 256> table{};
+
+    for (unsigned plane = 0; plane < 256; ++plane) {
+        for (unsigned x = 0; x < 8; ++x) {
+            const unsigned shift = (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__) ? x * 8 : (7 - x) * 8;
+            table[plane] |= uint64_t((plane >> (7 - x)) & 0x1) << shift;
+        }
+    }
+    return table;
+}
+
+constexpr std::array<byte_t, 256>
+make_reverse_table() {
+    std::array<byte_t, 256> table{};
+
+    for (unsigned plane = 0; plane < 256; ++plane) {
+        for (unsigned bit = 0; bit < 8; ++bit)
+            table[plane] |= ((plane >> bit) & 0x1) << (7 - bit);
+    }
+    return table;
+}
+
+constexpr std::array<uint64_t, 256> SPREAD_TABLE = make_spread_table();
+constexpr std::array<byte_t, 256> REVERSE_TABLE = make_reverse_table();
+
+inline void
+decode_row_scalar(const byte_t* planes, byte_t* pixels) {
+    const uint64_t row = SPREAD_TABLE[planes[0]] | (SPREAD_TABLE[planes[1]] << 1);
+    std::memcpy(pixels, &row, sizeof(row));
+}
+
+void
+decode_rows_scalar(const byte_t* planes, unsigned rows_num, byte_t* pixels) {
+    for (unsigned row = 0; row < rows_num; ++row)
+        decode_row_scalar(planes + row * 2, pixels + row * 8);
+}
+
+#ifdef GB_TILE_DECODER_X86_
+
+/**
+ * Planes of 4 rows are unpacked, so every bitplane byte is repeated 8 times, bytes are masked
+ * with bits from the leftmost pixel, and compared with the mask, which gives 0xFF for set bits.
+ * Unpacked row has low bitplane in the low half and high bitplane in the high half.
+ */
+__attribute__((target("sse2")))
+inline __m128i
+decode_unpacked_row_sse2(__m128i planes, __m128i bit_mask, __m128i index_bits) {
+    const __m128i bits = _mm_and_si128(_mm_cmpeq_epi8(_mm_and_si128(planes, bit_mask), bit_mask), index_bits);
+    return _mm_or_si128(bits, _mm_srli_si128(bits, 8));
+}
+
+__attribute__((target("sse2")))
+void
+decode_rows_sse2(const byte_t* planes, unsigned rows_num, byte_t* pixels) {
+    const __m128i bit_mask = _mm_set_epi8(1, 2, 4, 8, 16, 32, 64, char(128), 1, 2, 4, 8, 16, 32, 64, char(128));
+    const __m128i index_bits = _mm_set_epi64x(0x0202020202020202ll, 0x0101010101010101ll);
+
+    unsigned row = 0;
+    for (; row + 4 <= rows_num; row += 4) {
+        const __m128i all_planes = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(planes + row * 2));
+        const __m128i planes_x2 = _mm_unpacklo_epi8(all_planes, all_planes);
+        const __m128i rows01_x4 = _mm_unpacklo_epi16(planes_x2, planes_x2);
+        const __m128i rows23_x4 = _mm_unpackhi_epi16(planes_x2, planes_x2);
+        const __m128i row0 = decode_unpacked_row_sse2(_mm_unpacklo_epi32(rows01_x4, rows01_x4), bit_mask, index_bits);
+        const __m128i row1 = decode_unpacked_row_sse2(_mm_unpackhi_epi32(rows01_x4, rows01_x4), bit_mask, index_bits);
+        const __m128i row2 = decode_unpacked_row_sse2(_mm_unpacklo_epi32(rows23_x4, rows23_x4), bit_mask, index_bits);
+        const __m128i row3 = decode_unpacked_row_sse2(_mm_unpackhi_epi32(rows23_x4, rows23_x4), bit_mask, index_bits);
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(pixels + row * 8), _mm_unpacklo_epi64(row0, row1));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(pixels + row * 8 + 16), _mm_unpacklo_epi64(row2, row3));
+    }
+    decode_rows_scalar(planes + row * 2, rows_num - row, pixels + row * 8);
+}
+
+/**
+ * Planes of 4 rows are broadcasted to both lanes, and every bitplane byte is shuffled
+ * to 8 bytes, which are decoded as in the SSE2 kernel.
+ * Tail is decoded by the scalar kernel to avoid AVX-SSE transition penalty.
+ */
+__attribute__((target("avx2")))
+void
+decode_rows_avx2(const byte_t* planes, unsigned rows_num, byte_t* pixels) {
+    const __m256i bit_mask = _mm256_set_epi8(1, 2, 4, 8, 16, 32, 64, char(128), 1, 2, 4, 8, 16, 32, 64, char(128)
+                                           , 1, 2, 4, 8, 16, 32, 64, char(128), 1, 2, 4, 8, 16, 32, 64, char(128));
+    const __m256i low_shuffle = _mm256_set_epi8(6, 6, 6, 6, 6, 6, 6, 6, 4, 4, 4, 4, 4, 4, 4, 4
+                                              , 2, 2, 2, 2, 2, 2, 2, 2, 0, 0, 0, 0, 0, 0, 0, 0);
+    const __m256i high_shuffle = _mm256_set_epi8(7, 7, 7, 7, 7, 7, 7, 7, 5, 5, 5, 5, 5, 5, 5, 5
+                                               , 3, 3, 3, 3, 3, 3, 3, 3, 1, 1, 1, 1, 1, 1, 1, 1);
+    const __m256i low_bit = _mm256_set1_epi8(0x1);
+    const __m256i high_bit = _mm256_set1_epi8(0x2);
+
+    unsigned row = 0;
+    for (; row + 4 <= rows_num; row += 4) {
+        int64_t rows;
+        std::memcpy(&rows, planes + row * 2, sizeof(rows));
+
+        const __m256i all_planes = _mm256_set1_epi64x(rows);
+        const __m256i low = _mm256_shuffle_epi8(all_planes, low_shuffle);
+        const __m256i high = _mm256_shuffle_epi8(all_planes, high_shuffle);
+        const __m256i low_set = _mm256_cmpeq_epi8(_mm256_and_si256(low, bit_mask), bit_mask);
+        const __m256i high_set = _mm256_cmpeq_epi8(_mm256_and_si256(high, bit_mask), bit_mask);
+        const __m256i indices = _mm256_or_si256(_mm256_and_si256(low_set, low_bit)
+                                              , _mm256_and_si256(high_set, high_bit));
+
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(pixels + row * 8), indices);
+    }
+    decode_rows_scalar(planes + row * 2, rows_num - row, pixels + row * 8);
+}
+
+#endif  // GB_TILE_DECODER_X86_
+
+}  // namespace
+
+bool
+TileDecoder::is_supported(Isa isa) {
+    switch (isa) {
+        case SCALAR_ISA:
+            return true;
+#ifdef GB_TILE_DECODER_X86_
+        case SSE2_ISA:
+            return __builtin_cpu_supports("sse2");
+        case AVX2_ISA:
+            return __builtin_cpu_supports("avx2");
+#endif
+        default:
+            return false;
+    }
+}
+
+TileDecoder::Isa
+TileDecoder::get_best_isa() {
+    static const Isa best_isa = is_supported(AVX2_ISA) ? AVX2_ISA
+                              : is_supported(SSE2_ISA) ? SSE2_ISA
+                              : SCALAR_ISA;
+    return best_isa;
+}
+
+TileDecoder::Kernel
+TileDecoder::__get_kernel(Isa isa) {
+    switch (isa) {
+#ifdef GB_TILE_DECODER_X86_
+        case SSE2_ISA:  return decode_rows_sse2;
+        case AVX2_ISA:  return decode_rows_avx2;
+#endif
+        default:        return decode_rows_scalar;
+    }
+}
+
+TileDecoder::TileDecoder(Isa isa)
+: __isa(is_supported(isa) ? isa : get_best_isa())
+, __kernel(__get_kernel(__isa)) {}
+
+void
+TileDecoder::fetch_line(const byte_t* vram, word_t map_offset, bool signed_tiles, bool cgb_attrs
+                      , byte_t scx, byte_t y, byte_t* pixels) const {
+    const unsigned map_row = (y / TILE_WIDTH) % MAP_WIDTH;
+    const unsigned first_tile = scx / TILE_WIDTH;
+    byte_t planes[LINE_TILES_NUM * 2];
+    byte_t line[LINE_TILES_NUM * TILE_WIDTH];
+
+    for (unsigned idx = 0; idx < LINE_TILES_NUM; ++idx) {
+        const unsigned map_idx = map_offset + map_row * MAP_WIDTH + (first_tile + idx) % MAP_WIDTH;
+        const byte_t tile = vram[map_idx];
+        const byte_t attrs = cgb_attrs ? vram[VRAM_BANK_SIZE + map_idx] : 0x0;
+        const unsigned tile_row = ::bit_n(ATTR_VFLIP_BIT, attrs) ? 7 - y % TILE_WIDTH : y % TILE_WIDTH;
+        const unsigned tile_offset = signed_tiles ? 0x1000 + int8_t(tile) * int(TILE_SIZE) : tile * TILE_SIZE;
+        const byte_t* row = vram + (::bit_n(ATTR_BANK_BIT, attrs) ? VRAM_BANK_SIZE : 0)
+                                 + tile_offset + tile_row * 2;
+
+        if (::bit_n(ATTR_HFLIP_BIT, attrs)) {
+            planes[idx * 2] = REVERSE_TABLE[row[0]];
+            planes[idx * 2 + 1] = REVERSE_TABLE[row[1]];
+        } else {
+            planes[idx * 2] = row[0];
+            planes[idx * 2 + 1] = row[1];
+        }
+    }
+    decode_rows(planes, LINE_TILES_NUM, line);
+    std::memcpy(pixels, line + scx % TILE_WIDTH, LINE_WIDTH);
+}
+
+}  // namespace GB::device
@@ -0,0 +1,147 @@
+#include "device/GB_timer.h"
+
+namespace GB::device {
+
+using Bus = memory::BusInterface;
+using Scheduler = devsync::Scheduler;
+
+static byte_t read_timer_reg(void* timer_ptr, word_t vaddr) {
+    Timer* const timer = static_cast<Timer*>(timer_ptr);
+
+    switch (vaddr) {
+        case memory::DIV_VADDR:     return timer->get_DIV_reg();
+        case memory::TIMA_VADDR:    return timer->get_TIMA_reg();
+        case memory::TMA_VADDR:     return timer->get_TMA_reg();
+        default:                    return timer->get_TAC_reg();
+    }
+}
+
+static void write_timer_reg(void* timer_ptr, word_t vaddr, byte_t value) {
+    Timer* const timer = static_cast<Timer*>(timer_ptr);
+
+    switch (vaddr) {
+        case memory::DIV_VADDR:     return timer->set_DIV_reg(value);
+        case memory::TIMA_VADDR:    return timer->set_TIMA_reg(value);
+        case memory::TMA_VADDR:     return timer->set_TMA_reg(value);
+        default:                    return timer->set_TAC_reg(value);
+    }
+}
+
+Timer::Timer(InterruptController* ic_link, Scheduler* scheduler)
+: __interrupt_link(ic_link)
+, __scheduler(scheduler)
+, __event(scheduler->register_event(&Timer::__on_event, this))
+, __sync(scheduler->get_clock())
+, __origin(scheduler->get_time())
+, __reload_time(Scheduler::NEVER)
+, __last_reload(Scheduler::NEVER)
+, __tima(0x0)
+, __tma(0x0)
+, __tac(0x0) {}
+
+/**
+ * @details Written value is ignored: counter is reset, and falling edge of the selected
+ *          counter bit increments TIMA.
+ */
+void Timer::set_DIV_reg(byte_t) {
+    sync();
+    const bool signal = __get_signal();
+
+    __origin = __scheduler->get_time();
+    if (signal)
+        __increment();
+    __schedule_overflow();
+}
+
+byte_t Timer::get_TIMA_reg() {
+    sync();
+    return byte_t(__tima);
+}
+
+void Timer::set_TIMA_reg(byte_t value) {
+    sync();
+    if (__scheduler->get_time() == __last_reload)
+        return;
+
+    // write during the overflow M-cycle cancels the reload
+    __reload_time = Scheduler::NEVER;
+    __tima = value;
+    __schedule_overflow();
+}
+
+void Timer::set_TMA_reg(byte_t value) {
+    sync();
+    __tma = value;
+    if (__scheduler->get_time() == __last_reload) {
+        __tima = value;
+        __schedule_overflow();
+    }
+}
+
+void Timer::set_TAC_reg(byte_t value) {
+    sync();
+    const bool signal = __get_signal();
+
+    __tac = value & ~TAC_RESERVED_BITS;
+    if (signal && !__get_signal())
+        __increment();
+    __schedule_overflow();
+}
+
+void Timer::sync() {
+    const clk_cycle_t from = __sync.get_last_sync();
+
+    __sync.catch_up();
+    __tima += unsigned(__count_edges(from, __sync.get_last_sync()));
+}
+
+void Timer::map_to_memory(Bus& mem_bus) {
+    mem_bus.MapVAddr(memory::DIV_VADDR, memory::TAC_VADDR
+                   , Bus::ReadCmd(read_timer_reg), Bus::WriteCmd(write_timer_reg), this);
+}
+
+/**
+ * @details Event fires twice per overflow: on the falling edge, which overflows TIMA,
+ *          and one M-cycle later, when TIMA is reloaded and the interrupt is requested.
+ */
+void Timer::__on_event(void* timer_ptr, clk_cycle_t deadline) {
+    Timer* const timer = static_cast<Timer*>(timer_ptr);
+
+    timer->__sync.catch_up();
+    if (timer->__reload_time == deadline) {
+        timer->__reload_time = Scheduler::NEVER;
+        timer->__last_reload = deadline;
+        timer->__tima = timer->__tma;
+        timer->__interrupt_link->request_interrupt(InterruptController::TIMOVER_INT);
+        timer->__schedule_overflow();
+    } else {
+        // the overflow edge is the last one since the previous synchronization
+        timer->__tima = 0x0;
+        timer->__reload_time = deadline + RELOAD_DELAY;
+        timer->__scheduler->schedule(timer->__event, timer->__reload_time);
+    }
+}
+
+/** Increment TIMA out of the counter edges (glitch), which could overflow it right now */
+void Timer::__increment() {
+    if (++__tima < TIMA_OVERFLOW)
+        return;
+
+    __tima = 0x0;
+    __reload_time = __scheduler->get_time() + RELOAD_DELAY;
+}
+
+/** Schedule the next event (reload or overflow edge), timer must be synchronized */
+void Timer::__schedule_overflow() {
+    if (__reload_time != Scheduler::NEVER)
+        return __scheduler->schedule(__event, __reload_time);
+    if (!__is_enabled())
+        return __scheduler->cancel(__event);
+
+    const clk_cycle_t period = __get_edge_period();
+    const clk_cycle_t passed_edges = (__sync.get_last_sync() - __origin) / period;
+    const clk_cycle_t overflow_edge = passed_edges + clk_cycle_t(TIMA_OVERFLOW - __tima);
+    __scheduler->schedule(__event, __origin + overflow_edge * period);
+}
+
+}  // namespace GB::device
@@ -0,0 +1,153 @@
+#include <algorithm>
+#include <cstring>
+
+#include "device/GB_vram.h"
+#include "memory/GB_vaddr.h"
+
+namespace GB::device {
+
+template <GBModeFlag _Mode>
+static byte_t read_VBK_reg(void* dev, word_t) {
+    return static_cast<VRAM<_Mode>*>(dev)->get_VBK_reg();
+}
+
+template <GBModeFlag _Mode>
+static void write_VBK_reg(void* dev, word_t, byte_t value) {
+    static_cast<VRAM<_Mode>*>(dev)->set_VBK_reg(value);
+}
+
+template <GBModeFlag _Mode>
+static void write_trapped_vaddr(void* dev, word_t vaddr, byte_t value) {
+    static_cast<VRAM<_Mode>*>(dev)->write_inner_vaddr(vaddr - memory::VRAM_BASE_VADDR, value);
+}
+
+/** Dirty pages of private memory after tile data are mapped directly to the host memory */
+template <GBModeFlag _Mode>
+void VRAM<_Mode>::__map_bank_pages() {
+    const word_t tile_data_last = memory::VRAM_BASE_VADDR + TILE_DATA_SIZE - 1;
+    const u32 bank_first_page = DirtyPages::page_idx(__get_bank_base());
+
+    for (unsigned page = 0; page < PAGES_NUM; ++page) {
+        const word_t base = memory::VRAM_BASE_VADDR + page * dbuffer_t::PAGE_SIZE;
+        const word_t last = base + dbuffer_t::PAGE_SIZE - 1;
+        // writes to tile data are trapped to keep the tile cache
+        const word_t direct_base = std::max<word_t>(base, tile_data_last + 1);
+
+        __bus_link->MapMemory(base, last, __page_ptrs[page]
+                            , memory::BusInterface::WriteCmd(write_trapped_vaddr<_Mode>), this);
+        if (__page_wr_ptrs[page] == nullptr || direct_base > last)
+            continue;
+
+        auto map_run = [&](u32 run_first, u32 run_last, bool is_dirty) {
+            const word_t run_base = memory::VRAM_BASE_VADDR + (run_first - bank_first_page) * DirtyPages::PAGE_SIZE;
+            const word_t run_last_vaddr = run_base + (run_last - run_first + 1) * DirtyPages::PAGE_SIZE - 1;
+
+            if (is_dirty)
+                __bus_link->MapMemory(run_base, run_last_vaddr, __page_wr_ptrs[page] + (run_base - base));
+        };
+        __dirty_pages.for_each_run(bank_first_page + DirtyPages::page_idx(direct_base - memory::VRAM_BASE_VADDR)
+                                 , bank_first_page + DirtyPages::page_idx(last - memory::VRAM_BASE_VADDR), map_run);
+    }
+}
+
+template <GBModeFlag _Mode>
+void VRAM<_Mode>::__map_dirty_page(u32 phys_addr) {
+    if (__bus_link != nullptr && (phys_addr & BANK_OFFSET_MASK) >= TILE_DATA_SIZE
+     && (phys_addr & ~BANK_OFFSET_MASK) == __get_bank_base())
+        __map_bank_pages();
+}
+
+template <GBModeFlag _Mode>
+void VRAM<_Mode>::clear_dirty_pages() {
+    __dirty_pages.clear();
+    if (__bus_link != nullptr)
+        __map_bank_pages();
+}
+
+template <GBModeFlag _Mode>
+void VRAM<_Mode>::mark_dirty_pages() {
+    if (__dirty_pages.get().all())
+        return;
+    __dirty_pages.mark_all();
+    if (__bus_link != nullptr)
+        __map_bank_pages();
+}
+
+template <GBModeFlag _Mode>
+void VRAM<_Mode>::read_block(word_t inner_vaddr, byte_t* dst, size_t len) const {
+    while (len != 0) {
+        const unsigned page = (inner_vaddr >> PAGE_IDX_SHIFT) & (PAGES_NUM - 1);
+        const unsigned page_offset = inner_vaddr & PAGE_OFFSET_MASK;
+        const size_t chunk = std::min<size_t>(len, dbuffer_t::PAGE_SIZE - page_offset);
+
+        std::memcpy(dst, __page_ptrs[page] + page_offset, chunk);
+        inner_vaddr = word_t((inner_vaddr + chunk) & BANK_OFFSET_MASK);
+        dst += chunk;
+        len -= chunk;
+    }
+}
+
+template <GBModeFlag _Mode>
+void VRAM<_Mode>::write_block(word_t inner_vaddr, const byte_t* src, size_t len) {
+    while (len != 0) {
+        const unsigned page = (inner_vaddr >> PAGE_IDX_SHIFT) & (PAGES_NUM - 1);
+        const unsigned page_offset = inner_vaddr & PAGE_OFFSET_MASK;
+        const size_t chunk = std::min<size_t>(len, dbuffer_t::PAGE_SIZE - page_offset);
+        const u32 phys_addr = __get_bank_base() + (inner_vaddr & BANK_OFFSET_MASK);
+
+        for (u32 row_addr = phys_addr & ~(TILE_ROW_SIZE - 1); row_addr < phys_addr + chunk; row_addr += TILE_ROW_SIZE)
+            __mark_tile_row_dirty(row_addr);
+        // the first write to frozen page of shared memory copies it
+        if (__page_wr_ptrs[page] == nullptr)
+            __write_shared_memory(phys_addr, src[0]);
+        std::memcpy(__page_wr_ptrs[page] + page_offset, src, chunk);
+        if (__dirty_pages.mark_block(phys_addr, chunk))
+            __map_dirty_page(phys_addr + chunk - 1);
+
+        inner_vaddr = word_t((inner_vaddr + chunk) & BANK_OFFSET_MASK);
+        src += chunk;
+        len -= chunk;
+    }
+}
+
+template <GBModeFlag _Mode>
+void VRAM<_Mode>::__write_shared_memory(u32 phys_addr, byte_t value) {
+    const u32 first_page = (phys_addr / VRAM_BANK_SIZE) * PAGES_NUM;
+
+    // bank stays contiguous for view_bank()
+    for (unsigned page = 0; page < PAGES_NUM; ++page)
+        __memory.privatize_page(first_page + page);
+    __memory[phys_addr] = value;
+    __dirty_pages.mark(phys_addr);
+    __update_bank_ptr();
+    if (__bus_link != nullptr)
+        __map_bank_pages();
+}
+
+template <GBModeFlag _Mode>
+void VRAM<_Mode>::share_memory() {
+    __memory.share();
+    __update_bank_ptr();
+    if (__bus_link != nullptr)
+        __map_bank_pages();
+}
+
+template <GBModeFlag _Mode>
+void VRAM<_Mode>::map_to_memory(memory::BusInterface& mem_bus) {
+    __bus_link = &mem_bus;
+
+    if constexpr (CGB_BANKS) {
+        mem_bus.MapVAddr(memory::VBK_VADDR
+                        , memory::BusInterface::ReadCmd(read_VBK_reg<_Mode>)
+                        , memory::BusInterface::WriteCmd(write_VBK_reg<_Mode>)
+                        , this);
+    }
+    __map_bank_pages();
+}
+
+template class VRAM<DMG_MODE>;
+template class VRAM<MGB_MODE>;
+template class VRAM<CGB_DMG_MODE>;
+template class VRAM<CGB_MODE>;
+
+}  // namespace GB::device
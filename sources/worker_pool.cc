@@ -0,0 +1,138 @@
+#ifdef __linux__
+# include <pthread.h>
+# include <sched.h>
+#endif
+
+#include "common/GB_worker_pool.h"
+
+worker_pool_t::worker_pool_t(unsigned workers_num, bool is_pinned)
+: __workers()
+, __mutex()
+, __start_cv()
+, __done_cv()
+, __job(nullptr)
+, __context(nullptr)
+, __generation(0)
+, __busy_num(0)
+, __pinned_num(0)
+, __is_stopped(false) {
+    if (workers_num == 0)
+        workers_num = 1;
+
+    __workers.reserve(workers_num);
+    for (unsigned worker_idx = 0; worker_idx < workers_num; ++worker_idx)
+        __workers.emplace_back(&worker_pool_t::__work, this, worker_idx);
+
+    if (is_pinned) {
+        for (unsigned worker_idx = 0; worker_idx < workers_num; ++worker_idx)
+            __pinned_num += __pin(worker_idx);
+    }
+}
+
+worker_pool_t::~worker_pool_t() {
+    {
+        std::lock_guard<std::mutex> lock(__mutex);
+        __is_stopped = true;
+    }
+    __start_cv.notify_all();
+    for (std::thread& worker : __workers)
+        worker.join();
+}
+
+bool worker_pool_t::is_pinning_supported() {
+#ifdef __linux__
+    return true;
+#else
+    return false;
+#endif
+}
+
+#ifdef __linux__
+/** Get CPUs, which the process is allowed to run on, returns false if they are unknown */
+static bool get_allowed_cpus(cpu_set_t& allowed, unsigned& allowed_num) {
+    CPU_ZERO(&allowed);
+    if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0)
+        return false;
+    allowed_num = CPU_COUNT(&allowed);
+    return allowed_num != 0;
+}
+#endif
+
+unsigned worker_pool_t::get_cpus_num() {
+#ifdef __linux__
+    cpu_set_t   allowed;
+    unsigned    allowed_num;
+
+    if (get_allowed_cpus(allowed, allowed_num))
+        return allowed_num;
+#endif
+    const unsigned cpus_num = std::thread::hardware_concurrency();
+
+    return (cpus_num != 0) ? cpus_num : 1;
+}
+
+bool worker_pool_t::__pin(unsigned worker_idx) {
+#ifdef __linux__
+    cpu_set_t allowed;
+    cpu_set_t target;
+    unsigned  allowed_num;
+
+    if (!get_allowed_cpus(allowed, allowed_num))
+        return false;
+
+    // n-th allowed CPU, so workers of a restricted process (taskset, cgroup) stay inside its set
+    unsigned nth = worker_idx % allowed_num;
+    CPU_ZERO(&target);
+    for (unsigned cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+        if (CPU_ISSET(cpu, &allowed) && nth-- == 0) {
+            CPU_SET(cpu, &target);
+            break;
+        }
+    }
+    return pthread_setaffinity_np(__workers[worker_idx].native_handle(), sizeof(target), &target) == 0;
+#else
+    (void)worker_idx;
+    return false;
+#endif
+}
+
+void worker_pool_t::__work(unsigned worker_idx) {
+    u64 seen_generation = 0;
+
+    while (true) {
+        job_t job;
+        void* context;
+        {
+            std::unique_lock<std::mutex> lock(__mutex);
+            __start_cv.wait(lock, [&] { return __is_stopped || __generation != seen_generation; });
+            if (__is_stopped)
+                return;
+            seen_generation = __generation;
+            job = __job;
+            context = __context;
+        }
+
+        job(context, worker_idx);
+
+        {
+            std::lock_guard<std::mutex> lock(__mutex);
+            if (--__busy_num != 0)
+                continue;
+        }
+        __done_cv.notify_one();
+    }
+}
+
+void worker_pool_t::run(job_t job, void* context) {
+    {
+        std::lock_guard<std::mutex> lock(__mutex);
+        __job = job;
+        __context = context;
+        __busy_num = __workers.size();
+        ++__generation;
+    }
+    __start_cv.notify_all();
+
+    std::unique_lock<std::mutex> lock(__mutex);
+    __done_cv.wait(lock, [&] { return __busy_num == 0; });
+}
@@ -1,49 +1,169 @@
+#include <algorithm>
+#include <cstring>
+
 #include "device/GB_wram.h"
 #include "memory/GB_vaddr.h"
 
 namespace GB::device {
 
-// static byte_t read_SVBK_reg(WRAM* dev, word_t) {
-//     return dev->get_SVBK_reg();
-// }
-
-// static void write_SVBK_reg(WRAM* dev, word_t, byte_t value) {
-//     dev->set_SVBK_reg(value);
-// }
-
-// static byte_t read_laddr_gb_wram(WRAM* dev, word_t laddr_gb) {
-//     const word_t laddr = laddr_gb - memory::WRAM0_BASE_VADDR;
-//     return dev->read_inner_vaddr(laddr);
-// }
-
-// static void write_laddr_gb_wram(WRAM* dev, word_t laddr_gb, byte_t data) {
-//     const word_t laddr = laddr_gb - memory::WRAM0_BASE_VADDR;
-//     dev->write_inner_vaddr(laddr, data);
-// }
-
-// static byte_t read_laddr_gb_wram_echo(WRAM* dev, word_t laddr_gb) {
-//     const word_t laddr = laddr_gb - memory::WRAM0_ECHO_BASE_VADDR;
-//     return dev->read_inner_vaddr(laddr);
-// }
-
-// static void write_laddr_gb_wram_echo(WRAM* dev, word_t laddr_gb, byte_t data) {
-//     const word_t laddr = laddr_gb - memory::WRAM0_ECHO_BASE_VADDR;
-//     dev->write_inner_vaddr(laddr, data);
-// }
-
-// void WRAM::map_to_memory(memory::BusInterface& mem_bus) {
-//     mem_bus.MapVAddr(memory::SVBK_VADDR
-//                     , memory::BusInterface::ReadCmd(read_SVBK_reg)
-//                     , memory::BusInterface::WriteCmd(write_SVBK_reg)
-//                     , this);
-//     mem_bus.MapVAddr(memory::WRAM0_BASE_VADDR, memory::WRAMX_LAST_VADDR
-//                     , memory::BusInterface::ReadCmd(read_laddr_gb_wram)
-//                     , memory::BusInterface::WriteCmd(write_laddr_gb_wram)
-//                     , this);
-//     mem_bus.MapVAddr(memory::WRAM0_ECHO_BASE_VADDR, memory::WRAMX_ECHO_LAST_VADDR
-//                     , memory::BusInterface::ReadCmd(read_laddr_gb_wram_echo)
-//                     , memory::BusInterface::WriteCmd(write_laddr_gb_wram_echo)
-//                     , this);
-// }
+template <GBModeFlag _Mode>
+static byte_t read_SVBK_reg(void* dev, word_t) {
+    return static_cast<WRAM<_Mode>*>(dev)->get_SVBK_reg();
+}
+
+template <GBModeFlag _Mode>
+static void write_SVBK_reg(void* dev, word_t, byte_t value) {
+    static_cast<WRAM<_Mode>*>(dev)->set_SVBK_reg(value);
+}
+
+/** Writes to frozen banks of shared memory and to clean pages (WRAM and echo have the same inner address bits) */
+template <GBModeFlag _Mode>
+static void write_trapped_vaddr(void* dev, word_t vaddr, byte_t data) {
+    static_cast<WRAM<_Mode>*>(dev)->write_inner_vaddr(vaddr & WRAM<_Mode>::INNER_VADDR_MASK, data);
+}
+
+/**
+ * @details Window is mapped by runs of pages: dirty pages of a private bank are mapped directly
+ *          to the host memory, other pages are mapped for reading only. Echo of WRAMX is shorter
+ *          than the window, so it's clipped.
+ */
+template <GBModeFlag _Mode>
+void WRAM<_Mode>::__map_window(unsigned window) {
+    const word_t base = (window == 0) ? memory::WRAM0_BASE_VADDR : memory::WRAMX_BASE_VADDR;
+    const word_t echo_base = (window == 0) ? memory::WRAM0_ECHO_BASE_VADDR : memory::WRAMX_ECHO_BASE_VADDR;
+    const word_t echo_last = (window == 0) ? memory::WRAM0_ECHO_LAST_VADDR : memory::WRAMX_ECHO_LAST_VADDR;
+    const u32 first_page = DirtyPages::page_idx(__bank_bases[window]);
+    const u32 last_page = first_page + DirtyPages::page_idx(BANK_SIZE) - 1;
+
+    auto map_run = [&](u32 run_first, u32 run_last, bool is_dirty) {
+        const u32 offset = (run_first - first_page) * DirtyPages::PAGE_SIZE;
+        const u32 last_offset = (run_last - first_page + 1) * DirtyPages::PAGE_SIZE - 1;
+        const word_t run_echo_last = std::min<word_t>(echo_last, echo_base + last_offset);
+
+        if (is_dirty && __bank_wr_ptrs[window] != nullptr) {
+            __bus_link->MapMemory(base + offset, base + last_offset, __bank_wr_ptrs[window] + offset);
+            if (echo_base + offset <= run_echo_last)
+                __bus_link->MapMemory(echo_base + offset, run_echo_last, __bank_wr_ptrs[window] + offset);
+        } else {
+            const auto write_cmd = memory::BusInterface::WriteCmd(write_trapped_vaddr<_Mode>);
+            __bus_link->MapMemory(base + offset, base + last_offset, __bank_ptrs[window] + offset, write_cmd, this);
+            if (echo_base + offset <= run_echo_last)
+                __bus_link->MapMemory(echo_base + offset, run_echo_last, __bank_ptrs[window] + offset, write_cmd, this);
+        }
+    };
+
+    if (__bank_wr_ptrs[window] == nullptr)
+        map_run(first_page, last_page, false);
+    else
+        __dirty_pages.for_each_run(first_page, last_page, map_run);
+}
+
+template <GBModeFlag _Mode>
+void WRAM<_Mode>::__map_bank_pages() {
+    __map_window(1);
+}
+
+template <GBModeFlag _Mode>
+void WRAM<_Mode>::__map_dirty_page(u32 phys_addr) {
+    if (__bus_link == nullptr)
+        return;
+
+    for (unsigned window = 0; window < WINDOWS_NUM; ++window) {
+        if (phys_addr / BANK_SIZE == __bank_bases[window] / BANK_SIZE)
+            __map_window(window);
+    }
+}
+
+template <GBModeFlag _Mode>
+void WRAM<_Mode>::clear_dirty_pages() {
+    __dirty_pages.clear();
+    if (__bus_link != nullptr) {
+        __map_window(0);
+        __map_window(1);
+    }
+}
+
+template <GBModeFlag _Mode>
+void WRAM<_Mode>::mark_dirty_pages() {
+    if (__dirty_pages.get().all())
+        return;
+    __dirty_pages.mark_all();
+    if (__bus_link != nullptr) {
+        __map_window(0);
+        __map_window(1);
+    }
+}
+
+template <GBModeFlag _Mode>
+void WRAM<_Mode>::read_block(word_t inner_vaddr, byte_t* dst, size_t len) const {
+    while (len != 0) {
+        const unsigned window = (inner_vaddr >> WINDOW_IDX_SHIFT) & (WINDOWS_NUM - 1);
+        const unsigned window_offset = inner_vaddr & WINDOW_OFFSET_MASK;
+        const size_t chunk = std::min<size_t>(len, BANK_SIZE - window_offset);
+
+        std::memcpy(dst, __bank_ptrs[window] + window_offset, chunk);
+        inner_vaddr = word_t((inner_vaddr + chunk) & INNER_VADDR_MASK);
+        dst += chunk;
+        len -= chunk;
+    }
+}
+
+template <GBModeFlag _Mode>
+void WRAM<_Mode>::write_block(word_t inner_vaddr, const byte_t* src, size_t len) {
+    while (len != 0) {
+        const unsigned window = (inner_vaddr >> WINDOW_IDX_SHIFT) & (WINDOWS_NUM - 1);
+        const unsigned window_offset = inner_vaddr & WINDOW_OFFSET_MASK;
+        const size_t chunk = std::min<size_t>(len, BANK_SIZE - window_offset);
+
+        const u32 phys_addr = __bank_bases[window] + window_offset;
+
+        if (__bank_wr_ptrs[window] == nullptr)
+            __write_shared_memory(phys_addr, src[0]);
+        std::memcpy(__bank_wr_ptrs[window] + window_offset, src, chunk);
+        if (__dirty_pages.mark_block(phys_addr, chunk))
+            __map_dirty_page(phys_addr);
+        inner_vaddr = word_t((inner_vaddr + chunk) & INNER_VADDR_MASK);
+        src += chunk;
+        len -= chunk;
+    }
+}
+
+template <GBModeFlag _Mode>
+void WRAM<_Mode>::__write_shared_memory(u32 phys_addr, byte_t data) {
+    __memory[phys_addr] = data;
+    __dirty_pages.mark(phys_addr);
+    __update_bank_ptrs();
+    if (__bus_link != nullptr) {
+        __map_window(0);
+        __map_window(1);
+    }
+}
+
+template <GBModeFlag _Mode>
+void WRAM<_Mode>::share_memory() {
+    __memory.share();
+    __update_bank_ptrs();
+    if (__bus_link != nullptr)
+        map_to_memory(*__bus_link);
+}
+
+template <GBModeFlag _Mode>
+void WRAM<_Mode>::map_to_memory(memory::BusInterface& mem_bus) {
+    __bus_link = &mem_bus;
+
+    if constexpr (CGB_BANKS) {
+        mem_bus.MapVAddr(memory::SVBK_VADDR
+                        , memory::BusInterface::ReadCmd(read_SVBK_reg<_Mode>)
+                        , memory::BusInterface::WriteCmd(write_SVBK_reg<_Mode>)
+                        , this);
+    }
+    __map_window(0);
+    __map_window(1);
+}
+
+template class WRAM<DMG_MODE>;
+template class WRAM<MGB_MODE>;
+template class WRAM<CGB_DMG_MODE>;
+template class WRAM<CGB_MODE>;
 
 }  // namespace GB::device
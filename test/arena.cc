@@ -0,0 +1,96 @@
+#include <memory_resource>
+
+#include "gtest/gtest.h"
+
+#include "GB_test.h"
+
+#include "memory/GB_arena.h"
+
+namespace {
+
+using CGBArena = GB::memory::Arena<GB::CGB_MODE>;
+using DMGArena = GB::memory::Arena<GB::DMG_MODE>;
+
+TEST(Memory_Arena, Layout) {
+    CGBArena arena(8_KBytes);
+
+    EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(arena.get_data_addr()) % CGBArena::CACHE_LINE_SIZE);
+
+    for (unsigned idx = CGBArena::WRAM_REGION; idx < CGBArena::SRAM_REGION; ++idx) {
+        const auto region = CGBArena::Region(idx);
+        const auto next_region = CGBArena::Region(idx + 1);
+
+        EXPECT_EQ(0u, CGBArena::region_offset(region) % CGBArena::CACHE_LINE_SIZE);
+        EXPECT_LE(CGBArena::region_offset(region) + CGBArena::region_size(region)
+                , CGBArena::region_offset(next_region));
+    }
+    EXPECT_EQ(CGBArena::region_offset(CGBArena::SRAM_REGION) + 8_KBytes, arena.size());
+
+    EXPECT_EQ(GB::WRAM_CGB_SIZE, arena.view(CGBArena::WRAM_REGION).size());
+    EXPECT_EQ(GB::VRAM_CGB_SIZE, arena.view(CGBArena::VRAM_REGION).size());
+    EXPECT_EQ(GB::WRAM_NON_CGB_SIZE, DMGArena::region_size(DMGArena::WRAM_REGION));
+    EXPECT_EQ(GB::VRAM_NON_CGB_SIZE, DMGArena::region_size(DMGArena::VRAM_REGION));
+    EXPECT_EQ(8_KBytes, arena.view(CGBArena::SRAM_REGION).size());
+    EXPECT_EQ(0u, DMGArena().view(DMGArena::SRAM_REGION).size());
+
+    for (size_t offset = 0; offset < arena.size(); ++offset)
+        ASSERT_EQ(0x0, arena.get_data_addr()[offset]);
+}
+
+TEST(Memory_Arena, Views) {
+    CGBArena arena;
+
+    dbuffer_t view = arena.view(CGBArena::OAM_REGION);
+    EXPECT_TRUE(view.is_view());
+    EXPECT_EQ(arena.get_region_addr(CGBArena::OAM_REGION), view.get_data_addr());
+
+    // assignment to a view copies content, and keeps the view location
+    dbuffer_t source(GB::ORAM_SIZE);
+    for (size_t offset = 0; offset < source.size(); ++offset)
+        source[offset] = byte_t(offset);
+    view = source;
+    EXPECT_EQ(arena.get_region_addr(CGBArena::OAM_REGION), view.get_data_addr());
+    EXPECT_EQ(0x10, arena.get_region_addr(CGBArena::OAM_REGION)[0x10]);
+
+    // copy of a view owns its memory
+    dbuffer_t copy(view);
+    EXPECT_FALSE(copy.is_view());
+    EXPECT_NE(view.get_data_addr(), copy.get_data_addr());
+    EXPECT_EQ(0x10, copy[0x10]);
+}
+
+TEST(Memory_Arena, Memory_Resource) {
+    std::pmr::monotonic_buffer_resource upstream;
+    CGBArena                            arena(0, &upstream);
+
+    EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(arena.get_data_addr()) % CGBArena::CACHE_LINE_SIZE);
+    EXPECT_EQ(0x0, arena.get_region_addr(CGBArena::HRAM_REGION)[0x0]);
+}
+
+TEST(Memory_Arena, Snapshot) {
+    CGBArena    arena(2_KBytes);
+    dbuffer_t   snapshot;
+
+    arena.get_region_addr(CGBArena::WRAM_REGION)[0x123] = 0x1;
+    arena.get_region_addr(CGBArena::SRAM_REGION)[0x7FF] = 0x2;
+    arena.save(snapshot);
+    EXPECT_EQ(arena.size(), snapshot.size());
+
+    arena.get_region_addr(CGBArena::WRAM_REGION)[0x123] = 0x3;
+    arena.get_region_addr(CGBArena::SRAM_REGION)[0x7FF] = 0x4;
+    EXPECT_TRUE(arena.load(snapshot));
+    EXPECT_EQ(0x1, arena.get_region_addr(CGBArena::WRAM_REGION)[0x123]);
+    EXPECT_EQ(0x2, arena.get_region_addr(CGBArena::SRAM_REGION)[0x7FF]);
+
+    // snapshot of another arena is rejected
+    CGBArena    other(0);
+    dbuffer_t   short_snapshot;
+
+    other.save(short_snapshot);
+    arena.get_region_addr(CGBArena::WRAM_REGION)[0x123] = 0x5;
+    EXPECT_FALSE(arena.load(short_snapshot));
+    EXPECT_FALSE(arena.load(dbuffer_t()));
+    EXPECT_EQ(0x5, arena.get_region_addr(CGBArena::WRAM_REGION)[0x123]);
+}
+
+}  // namespace
@@ -0,0 +1,187 @@
+#include "gtest/gtest.h"
+
+#include "GB_test.h"
+
+#include "memory/GB_bus.h"
+#include "memory/GB_vaddr.h"
+
+namespace {
+
+using Bus = GB::memory::BusInterface;
+
+struct Register {
+    byte_t  value = 0x0;
+    word_t  last_vaddr = 0x0;
+};
+
+byte_t read_register(void* reg, word_t vaddr) {
+    static_cast<Register*>(reg)->last_vaddr = vaddr;
+    return static_cast<Register*>(reg)->value;
+}
+
+void write_register(void* reg, word_t vaddr, byte_t data) {
+    static_cast<Register*>(reg)->last_vaddr = vaddr;
+    static_cast<Register*>(reg)->value = data;
+}
+
+TEST(Memory_Bus, Unmapped_Access) {
+    Bus bus;
+
+    EXPECT_EQ(Bus::OPEN_BUS_VALUE, bus.read(0x0000));
+    EXPECT_EQ(Bus::OPEN_BUS_VALUE, bus.read(0x8000));
+    EXPECT_EQ(Bus::OPEN_BUS_VALUE, bus.read(0xFFFF));
+
+    bus.write(0xC000, 0x42);
+    EXPECT_EQ(Bus::OPEN_BUS_VALUE, bus.read(0xC000));
+}
+
+TEST(Memory_Bus, Host_Memory_Pages) {
+    Bus     bus;
+    byte_t  host[0x1000] = {};
+
+    bus.MapMemory(0xC000, 0xCFFF, host);
+
+    // RAM pages must be served by a plain pointer
+    for (unsigned page = 0xC0; page <= 0xCF; ++page) {
+        EXPECT_EQ(host + (page - 0xC0) * Bus::PAGE_SIZE, bus.__pages[page].rd_host);
+        EXPECT_EQ(host + (page - 0xC0) * Bus::PAGE_SIZE, bus.__pages[page].wr_host);
+        EXPECT_EQ(nullptr, bus.__cells[page]);
+    }
+
+    bus.write(0xC000, 0x1);
+    bus.write(0xC123, 0x2);
+    bus.write(0xCFFF, 0x3);
+
+    EXPECT_EQ(0x1, host[0x000]);
+    EXPECT_EQ(0x2, host[0x123]);
+    EXPECT_EQ(0x3, host[0xFFF]);
+
+    host[0x456] = 0xAB;
+    EXPECT_EQ(0xAB, bus.read(0xC456));
+    EXPECT_EQ(Bus::OPEN_BUS_VALUE, bus.read(0xD000));
+    EXPECT_EQ(Bus::OPEN_BUS_VALUE, bus.read(0xBFFF));
+}
+
+TEST(Memory_Bus, Read_Only_Host_Memory) {
+    Bus         bus;
+    Register    reg;
+    byte_t      host[0x200] = {};
+
+    host[0x10] = 0x77;
+    bus.MapMemory(0x4000, 0x41FF, host, nullptr, nullptr);
+
+    EXPECT_EQ(0x77, bus.read(0x4010));
+    bus.write(0x4010, 0x0);
+    EXPECT_EQ(0x77, host[0x10]);
+
+    bus.MapMemory(0x4000, 0x41FF, host, Bus::WriteCmd(write_register), &reg);
+    bus.write(0x4123, 0x5);
+    EXPECT_EQ(0x5, reg.value);
+    EXPECT_EQ(0x4123, reg.last_vaddr);
+    EXPECT_EQ(0x0, host[0x123]);
+}
+
+TEST(Memory_Bus, Register_Cells) {
+    Bus         bus;
+    Register    reg_a;
+    Register    reg_b;
+    byte_t      hram[0x7F] = {};
+
+    bus.MapVAddr(0xFF00, Bus::ReadCmd(read_register), Bus::WriteCmd(write_register), &reg_a);
+    bus.MapVAddr(0xFF10, 0xFF1F, Bus::ReadCmd(read_register), Bus::WriteCmd(write_register), &reg_b);
+    bus.MapMemory(0xFF80, 0xFFFE, hram);
+
+    bus.write(0xFF00, 0x12);
+    EXPECT_EQ(0x12, reg_a.value);
+    EXPECT_EQ(0x12, bus.read(0xFF00));
+
+    bus.write(0xFF1A, 0x34);
+    EXPECT_EQ(0x34, reg_b.value);
+    EXPECT_EQ(0xFF1A, reg_b.last_vaddr);
+    EXPECT_EQ(0x34, bus.read(0xFF15));
+    EXPECT_EQ(0xFF15, reg_b.last_vaddr);
+
+    bus.write(0xFF80, 0x56);
+    bus.write(0xFFFE, 0x78);
+    EXPECT_EQ(0x56, hram[0x00]);
+    EXPECT_EQ(0x78, hram[0x7E]);
+    EXPECT_EQ(0x56, bus.read(0xFF80));
+    EXPECT_EQ(0x78, bus.read(0xFFFE));
+
+    EXPECT_EQ(Bus::OPEN_BUS_VALUE, bus.read(0xFF01));
+    EXPECT_EQ(Bus::OPEN_BUS_VALUE, bus.read(0xFFFF));
+}
+
+TEST(Memory_Bus, Remap_And_Unmap) {
+    Bus     bus;
+    byte_t  bank_a[0x100] = {};
+    byte_t  bank_b[0x100] = {};
+
+    bank_a[0x1] = 0xA;
+    bank_b[0x1] = 0xB;
+
+    // partial mapping splits page into cells
+    bus.MapMemory(0xFE00, 0xFE9F, bank_a);
+    EXPECT_NE(nullptr, bus.__cells[0xFE]);
+    EXPECT_EQ(0xA, bus.read(0xFE01));
+    EXPECT_EQ(Bus::OPEN_BUS_VALUE, bus.read(0xFEA0));
+
+    // whole page mapping replaces cells
+    bus.MapMemory(0xFE00, 0xFEFF, bank_b);
+    EXPECT_EQ(nullptr, bus.__cells[0xFE]);
+    EXPECT_EQ(0xB, bus.read(0xFE01));
+
+    // cells inherit mapping of the page
+    bus.Unmap(0xFE80, 0xFEFF);
+    EXPECT_EQ(0xB, bus.read(0xFE01));
+    EXPECT_EQ(Bus::OPEN_BUS_VALUE, bus.read(0xFE80));
+
+    bus.Unmap(0xFE00, 0xFEFF);
+    EXPECT_EQ(Bus::OPEN_BUS_VALUE, bus.read(0xFE01));
+}
+
+TEST(Memory_Bus, Lock_View) {
+    Bus         bus;
+    Register    master;
+    Register    reg;
+    byte_t      bank_a[0x100] = {};
+    byte_t      bank_b[0x100] = {};
+
+    master.value = 0x42;
+    bank_a[0x1] = 0xA;
+    bank_b[0x1] = 0xB;
+    bus.MapMemory(0xC000, 0xC0FF, bank_a);
+    bus.MapVAddr(0xFF00, &read_register, &write_register, &reg);
+
+    bus.Lock(Bus::get_page_set(0xC000, 0xC0FF), &read_register, nullptr, nullptr, &master);
+    EXPECT_TRUE(bus.is_locked(0xC001));
+    EXPECT_FALSE(bus.is_locked(0xFF00));
+    EXPECT_EQ(0x42, bus.read(0xC001));
+    EXPECT_EQ(0xA, bus.read_unlocked(0xC001));
+    EXPECT_EQ(bank_a + 1, bus.get_read_host(0xC001));
+
+    // writes to locked pages are ignored, other pages are served as usual
+    bus.write(0xC001, 0x0);
+    bus.write(0xFF00, 0x7);
+    EXPECT_EQ(0xA, bank_a[0x1]);
+    EXPECT_EQ(0x7, reg.value);
+
+    // locked pages are remapped aside
+    bus.MapMemory(0xC000, 0xC0FF, bank_b);
+    EXPECT_EQ(0x42, bus.read(0xC001));
+    EXPECT_EQ(0xB, bus.read_unlocked(0xC001));
+
+    bus.Unlock();
+    EXPECT_FALSE(bus.is_locked(0xC001));
+    EXPECT_EQ(0xB, bus.read(0xC001));
+
+    // pages, which are remapped while unlocked, are served by the next lock
+    bus.MapMemory(0xC000, 0xC0FF, bank_a);
+    bus.Lock(Bus::get_page_set(0xFF00, 0xFFFF), nullptr, nullptr, nullptr, &master);
+    EXPECT_EQ(0xA, bus.read(0xC001));
+    EXPECT_EQ(Bus::OPEN_BUS_VALUE, bus.read(0xFF00));
+    EXPECT_EQ(0x7, bus.read_unlocked(0xFF00));
+    bus.Unlock();
+}
+
+}  // namespace
@@ -0,0 +1,115 @@
+#include <utility>
+
+#include "gtest/gtest.h"
+
+#include "GB_test.h"
+
+#include "device/GB_cartridge.h"
+#include "memory/GB_bus.h"
+
+namespace {
+
+using Cartridge = GB::device::Cartridge;
+using Bus = GB::memory::BusInterface;
+
+dbuffer_t make_rom(size_t size, byte_t cgb_flag) {
+    dbuffer_t rom(size);
+
+    for (size_t i = 0; i < size; ++i)
+        rom[i] = byte_t(i / Cartridge::ROM_BANK_SIZE + 1);
+    rom[Cartridge::CGB_FLAG_VADDR] = cgb_flag;
+    return rom;
+}
+
+TEST(Cartridge, Header) {
+    Cartridge dmg_cart(make_rom(32_KBytes, 0x00));
+    Cartridge cgb_cart(make_rom(32_KBytes, Cartridge::CGB_SUPPORTED_FLAG));
+    Cartridge cgb_only_cart(make_rom(32_KBytes, Cartridge::CGB_ONLY_FLAG));
+
+    EXPECT_FALSE(dmg_cart.is_cgb_game());
+    EXPECT_TRUE(cgb_cart.is_cgb_game());
+    EXPECT_TRUE(cgb_only_cart.is_cgb_game());
+    EXPECT_EQ(Cartridge::CGB_ONLY_FLAG, cgb_only_cart.get_cgb_flag());
+}
+
+TEST(Cartridge, ROM_Padding) {
+    Cartridge empty_cart;
+    EXPECT_EQ(Cartridge::MIN_ROM_SIZE, empty_cart.get_rom_buffer_ref().size());
+    EXPECT_EQ(Cartridge::ROM_FILL_VALUE, empty_cart.get_rom_buffer_ref()[0x0]);
+
+    Cartridge small_cart(make_rom(0x200, 0x00));
+    EXPECT_EQ(Cartridge::MIN_ROM_SIZE, small_cart.get_rom_buffer_ref().size());
+    EXPECT_EQ(0x1, small_cart.get_rom_buffer_ref()[0x1FF]);
+    EXPECT_EQ(Cartridge::ROM_FILL_VALUE, small_cart.get_rom_buffer_ref()[0x200]);
+}
+
+TEST(Cartridge, SRAM) {
+    dbuffer_t rom = make_rom(32_KBytes, 0x00);
+    rom[Cartridge::RAM_SIZE_VADDR] = 0x00;
+    EXPECT_EQ(0u, Cartridge::sram_size(rom));
+    rom[Cartridge::RAM_SIZE_VADDR] = 0x03;
+    EXPECT_EQ(32_KBytes, Cartridge::sram_size(rom));
+    EXPECT_EQ(0u, Cartridge::sram_size(dbuffer_t()));
+
+    byte_t      sram[2_KBytes] = {};
+    Cartridge   cart(make_rom(32_KBytes, 0x00), dbuffer_t::view(sram, sizeof(sram)));
+    Bus         bus;
+
+    cart.map_to_memory(bus);
+    bus.write(0xA7FF, 0x42);
+    EXPECT_EQ(0x42, sram[0x7FF]);
+    EXPECT_EQ(0x42, bus.read(0xA7FF));
+    EXPECT_EQ(Bus::OPEN_BUS_VALUE, bus.read(0xA800));
+}
+
+TEST(Cartridge, Dirty_Pages) {
+    dbuffer_t rom = make_rom(32_KBytes, 0x00);
+    byte_t    sram[32_KBytes] = {};
+
+    rom[Cartridge::RAM_SIZE_VADDR] = 0x03;
+
+    Cartridge   cart(std::move(rom), dbuffer_t::view(sram, sizeof(sram)));
+    Bus         bus;
+
+    cart.map_to_memory(bus);
+    EXPECT_TRUE(cart.get_dirty_pages().all());
+    EXPECT_NE(nullptr, bus.__pages[0xA0].wr_host);
+
+    cart.clear_dirty_pages();
+    EXPECT_EQ(nullptr, bus.__pages[0xA0].wr_host);
+    EXPECT_EQ(nullptr, bus.__pages[0xBF].wr_host);
+
+    bus.write(0xA101, 0x42);
+    bus.write(0xBFFF, 0x43);
+    EXPECT_EQ(0x42, sram[0x101]);
+    EXPECT_EQ(0x43, sram[0x1FFF]);
+    EXPECT_EQ(2, cart.get_dirty_pages().count());
+    EXPECT_TRUE(cart.get_dirty_pages()[0x01]);
+    EXPECT_TRUE(cart.get_dirty_pages()[0x1F]);
+    EXPECT_NE(nullptr, bus.__pages[0xA1].wr_host);
+    EXPECT_NE(nullptr, bus.__pages[0xBF].wr_host);
+    EXPECT_EQ(nullptr, bus.__pages[0xA0].wr_host);
+
+    // only the window is mapped
+    cart.mark_dirty_pages();
+    EXPECT_NE(nullptr, bus.__pages[0xA0].wr_host);
+    EXPECT_EQ(0x43, bus.read(0xBFFF));
+}
+
+TEST(Cartridge, Memory_Bus) {
+    Cartridge   cart(make_rom(32_KBytes, 0x00));
+    Bus         bus;
+
+    cart.map_to_memory(bus);
+
+    EXPECT_EQ(0x1, bus.read(0x0000));
+    EXPECT_EQ(0x1, bus.read(0x3FFF));
+    EXPECT_EQ(0x2, bus.read(0x4000));
+    EXPECT_EQ(0x2, bus.read(0x7FFF));
+
+    // ROM is read only
+    bus.write(0x4000, 0x42);
+    EXPECT_EQ(0x2, bus.read(0x4000));
+}
+
+}  // namespace
@@ -0,0 +1,481 @@
+#include <initializer_list>
+
+#include "gtest/gtest.h"
+
+#include "GB_test.h"
+
+#include "GB_config.h"
+#include "common/GB_scheduler.h"
+#include "core/GB_cpu.h"
+#include "device/GB_interrupt.h"
+#include "device/GB_timer.h"
+#include "device/GB_wram.h"
+#include "memory/GB_bus.h"
+#include "memory/GB_vaddr.h"
+
+namespace {
+
+using Bus = GB::memory::BusInterface;
+using CPU = GB::core::CPU;
+using IntController = GB::device::InterruptController;
+using Timer = GB::device::Timer;
+using Vaddr = GB::memory::VirtualAddress;
+using WRAM = GB::device::WRAM<GB::DMG_MODE>;
+
+constexpr word_t PROGRAM_VADDR = 0xC000;
+constexpr word_t STACK_VADDR = 0xD000;
+
+struct CPU_Test : public ::testing::Test {
+    Bus                 bus;
+    devsync::Scheduler  scheduler;
+    WRAM                wram;
+    IntController       int_ctrl;
+    CPU                 cpu;
+    CPU::Registers&     regs;
+
+    CPU_Test()
+    : int_ctrl(IntController::Registers(0x0, 0x0, false))
+    , cpu(&bus, &int_ctrl, CPU::Registers(0x0, 0x0, 0x0, 0x0, STACK_VADDR, PROGRAM_VADDR))
+    , regs(cpu.get_registers()) {
+        wram.map_to_memory(bus);
+    }
+
+    void load(std::initializer_list<byte_t> program, word_t vaddr = PROGRAM_VADDR) {
+        for (byte_t opcode : program)
+            bus.write(vaddr++, opcode);
+    }
+
+    /** Execute some steps, and return their cycles */
+    clk_cycle_t run(unsigned steps = 1) {
+        clk_cycle_t cycles = 0;
+
+        while (steps-- != 0)
+            cycles += cpu.step();
+        return cycles;
+    }
+
+    /** Execute some pre-decoded blocks, and return their cycles */
+    clk_cycle_t run_blocks(unsigned blocks = 1) {
+        clk_cycle_t cycles = 0;
+
+        while (blocks-- != 0)
+            cycles += cpu.execute_block(scheduler, devsync::Scheduler::NEVER);
+        return cycles;
+    }
+
+    /** Execute A = A <op> value, and return flags */
+    byte_t alu(byte_t opcode, byte_t acc, byte_t value, byte_t flags = 0x0) {
+        regs.PC = PROGRAM_VADDR;
+        regs.A = acc;
+        regs.F = flags;
+        load({ opcode, value });
+        EXPECT_EQ(2_MCycles, run());
+        return regs.F;
+    }
+};
+
+TEST_F(CPU_Test, Loads) {
+    load({
+        0x06, 0x12,             // LD B,0x12
+        0x48,                   // LD C,B
+        0x21, 0x00, 0xC1,       // LD HL,0xC100
+        0x71,                   // LD (HL),C
+        0x3E, 0x34,             // LD A,0x34
+        0x22,                   // LD (HL+),A
+        0x3A,                   // LD A,(HL-)
+        0x5E,                   // LD E,(HL)
+        0xEA, 0x10, 0xC1,       // LD (0xC110),A
+        0x08, 0x20, 0xC1,       // LD (0xC120),SP
+    });
+    bus.write(0xC101, 0x56);
+
+    EXPECT_EQ(2_MCycles + 1_MCycles + 3_MCycles + 2_MCycles, run(4));
+    EXPECT_EQ(0x12, regs.C);
+    EXPECT_EQ(0x12, bus.read(0xC100));
+
+    EXPECT_EQ(2_MCycles + 2_MCycles + 2_MCycles + 2_MCycles, run(4));
+    EXPECT_EQ(0x34, bus.read(0xC100));
+    EXPECT_EQ(0x56, regs.A);
+    EXPECT_EQ(0xC100, regs.get_HL());
+    EXPECT_EQ(0x34, regs.E);
+
+    EXPECT_EQ(4_MCycles + 5_MCycles, run(2));
+    EXPECT_EQ(0x56, bus.read(0xC110));
+    EXPECT_EQ(byte_t(STACK_VADDR), bus.read(0xC120));
+    EXPECT_EQ(byte_t(STACK_VADDR >> 8), bus.read(0xC121));
+}
+
+TEST_F(CPU_Test, ALU_Flags) {
+    EXPECT_EQ(0xB0, alu(0xC6, 0x3A, 0xC6));     // ADD
+    EXPECT_EQ(0x00, regs.A);
+    EXPECT_EQ(0x20, alu(0xCE, 0xE1, 0x0F, 0x10));   // ADC
+    EXPECT_EQ(0xF1, regs.A);
+    EXPECT_EQ(0xC0, alu(0xD6, 0x3E, 0x3E));     // SUB
+    EXPECT_EQ(0x60, alu(0xD6, 0x3E, 0x0F));
+    EXPECT_EQ(0x2F, regs.A);
+    EXPECT_EQ(0x50, alu(0xD6, 0x3E, 0x40));
+    EXPECT_EQ(0xFE, regs.A);
+    EXPECT_EQ(0x40, alu(0xDE, 0x3B, 0x2A, 0x10));   // SBC
+    EXPECT_EQ(0x10, regs.A);
+    EXPECT_EQ(0x20, alu(0xE6, 0x5A, 0x38));     // AND
+    EXPECT_EQ(0x18, regs.A);
+    EXPECT_EQ(0x80, alu(0xEE, 0x5A, 0x5A));     // XOR
+    EXPECT_EQ(0x00, alu(0xF6, 0x5A, 0x03));     // OR
+    EXPECT_EQ(0x5B, regs.A);
+    EXPECT_EQ(0x50, alu(0xFE, 0x3C, 0x40));     // CP
+    EXPECT_EQ(0x3C, regs.A);
+}
+
+TEST_F(CPU_Test, Increment_And_Decimal_Adjust) {
+    load({
+        0x3C,           // INC A
+        0x05,           // DEC B
+        0x0D,           // DEC C
+        0x3E, 0x45,     // LD A,0x45
+        0xC6, 0x38,     // ADD A,0x38
+        0x27,           // DAA
+        0xD6, 0x38,     // SUB A,0x38
+        0x27,           // DAA
+    });
+    regs.A = 0xFF;
+    regs.B = 0x01;
+    regs.C = 0x10;
+    regs.F = 0x10;
+
+    run();
+    EXPECT_EQ(0x00, regs.A);
+    EXPECT_EQ(0xB0, regs.F);
+    run();
+    EXPECT_EQ(0xD0, regs.F);
+    run();
+    EXPECT_EQ(0x0F, regs.C);
+    EXPECT_EQ(0x70, regs.F);
+
+    run(3);
+    EXPECT_EQ(0x83, regs.A);
+    EXPECT_EQ(0x00, regs.F);
+    run(2);
+    EXPECT_EQ(0x45, regs.A);
+    EXPECT_EQ(0x40, regs.F);
+}
+
+TEST_F(CPU_Test, Wide_Arithmetic) {
+    load({
+        0x09,           // ADD HL,BC
+        0x29,           // ADD HL,HL
+        0xE8, 0x02,     // ADD SP,2
+        0xF8, 0xFF,     // LD HL,SP-1
+        0x0B,           // DEC BC
+        0xF9,           // LD SP,HL
+    });
+    regs.H = 0x8A;
+    regs.L = 0x23;
+    regs.B = 0x06;
+    regs.C = 0x05;
+    regs.F = 0x80;
+
+    EXPECT_EQ(2_MCycles, run());
+    EXPECT_EQ(0x9028, regs.get_HL());
+    EXPECT_EQ(0xA0, regs.F);
+    run();
+    EXPECT_EQ(0x2050, regs.get_HL());
+    EXPECT_EQ(0x90, regs.F);
+
+    regs.SP = 0xFFF8;
+    EXPECT_EQ(4_MCycles, run());
+    EXPECT_EQ(0xFFFA, regs.SP);
+    EXPECT_EQ(0x00, regs.F);
+    EXPECT_EQ(3_MCycles, run());
+    EXPECT_EQ(0xFFF9, regs.get_HL());
+    EXPECT_EQ(0x30, regs.F);
+
+    EXPECT_EQ(2_MCycles + 2_MCycles, run(2));
+    EXPECT_EQ(0x0604, regs.get_BC());
+    EXPECT_EQ(0xFFF9, regs.SP);
+}
+
+TEST_F(CPU_Test, Stack) {
+    load({
+        0xC5,           // PUSH BC
+        0xF1,           // POP AF
+        0xF5,           // PUSH AF
+        0xD1,           // POP DE
+    });
+    regs.B = 0x12;
+    regs.C = 0x3F;
+
+    EXPECT_EQ(4_MCycles + 3_MCycles, run(2));
+    EXPECT_EQ(0x12, regs.A);
+    EXPECT_EQ(0x30, regs.F);    // low nibble of F is always zero
+    EXPECT_EQ(STACK_VADDR, regs.SP);
+    EXPECT_EQ(0x3F, bus.read(STACK_VADDR - 2));
+
+    run(2);
+    EXPECT_EQ(0x1230, regs.get_DE());
+}
+
+TEST_F(CPU_Test, Branches) {
+    load({
+        0x20, 0x02,             // C000: JR NZ,+2
+        0x00, 0x00,             // C002: NOP, NOP
+        0x28, 0x10,             // C004: JR Z,+16
+        0xC4, 0x00, 0xC1,       // C006: CALL NZ,0xC100
+        0xCC, 0x00, 0xC1,       // C009: CALL Z,0xC100
+        0xC3, 0x00, 0xC2,       // C00C: JP 0xC200
+    });
+    load({
+        0xC8,                   // C100: RET Z
+        0xC0,                   // C101: RET NZ
+    }, 0xC100);
+    load({
+        0xEF,                   // C200: RST 0x28
+    }, 0xC200);
+    regs.F = 0x00;
+
+    EXPECT_EQ(3_MCycles, run());
+    EXPECT_EQ(0xC004, regs.PC);
+    EXPECT_EQ(2_MCycles, run());
+    EXPECT_EQ(0xC006, regs.PC);
+
+    EXPECT_EQ(6_MCycles, run());
+    EXPECT_EQ(0xC100, regs.PC);
+    EXPECT_EQ(2_MCycles, run());
+    EXPECT_EQ(5_MCycles, run());
+    EXPECT_EQ(0xC009, regs.PC);
+    EXPECT_EQ(STACK_VADDR, regs.SP);
+
+    EXPECT_EQ(3_MCycles, run());
+    EXPECT_EQ(4_MCycles, run());
+    EXPECT_EQ(0xC200, regs.PC);
+    EXPECT_EQ(4_MCycles, run());
+    EXPECT_EQ(0x0028, regs.PC);
+    EXPECT_EQ(0x01, bus.read(STACK_VADDR - 2));
+    EXPECT_EQ(0xC2, bus.read(STACK_VADDR - 1));
+}
+
+TEST_F(CPU_Test, Prefix_CB) {
+    load({
+        0xCB, 0x37,     // SWAP A
+        0xCB, 0x11,     // RL C
+        0xCB, 0x2A,     // SRA D
+        0xCB, 0x7E,     // BIT 7,(HL)
+        0xCB, 0xDE,     // SET 3,(HL)
+        0xCB, 0x86,     // RES 0,(HL)
+        0xCB, 0x46,     // BIT 0,(HL)
+    });
+    regs.A = 0xF1;
+    regs.C = 0x80;
+    regs.D = 0x81;
+    regs.H = 0xC1;
+    regs.L = 0x00;
+    bus.write(0xC100, 0x81);
+
+    EXPECT_EQ(2_MCycles, run());
+    EXPECT_EQ(0x1F, regs.A);
+    EXPECT_EQ(0x00, regs.F);
+    run();
+    EXPECT_EQ(0x00, regs.C);
+    EXPECT_EQ(0x90, regs.F);
+    run();
+    EXPECT_EQ(0xC0, regs.D);
+    EXPECT_EQ(0x10, regs.F);
+
+    EXPECT_EQ(3_MCycles, run());
+    EXPECT_EQ(0x30, regs.F);
+    EXPECT_EQ(4_MCycles + 4_MCycles, run(2));
+    EXPECT_EQ(0x88, bus.read(0xC100));
+    run();
+    EXPECT_EQ(0xB0, regs.F);
+}
+
+TEST_F(CPU_Test, Interrupt_Dispatch) {
+    load({
+        0xFB,           // EI
+        0x00,           // NOP
+        0x00,           // NOP
+    });
+    int_ctrl.set_IE_reg(IntController::interrupts<IntController::TIMOVER_INT, IntController::JOYPAD_INT>);
+    int_ctrl.request_interrupt(IntController::JOYPAD_INT);
+    int_ctrl.request_interrupt(IntController::TIMOVER_INT);
+
+    // IME is enabled after the instruction, which follows EI
+    run(2);
+    EXPECT_EQ(0xC002, regs.PC);
+    EXPECT_TRUE(int_ctrl.get_IME_reg());
+
+    EXPECT_EQ(CPU::INTERRUPT_CYCLES, run());
+    EXPECT_EQ(IntController::TIMOVER_JMP, regs.PC);
+    EXPECT_FALSE(int_ctrl.get_IME_reg());
+    EXPECT_EQ(0xF0, int_ctrl.get_IF_reg() & 0xF4);
+    EXPECT_EQ(0x02, bus.read(STACK_VADDR - 2));
+
+    // RETI returns with IME set, and next interrupt is dispatched
+    load({ 0xD9 }, 0xC050);
+    regs.PC = 0xC050;
+    run();
+    EXPECT_EQ(0xC002, regs.PC);
+    EXPECT_TRUE(int_ctrl.get_IME_reg());
+    run();
+    EXPECT_EQ(IntController::JOYPAD_JMP, regs.PC);
+}
+
+TEST_F(CPU_Test, EI_DI) {
+    load({
+        0xFB,           // EI
+        0xF3,           // DI
+        0x00,           // NOP
+    });
+    int_ctrl.set_IE_reg(IntController::interrupts<IntController::TIMOVER_INT>);
+    int_ctrl.request_interrupt(IntController::TIMOVER_INT);
+
+    run(3);
+    EXPECT_EQ(0xC003, regs.PC);
+    EXPECT_FALSE(int_ctrl.get_IME_reg());
+}
+
+TEST_F(CPU_Test, Halt) {
+    load({
+        0x76,           // HALT
+        0x3C,           // INC A
+        0x76,           // HALT
+        0x3C,           // INC A
+    });
+    regs.A = 0x0;
+    int_ctrl.set_IE_reg(IntController::interrupts<IntController::TIMOVER_INT>);
+
+    run();
+    EXPECT_TRUE(cpu.is_halted());
+    EXPECT_EQ(CPU::IDLE_CYCLES, run());
+    EXPECT_EQ(0xC001, regs.PC);
+
+    // interrupt wakes up CPU without IME
+    int_ctrl.request_interrupt(IntController::TIMOVER_INT);
+    run();
+    EXPECT_FALSE(cpu.is_halted());
+    EXPECT_EQ(0x1, regs.A);
+
+    // HALT with a pending interrupt and without IME doesn't halt, and reads INC A twice
+    run();
+    EXPECT_FALSE(cpu.is_halted());
+    run(2);
+    EXPECT_EQ(0x3, regs.A);
+    EXPECT_EQ(0xC004, regs.PC);
+}
+
+TEST_F(CPU_Test, Illegal_Opcode) {
+    load({ 0xD3, 0x3C });
+
+    run();
+    EXPECT_TRUE(cpu.is_locked());
+    int_ctrl.set_IME_reg(true);
+    int_ctrl.set_IE_reg(IntController::interrupts<IntController::VBLANK_INT>);
+    int_ctrl.request_interrupt(IntController::VBLANK_INT);
+    EXPECT_EQ(CPU::IDLE_CYCLES, run());
+    EXPECT_EQ(0xC001, regs.PC);
+}
+
+TEST_F(CPU_Test, Blocks_Same_As_Steps) {
+    const std::initializer_list<byte_t> program = {
+        0x21, 0x00, 0xC1,       // C000: LD HL,0xC100
+        0x11, 0x00, 0xC2,       // C003: LD DE,0xC200
+        0x0E, 0x40,             // C006: LD C,0x40
+        0x2A,                   // C008: LD A,(HL+)
+        0xCD, 0x12, 0xC0,       // C009: CALL 0xC012
+        0x12,                   // C00C: LD (DE),A
+        0x1C,                   // C00D: INC E
+        0x0D,                   // C00E: DEC C
+        0x20, 0xF7,             // C00F: JR NZ,0xC008
+        0x76,                   // C011: HALT
+        0x80,                   // C012: ADD A,B
+        0x47,                   // C013: LD B,A
+        0xCB, 0x30,             // C014: SWAP B
+        0xC5,                   // C016: PUSH BC
+        0xC1,                   // C017: POP BC
+        0xD0,                   // C018: RET NC
+        0x04,                   // C019: INC B
+        0xC9,                   // C01A: RET
+    };
+    const CPU::Registers init_regs = regs;
+    CPU block_cpu(&bus, &int_ctrl, init_regs);
+
+    load(program);
+    for (unsigned idx = 0; idx < 0x40; ++idx)
+        bus.write(word_t(0xC100 + idx), byte_t(idx * 37));
+
+    clk_cycle_t step_cycles = 0;
+    while (!cpu.is_halted())
+        step_cycles += run();
+    byte_t step_results[0x40];
+    for (unsigned idx = 0; idx < 0x40; ++idx) {
+        step_results[idx] = bus.read(word_t(0xC200 + idx));
+        bus.write(word_t(0xC200 + idx), 0x0);
+    }
+
+    clk_cycle_t block_cycles = 0;
+    while (!block_cpu.is_halted())
+        block_cycles += block_cpu.execute_block(scheduler, devsync::Scheduler::NEVER);
+
+    const CPU::Registers& block_regs = block_cpu.get_registers();
+    EXPECT_EQ(step_cycles, block_cycles);
+    EXPECT_EQ(block_cycles, scheduler.get_time());
+    EXPECT_EQ(regs.get_AF(), block_regs.get_AF());
+    EXPECT_EQ(regs.get_BC(), block_regs.get_BC());
+    EXPECT_EQ(regs.get_DE(), block_regs.get_DE());
+    EXPECT_EQ(regs.get_HL(), block_regs.get_HL());
+    EXPECT_EQ(regs.SP, block_regs.SP);
+    EXPECT_EQ(regs.PC, block_regs.PC);
+    for (unsigned idx = 0; idx < 0x40; ++idx)
+        EXPECT_EQ(step_results[idx], bus.read(word_t(0xC200 + idx)));
+}
+
+TEST_F(CPU_Test, Self_Modifying_Code) {
+    // both WRAM and its echo address patch the immediate of LD B
+    for (word_t patch_vaddr : { word_t(0xC001), word_t(0xE001) }) {
+        load({
+            0x06, 0x00,                                             // C000: LD B,0x00
+            0x04,                                                   // C002: INC B
+            0x78,                                                   // C003: LD A,B
+            0xEA, byte_t(patch_vaddr), byte_t(patch_vaddr >> 8),    // C004: LD (patch_vaddr),A
+            0x18, 0xF7,                                             // C007: JR 0xC000
+        });
+        regs.PC = PROGRAM_VADDR;
+
+        // the write ends the block, and JR is the next one
+        for (byte_t iteration = 1; iteration <= 3; ++iteration) {
+            EXPECT_EQ(2_MCycles + 1_MCycles + 1_MCycles + 4_MCycles, run_blocks());
+            EXPECT_EQ(iteration, regs.B);
+            EXPECT_EQ(0xC007, regs.PC);
+            run_blocks();
+        }
+    }
+}
+
+TEST_F(CPU_Test, Block_IO_Time) {
+    Timer timer(&int_ctrl, &scheduler);
+
+    timer.map_to_memory(bus);
+    load({
+        0xC5, 0xC5, 0xC5, 0xC5, 0xC5, 0xC5, 0xC5, 0xC5,     // PUSH BC (x16)
+        0xC5, 0xC5, 0xC5, 0xC5, 0xC5, 0xC5, 0xC5, 0xC5,
+        0xF0, 0x04,                                         // LDH A,(DIV)
+        0x3C,                                               // INC A
+        0x76,                                               // HALT
+    });
+
+    // block doesn't pass the next event, so CPU executes one instruction
+    bus.write(Vaddr::DIV_VADDR, 0x0);
+    const devsync::Scheduler::event_id_t event = scheduler.register_event([](void*, clk_cycle_t) {}, nullptr);
+    scheduler.schedule(event, 8);
+    EXPECT_EQ(4_MCycles, run_blocks());
+    EXPECT_EQ(0xC001, regs.PC);
+
+    // DIV is read at 256 cycles after the reset, and the read ends the block
+    EXPECT_EQ(15 * 4_MCycles + 3_MCycles, run_blocks());
+    EXPECT_EQ(0x1, regs.A);
+    EXPECT_EQ(0xC012, regs.PC);
+    EXPECT_EQ(2_MCycles, run_blocks());
+    EXPECT_EQ(0x2, regs.A);
+    EXPECT_TRUE(cpu.is_halted());
+}
+
+}  // namespace
@@ -0,0 +1,175 @@
+#include <memory_resource>
+
+#include "gtest/gtest.h"
+
+#include "GB_test.h"
+
+#include "common/GB_dbuffer.h"
+#include "common/GB_memory_resource.h"
+
+namespace {
+
+constexpr size_t PAGE_SIZE = dbuffer_t::PAGE_SIZE;
+
+dbuffer_t make_buffer(size_t size) {
+    dbuffer_t buffer(size);
+
+    for (size_t offset = 0; offset < size; ++offset)
+        buffer[offset] = uint8_t(offset / PAGE_SIZE + 1);
+    return buffer;
+}
+
+TEST(Dynamic_Buffer, Share) {
+    dbuffer_t buffer = make_buffer(PAGE_SIZE * 2 + 0x10);
+
+    buffer.share();
+    EXPECT_TRUE(buffer.is_shared());
+    EXPECT_EQ(nullptr, buffer.get_page_wr_addr(0));
+    EXPECT_EQ(nullptr, buffer.get_page_wr_addr(2));
+
+    const dbuffer_t& const_buffer = buffer;
+    EXPECT_EQ(0x1, const_buffer[0x0]);
+    EXPECT_EQ(0x3, const_buffer[PAGE_SIZE * 2 + 0xF]);
+
+    // views can't be shared
+    uint8_t     ext_data[0x10] = {};
+    dbuffer_t   view = dbuffer_t::view(ext_data, sizeof(ext_data));
+    view.share();
+    EXPECT_FALSE(view.is_shared());
+}
+
+TEST(Dynamic_Buffer, Copy_On_Write) {
+    dbuffer_t source = make_buffer(PAGE_SIZE * 4);
+    source.share();
+
+    dbuffer_t fork(source);
+    EXPECT_TRUE(fork.is_shared());
+
+    // not modified pages are the same memory
+    for (size_t page_idx = 0; page_idx < 4; ++page_idx)
+        EXPECT_EQ(source.get_page_rd_addr(page_idx), fork.get_page_rd_addr(page_idx));
+
+    // first write copies a single page
+    fork[PAGE_SIZE + 0x1] = 0x42;
+    EXPECT_NE(source.get_page_rd_addr(1), fork.get_page_rd_addr(1));
+    EXPECT_NE(nullptr, fork.get_page_wr_addr(1));
+    EXPECT_EQ(nullptr, fork.get_page_wr_addr(2));
+    EXPECT_EQ(source.get_page_rd_addr(2), fork.get_page_rd_addr(2));
+
+    const dbuffer_t& const_source = source;
+    const dbuffer_t& const_fork = fork;
+    EXPECT_EQ(0x2, const_source[PAGE_SIZE + 0x1]);
+    EXPECT_EQ(0x42, const_fork[PAGE_SIZE + 0x1]);
+    EXPECT_EQ(0x2, const_fork[PAGE_SIZE + 0x2]);
+
+    // fork of a fork gets private pages of the parent
+    dbuffer_t fork_of_fork(fork);
+    EXPECT_EQ(0x42, static_cast<const dbuffer_t&>(fork_of_fork)[PAGE_SIZE + 0x1]);
+    EXPECT_EQ(source.get_page_rd_addr(3), fork_of_fork.get_page_rd_addr(3));
+
+    // buffer with all pages copied is not shared anymore
+    fork.unshare();
+    EXPECT_FALSE(fork.is_shared());
+    EXPECT_EQ(0x42, fork[PAGE_SIZE + 0x1]);
+    EXPECT_EQ(0x4, fork[PAGE_SIZE * 3]);
+    EXPECT_EQ(fork.get_data_addr() + PAGE_SIZE, fork.get_page_rd_addr(1));
+
+    // content of the source is still frozen
+    EXPECT_EQ(0x2, const_source[PAGE_SIZE + 0x1]);
+}
+
+TEST(Dynamic_Buffer, Copy_Shared_Into_View) {
+    dbuffer_t source = make_buffer(PAGE_SIZE * 2);
+    source.share();
+    source[PAGE_SIZE] = 0x42;
+
+    uint8_t     ext_data[PAGE_SIZE * 2] = {};
+    dbuffer_t   view = dbuffer_t::view(ext_data, sizeof(ext_data));
+
+    view = source;
+    EXPECT_EQ(0x1, ext_data[0x0]);
+    EXPECT_EQ(0x42, ext_data[PAGE_SIZE]);
+    EXPECT_EQ(0x2, ext_data[PAGE_SIZE + 0x1]);
+}
+
+bool is_aligned(const void* addr, size_t alignment) {
+    return reinterpret_cast<uintptr_t>(addr) % alignment == 0;
+}
+
+TEST(Dynamic_Buffer, Alignment) {
+    dbuffer_t buffer = dbuffer_t::aligned(0x1234);
+
+    EXPECT_EQ(dbuffer_t::CACHE_LINE_ALIGNMENT, buffer.get_alignment());
+    EXPECT_TRUE(is_aligned(buffer.get_data_addr(), dbuffer_t::CACHE_LINE_ALIGNMENT));
+
+    // copies and shared pages keep alignment
+    dbuffer_t copy(buffer);
+    EXPECT_TRUE(is_aligned(copy.get_data_addr(), dbuffer_t::CACHE_LINE_ALIGNMENT));
+
+    copy.share();
+    dbuffer_t fork(copy);
+    EXPECT_TRUE(is_aligned(fork.get_page_rd_addr(0), dbuffer_t::CACHE_LINE_ALIGNMENT));
+    EXPECT_TRUE(is_aligned(fork.privatize_page(0), dbuffer_t::CACHE_LINE_ALIGNMENT));
+}
+
+TEST(Dynamic_Buffer, Memory_Resource) {
+    std::pmr::monotonic_buffer_resource upstream;
+    std::pmr::monotonic_buffer_resource other_upstream;
+
+    dbuffer_t buffer(0x100, &upstream, 0x100);
+    EXPECT_EQ(&upstream, buffer.get_memory_resource());
+    EXPECT_TRUE(is_aligned(buffer.get_data_addr(), 0x100));
+
+    // copy constructed buffer uses memory resource of the source
+    dbuffer_t copy(buffer);
+    EXPECT_EQ(&upstream, copy.get_memory_resource());
+    EXPECT_EQ(0x100u, copy.get_alignment());
+
+    // assigned buffer keeps own memory resource
+    dbuffer_t assigned(0x10, &other_upstream);
+    assigned = buffer;
+    EXPECT_EQ(&other_upstream, assigned.get_memory_resource());
+    EXPECT_EQ(0x100u, assigned.size());
+
+    // moved buffer takes memory resource with the memory
+    const uint8_t* const data = buffer.get_data_addr();
+    dbuffer_t moved(std::move(buffer));
+    EXPECT_EQ(&upstream, moved.get_memory_resource());
+    EXPECT_EQ(data, moved.get_data_addr());
+
+    // move assigned buffer takes memory of an equal resource only, and copies the other one
+    dbuffer_t same(0x10, &upstream, 0x100);
+    same = std::move(moved);
+    EXPECT_EQ(data, same.get_data_addr());
+
+    dbuffer_t other(0x10, &other_upstream, 0x100);
+    same[0x0] = 0xAB;
+    other = std::move(same);
+    EXPECT_EQ(&other_upstream, other.get_memory_resource());
+    EXPECT_NE(data, other.get_data_addr());
+    EXPECT_EQ(0x100u, other.size());
+    EXPECT_EQ(0xAB, other[0x0]);
+}
+
+TEST(Dynamic_Buffer, Huge_Pages) {
+    hugepage_resource_t                     hugepages;
+    std::pmr::monotonic_buffer_resource     pool(hugepage_resource_t::HUGE_PAGE_SIZE, &hugepages);
+
+    void* block = hugepages.allocate(0x100, dbuffer_t::CACHE_LINE_ALIGNMENT);
+    EXPECT_TRUE(is_aligned(block, hugepage_resource_t::HUGE_PAGE_SIZE));
+    static_cast<uint8_t*>(block)[0xFF] = 0x42;
+    hugepages.deallocate(block, 0x100, dbuffer_t::CACHE_LINE_ALIGNMENT);
+
+    // buffers of many instances are packed into a few huge pages
+    dbuffer_t first(0x8000, &pool, dbuffer_t::CACHE_LINE_ALIGNMENT);
+    dbuffer_t second(0x8000, &pool, dbuffer_t::CACHE_LINE_ALIGNMENT);
+    const auto distance = reinterpret_cast<uintptr_t>(second.get_data_addr())
+                        - reinterpret_cast<uintptr_t>(first.get_data_addr());
+
+    EXPECT_TRUE(is_aligned(first.get_data_addr(), dbuffer_t::CACHE_LINE_ALIGNMENT));
+    EXPECT_TRUE(is_aligned(second.get_data_addr(), dbuffer_t::CACHE_LINE_ALIGNMENT));
+    EXPECT_LT(distance, hugepage_resource_t::HUGE_PAGE_SIZE);
+    EXPECT_TRUE(hugepages.is_equal(hugepage_resource_t()));
+}
+
+}  // namespace
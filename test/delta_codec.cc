@@ -0,0 +1,92 @@
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "GB_test.h"
+
+#include "common/GB_delta_codec.h"
+
+namespace {
+
+/** Round trip of the image against the reference */
+void check_round_trip(const std::vector<uint8_t>& image, const std::vector<uint8_t>& reference) {
+    std::vector<uint8_t> encoded(delta_codec_t::max_encoded_size(image.size()));
+    std::vector<uint8_t> buffer(reference);
+
+    const size_t size = delta_codec_t::encode(image.data(), reference.data(), image.size(), encoded.data());
+    EXPECT_LE(size, encoded.size());
+    EXPECT_TRUE(delta_codec_t::decode(encoded.data(), size, buffer.data(), buffer.size()));
+    EXPECT_EQ(image, buffer);
+
+    // the same delta turns the image back into the reference
+    EXPECT_TRUE(delta_codec_t::decode(encoded.data(), size, buffer.data(), buffer.size()));
+    EXPECT_EQ(reference, buffer);
+}
+
+TEST(Delta_Codec, Round_Trip) {
+    std::vector<uint8_t> reference(0x4000 + 5);
+    std::vector<uint8_t> image;
+
+    for (size_t idx = 0; idx < reference.size(); ++idx)
+        reference[idx] = uint8_t(idx * 7 + 3);
+
+    image = reference;
+    check_round_trip(image, reference);
+
+    // sparse changes, including the tail after the last whole word
+    image[0x0] ^= 0x1;
+    image[0x123] = 0x0;
+    image[0x2000] = 0xAA;
+    image[0x2007] = 0x55;
+    image.back() ^= 0x80;
+    check_round_trip(image, reference);
+
+    // incompressible image
+    for (size_t idx = 0; idx < image.size(); ++idx)
+        image[idx] = uint8_t(~reference[idx]);
+    check_round_trip(image, reference);
+}
+
+TEST(Delta_Codec, Long_Runs) {
+    // runs longer than a token
+    const size_t len = delta_codec_t::WORD_SIZE * (delta_codec_t::MAX_RUN * 2 + 10);
+    std::vector<uint8_t> reference(len, 0x0);
+    std::vector<uint8_t> image(len, 0x0);
+
+    check_round_trip(image, reference);
+    for (size_t idx = 0; idx < len / 2; ++idx)
+        image[idx] = 0xFF;
+    check_round_trip(image, reference);
+
+    std::vector<uint8_t> encoded(delta_codec_t::max_encoded_size(len));
+    EXPECT_GT(len / 1000, delta_codec_t::encode(reference.data(), nullptr, len, encoded.data()));
+}
+
+TEST(Delta_Codec, Sparse_Delta_Size) {
+    std::vector<uint8_t> reference(0x8000, 0x5A);
+    std::vector<uint8_t> image(reference);
+    std::vector<uint8_t> encoded(delta_codec_t::max_encoded_size(image.size()));
+
+    image[0x100] = 0x0;
+    image[0x4000] = 0x0;
+
+    // two tokens of a single literal word and the last token of zeros
+    const size_t size = delta_codec_t::encode(image.data(), reference.data(), image.size(), encoded.data());
+    EXPECT_EQ(3 * delta_codec_t::TOKEN_HEADER_SIZE + 2 * delta_codec_t::WORD_SIZE, size);
+}
+
+TEST(Delta_Codec, Corrupted) {
+    std::vector<uint8_t> image(0x100, 0x1);
+    std::vector<uint8_t> buffer(0x100, 0x0);
+    std::vector<uint8_t> encoded(delta_codec_t::max_encoded_size(image.size()));
+
+    const size_t size = delta_codec_t::encode(image.data(), nullptr, image.size(), encoded.data());
+
+    // truncated stream and an image of another size
+    EXPECT_FALSE(delta_codec_t::decode(encoded.data(), size - 1, buffer.data(), buffer.size()));
+    EXPECT_FALSE(delta_codec_t::decode(encoded.data(), size, buffer.data(), buffer.size() / 2));
+    EXPECT_TRUE(delta_codec_t::decode(encoded.data(), size, buffer.data(), buffer.size()));
+    EXPECT_EQ(image, buffer);
+}
+
+}  // namespace
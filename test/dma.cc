@@ -0,0 +1,155 @@
+#include "gtest/gtest.h"
+
+#include "GB_test.h"
+
+#include "common/GB_clock.h"
+#include "common/GB_scheduler.h"
+#include "device/GB_dma.h"
+#include "device/GB_hram.h"
+#include "device/GB_oram.h"
+#include "device/GB_vram.h"
+#include "device/GB_wram.h"
+#include "memory/GB_bus.h"
+#include "memory/GB_vaddr.h"
+
+namespace {
+
+using Bus = GB::memory::BusInterface;
+using DMA = GB::device::DMA;
+using ORAM = GB::device::ORAM;
+using WRAM = GB::device::WRAM<GB::CGB_MODE>;
+using Vaddr = GB::memory::VirtualAddress;
+
+struct DMA_Test : public ::testing::Test {
+    Bus                 bus;
+    devsync::Scheduler  scheduler;
+    WRAM                wram;
+    ORAM                oram;
+    GB::device::HRAM    hram;
+    DMA                 dma;
+
+    DMA_Test() : dma(&oram, &scheduler) {
+        wram.map_to_memory(bus);
+        oram.map_to_memory(bus);
+        hram.map_to_memory(bus);
+        dma.map_to_memory(bus);
+        for (word_t offset = 0; offset < DMA::TRANSFER_SIZE; ++offset) {
+            wram.write_inner_vaddr(offset, byte_t(offset + 1));
+            wram.write_inner_vaddr(0x1000 + offset, byte_t(offset + 2));
+        }
+    }
+};
+
+TEST_F(DMA_Test, Transfer_Timing) {
+    bus.write(Vaddr::DMA_VADDR, 0xC0);
+    EXPECT_EQ(0xC0, bus.read(Vaddr::DMA_VADDR));
+    EXPECT_FALSE(dma.is_active());
+
+    // bus is locked after startup M-cycle
+    scheduler.advance(DMA::STARTUP_CYCLES);
+    EXPECT_TRUE(dma.is_active());
+    EXPECT_TRUE(bus.is_locked(0xC000));
+    EXPECT_TRUE(bus.is_locked(0x0000));
+    EXPECT_FALSE(bus.is_locked(0x8000));
+    EXPECT_FALSE(bus.is_locked(0xFF80));
+
+    // nothing is copied until OAM is observed
+    scheduler.advance(10_MCycles);
+    EXPECT_EQ(0x0, oram.read_phys_addr(0));
+    dma.sync();
+    EXPECT_EQ(0x1, oram.read_phys_addr(0));
+    EXPECT_EQ(0xA, oram.read_phys_addr(9));
+    EXPECT_EQ(0x0, oram.read_phys_addr(10));
+
+    scheduler.advance(DMA::TRANSFER_CYCLES - 10_MCycles - 1);
+    EXPECT_TRUE(dma.is_active());
+    scheduler.advance(1);
+    EXPECT_FALSE(dma.is_active());
+    EXPECT_FALSE(bus.is_locked(0xC000));
+    for (word_t offset = 0; offset < DMA::TRANSFER_SIZE; ++offset)
+        EXPECT_EQ(byte_t(offset + 1), bus.read(Vaddr::OAM_RAM_BASE_VADDR + offset));
+}
+
+TEST_F(DMA_Test, Bus_Lockout) {
+    bus.write(0xFF80, 0x12);
+    bus.write(Vaddr::DMA_VADDR, 0xC0);
+    scheduler.advance(DMA::STARTUP_CYCLES + 5_MCycles);
+
+    // source bus gives the byte which is being transferred, OAM gives 0xFF
+    EXPECT_EQ(0x6, bus.read(0xD123));
+    EXPECT_EQ(0x6, bus.read(0x0000));
+    EXPECT_EQ(Bus::OPEN_BUS_VALUE, bus.read(0xFE00));
+    bus.write(0xC000, 0x77);
+    bus.write(0xFE00, 0x77);
+    EXPECT_EQ(0x12, bus.read(0xFF80));
+
+    scheduler.advance(DMA::TRANSFER_CYCLES);
+    EXPECT_EQ(0x1, bus.read(0xC000));
+    EXPECT_EQ(0x1, bus.read(0xFE00));
+}
+
+TEST_F(DMA_Test, Source_Remap) {
+    bus.write(0xFF70, 0x1);
+    bus.write(Vaddr::DMA_VADDR, 0xD0);
+    scheduler.advance(DMA::STARTUP_CYCLES + 20_MCycles);
+
+    // bank switch in the middle of the transfer, bytes before it are from the old bank
+    wram.set_SVBK_reg(0x2);
+    scheduler.advance(DMA::TRANSFER_CYCLES);
+    EXPECT_EQ(0x2, oram.read_phys_addr(0));
+    EXPECT_EQ(0x15, oram.read_phys_addr(19));
+    EXPECT_EQ(wram.read_phys_addr(0x2000 + 20), oram.read_phys_addr(20));
+}
+
+TEST_F(DMA_Test, Echo_Source_And_Restart) {
+    bus.write(Vaddr::DMA_VADDR, 0xD0);
+    scheduler.advance(DMA::STARTUP_CYCLES + 4_MCycles);
+
+    // restarted transfer continues until the new one starts
+    bus.write(Vaddr::DMA_VADDR, 0xE0);
+    scheduler.advance(DMA::STARTUP_CYCLES);
+    EXPECT_EQ(0x2, oram.read_phys_addr(0));
+    EXPECT_EQ(0x6, oram.read_phys_addr(4));
+    EXPECT_TRUE(dma.is_active());
+
+    scheduler.advance(DMA::TRANSFER_CYCLES);
+    EXPECT_FALSE(dma.is_active());
+    EXPECT_EQ(0x1, oram.read_phys_addr(0));
+    EXPECT_EQ(0xA0, oram.read_phys_addr(159));
+}
+
+TEST_F(DMA_Test, Objects_Index) {
+    wram.write_inner_vaddr(0x0, 16 + 30);
+    bus.write(Vaddr::DMA_VADDR, 0xC0);
+    scheduler.advance(DMA::STARTUP_CYCLES + DMA::TRANSFER_CYCLES);
+
+    // objects 10 and 11 of the source pattern are on the line too
+    EXPECT_EQ(ORAM::objects_mask_t((1 << 0) | (1 << 10) | (1 << 11)), oram.get_line_objects(30, false));
+}
+
+TEST(DMA, Video_Bus_Source) {
+    Bus                             bus;
+    devsync::Scheduler              scheduler;
+    GB::device::VRAM<GB::CGB_MODE>  vram;
+    WRAM                            wram;
+    ORAM                            oram;
+    DMA                             dma(&oram, &scheduler);
+
+    vram.map_to_memory(bus);
+    wram.map_to_memory(bus);
+    oram.map_to_memory(bus);
+    dma.map_to_memory(bus);
+    vram.write_inner_vaddr(0x100, 0x42);
+
+    bus.write(Vaddr::DMA_VADDR, 0x81);
+    scheduler.advance(DMA::STARTUP_CYCLES);
+    EXPECT_TRUE(bus.is_locked(0x8000));
+    EXPECT_FALSE(bus.is_locked(0xC000));
+    bus.write(0xC000, 0x5);
+    EXPECT_EQ(0x5, bus.read(0xC000));
+
+    scheduler.advance(DMA::TRANSFER_CYCLES);
+    EXPECT_EQ(0x42, oram.read_phys_addr(0));
+}
+
+}  // namespace
@@ -0,0 +1,129 @@
+#include "gtest/gtest.h"
+
+#include "GB_test.h"
+
+#include "device/GB_hdma.h"
+#include "device/GB_vram.h"
+#include "device/GB_wram.h"
+#include "memory/GB_bus.h"
+#include "memory/GB_vaddr.h"
+
+namespace {
+
+using Bus = GB::memory::BusInterface;
+using HDMA = GB::device::HDMA<GB::CGB_MODE>;
+using VRAM = GB::device::VRAM<GB::CGB_MODE>;
+using WRAM = GB::device::WRAM<GB::CGB_MODE>;
+using Vaddr = GB::memory::VirtualAddress;
+
+struct HDMA_Test : public ::testing::Test {
+    Bus     bus;
+    WRAM    wram;
+    VRAM    vram;
+    HDMA    hdma;
+
+    HDMA_Test() : hdma(&vram) {
+        wram.map_to_memory(bus);
+        vram.map_to_memory(bus);
+        hdma.map_to_memory(bus);
+        for (word_t offset = 0; offset < 0x200; ++offset)
+            wram.write_inner_vaddr(offset, byte_t(offset + 1));
+        for (word_t phys_addr = 0; phys_addr < VRAM::MAX_SIZE; ++phys_addr)
+            vram.write_phys_addr(phys_addr, 0x0);
+    }
+
+    void set_transfer(word_t source, word_t dest) {
+        bus.write(Vaddr::HDMA1_VADDR, byte_t(source >> 8));
+        bus.write(Vaddr::HDMA2_VADDR, byte_t(source));
+        bus.write(Vaddr::HDMA3_VADDR, byte_t(dest >> 8));
+        bus.write(Vaddr::HDMA4_VADDR, byte_t(dest));
+    }
+};
+
+TEST_F(HDMA_Test, General_Purpose) {
+    bus.write(Vaddr::VBK_VADDR, 0x1);
+    set_transfer(0xC00F, 0x8015);   // low nibbles are ignored
+    bus.write(Vaddr::HDMA5_VADDR, 0x02);
+
+    for (word_t offset = 0; offset < 3 * HDMA::BLOCK_SIZE; ++offset)
+        EXPECT_EQ(byte_t(offset + 1), vram.read_phys_addr(GB::VRAM_BANK_SIZE + 0x10 + offset));
+    EXPECT_EQ(0x0, vram.read_phys_addr(0x10));
+    EXPECT_EQ(0x0, vram.read_phys_addr(GB::VRAM_BANK_SIZE + 0x40));
+    EXPECT_EQ(0xFF, bus.read(Vaddr::HDMA5_VADDR));
+    EXPECT_EQ(3 * HDMA::BLOCK_CYCLES, hdma.take_stall_cycles());
+    EXPECT_EQ(0, hdma.take_stall_cycles());
+
+    // tile cache sees transferred rows
+    const byte_t* row = vram.get_tile_row(1, 1, 0);
+    for (unsigned x = 0; x < 8; ++x)
+        EXPECT_EQ(byte_t((((0x2 >> (7 - x)) & 1) << 1) | ((0x1 >> (7 - x)) & 1)), row[x]);
+}
+
+TEST_F(HDMA_Test, HBlank_Blocks) {
+    set_transfer(0xC000, 0x8000);
+    bus.write(Vaddr::HDMA5_VADDR, 0x81);
+    EXPECT_TRUE(hdma.is_active());
+    EXPECT_EQ(0x01, bus.read(Vaddr::HDMA5_VADDR));
+    EXPECT_EQ(0x0, vram.read_phys_addr(0x0));
+
+    hdma.on_hblank();
+    EXPECT_EQ(0x00, bus.read(Vaddr::HDMA5_VADDR));
+    EXPECT_EQ(0x10, vram.read_phys_addr(0xF));
+    EXPECT_EQ(0x0, vram.read_phys_addr(0x10));
+
+    hdma.on_hblank();
+    EXPECT_FALSE(hdma.is_active());
+    EXPECT_EQ(0xFF, bus.read(Vaddr::HDMA5_VADDR));
+    EXPECT_EQ(0x20, vram.read_phys_addr(0x1F));
+    EXPECT_EQ(2 * HDMA::BLOCK_CYCLES, hdma.take_stall_cycles());
+
+    hdma.on_hblank();
+    EXPECT_EQ(0x0, vram.read_phys_addr(0x20));
+}
+
+TEST_F(HDMA_Test, Stop_HBlank_Transfer) {
+    set_transfer(0xC000, 0x8000);
+    bus.write(Vaddr::HDMA5_VADDR, 0x83);
+    hdma.on_hblank();
+
+    // stopped transfer reports remaining blocks
+    bus.write(Vaddr::HDMA5_VADDR, 0x00);
+    EXPECT_FALSE(hdma.is_active());
+    EXPECT_EQ(0x82, bus.read(Vaddr::HDMA5_VADDR));
+
+    hdma.on_hblank();
+    EXPECT_EQ(0x0, vram.read_phys_addr(0x10));
+    EXPECT_EQ(HDMA::BLOCK_CYCLES, hdma.take_stall_cycles());
+}
+
+TEST_F(HDMA_Test, Page_And_Bank_Wrap) {
+    set_transfer(0xC0F0, 0x9FF0);
+    bus.write(Vaddr::HDMA5_VADDR, 0x01);
+
+    for (word_t offset = 0; offset < HDMA::BLOCK_SIZE; ++offset) {
+        EXPECT_EQ(byte_t(0xF0 + offset + 1), vram.read_phys_addr(0x1FF0 + offset));
+        EXPECT_EQ(byte_t(0x100 + offset + 1), vram.read_phys_addr(offset));
+    }
+}
+
+TEST_F(HDMA_Test, Registers) {
+    for (word_t vaddr = Vaddr::HDMA1_VADDR; vaddr <= Vaddr::HDMA4_VADDR; ++vaddr) {
+        bus.write(vaddr, 0x0);
+        EXPECT_EQ(Bus::OPEN_BUS_VALUE, bus.read(vaddr));
+    }
+    EXPECT_EQ(0xFF, bus.read(Vaddr::HDMA5_VADDR));
+}
+
+TEST(HDMA, Not_Mapped_Without_CGB_Banks) {
+    Bus                                 bus;
+    GB::device::VRAM<GB::DMG_MODE>      vram;
+    GB::device::HDMA<GB::DMG_MODE>      hdma(&vram);
+
+    vram.map_to_memory(bus);
+    hdma.map_to_memory(bus);
+    bus.write(Vaddr::HDMA5_VADDR, 0x00);
+    EXPECT_EQ(Bus::OPEN_BUS_VALUE, bus.read(Vaddr::HDMA5_VADDR));
+    EXPECT_EQ(0, hdma.take_stall_cycles());
+}
+
+}  // namespace
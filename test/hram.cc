@@ -0,0 +1,51 @@
+#include "gtest/gtest.h"
+
+#include "GB_test.h"
+
+#include "GB_config.h"
+#include "device/GB_hram.h"
+#include "memory/GB_bus.h"
+
+namespace {
+
+using HRAM = GB::device::HRAM;
+using Bus = GB::memory::BusInterface;
+
+TEST(High_RAM, Phys_Read_Write) {
+    HRAM hram;
+
+    EXPECT_EQ(hram.__memory.size(), GB::HRAM_SIZE);
+
+    hram.write_phys_addr(0x0, 0x1);
+    hram.write_phys_addr(0x7E, 0x2);
+
+    EXPECT_EQ(hram.read_phys_addr(0x0), 0x1);
+    EXPECT_EQ(hram.read_phys_addr(0x7E), 0x2);
+
+    HRAM hram_copy(hram);
+    EXPECT_EQ(hram_copy.read_phys_addr(0x0), 0x1);
+    EXPECT_EQ(hram_copy.read_phys_addr(0x7E), 0x2);
+}
+
+TEST(High_RAM, Memory_Bus) {
+    HRAM    hram;
+    Bus     bus;
+
+    hram.map_to_memory(bus);
+
+    bus.write(GB::memory::HRAM_BASE_VADDR, 0x11);
+    bus.write(GB::memory::HRAM_LAST_VADDR, 0x22);
+    EXPECT_EQ(hram.read_phys_addr(0x0), 0x11);
+    EXPECT_EQ(hram.read_phys_addr(0x7E), 0x22);
+
+    hram.write_phys_addr(0x10, 0x33);
+    EXPECT_EQ(bus.read(GB::memory::HRAM_BASE_VADDR + 0x10), 0x33);
+
+    // assigned device keeps own mapping
+    HRAM other;
+    other.write_phys_addr(0x10, 0x44);
+    hram = other;
+    EXPECT_EQ(bus.read(GB::memory::HRAM_BASE_VADDR + 0x10), 0x44);
+}
+
+}  // namespace
@@ -5,6 +5,7 @@
 
 #include "common/GB_macro.h"
 #include "device/GB_interrupt.h"
+#include "memory/GB_bus.h"
 #include "memory/GB_vaddr.h"
 
 namespace {
@@ -145,4 +146,35 @@ namespace {
         EXPECT_EQ(IntIdx::NO_INTERRUPT, int_ctrl.get_highest_priority_interrupt());
     }
 
+    TEST(Interrupt_Controller, Pending_Interrupt) {
+        InterruptController int_ctrl(InterruptController::Registers(0x0, 0x0, false));
+
+        // reserved bits don't wake up CPU
+        EXPECT_FALSE(int_ctrl.has_pending_interrupt());
+        int_ctrl.request_interrupt(InterruptController::TIMOVER_INT);
+        EXPECT_FALSE(int_ctrl.has_pending_interrupt());
+
+        // IME doesn't matter
+        int_ctrl.set_IE_reg(InterruptController::interrupts<InterruptController::TIMOVER_INT>);
+        EXPECT_TRUE(int_ctrl.has_pending_interrupt());
+        int_ctrl.reset_interrupt(InterruptController::TIMOVER_INT);
+        EXPECT_FALSE(int_ctrl.has_pending_interrupt());
+    }
+
+    TEST(Interrupt_Controller, Memory_Bus) {
+        GB::memory::BusInterface    bus;
+        InterruptController         int_ctrl(InterruptController::Registers(0x0, 0x0, true));
+
+        int_ctrl.map_to_memory(bus);
+
+        bus.write(GB::memory::IE_VADDR, 0x5);
+        bus.write(GB::memory::IF_VADDR, 0x3);
+        EXPECT_EQ(int_ctrl.get_IE_reg(), int_ctrl_reserved_bits(0x5));
+        EXPECT_EQ(int_ctrl.get_IF_reg(), int_ctrl_reserved_bits(0x3));
+
+        int_ctrl.request_interrupt(InterruptController::JOYPAD_INT);
+        EXPECT_EQ(bus.read(GB::memory::IF_VADDR), int_ctrl_reserved_bits(0x13));
+        EXPECT_EQ(bus.read(GB::memory::IE_VADDR), int_ctrl_reserved_bits(0x5));
+    }
+
 }  // namespace
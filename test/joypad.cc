@@ -3,7 +3,9 @@
 #include "GB_test.h"
 
 #include "common/GB_macro.h"
+#include "common/GB_scheduler.h"
 #include "device/GB_joypad.h"
+#include "memory/GB_bus.h"
 #include "memory/GB_vaddr.h"
 
 namespace {
@@ -144,4 +146,77 @@ TEST(Joy_Pad, Interrupts) {
     EXPECT_EQ(RAISED_JP_IF_VAL, int_ctrl.get_IF_reg());
 }
 
+TEST(Joy_Pad, Memory_Bus) {
+    GB::memory::BusInterface    bus;
+    JoyPad                      jp(nullptr);
+
+    jp.map_to_memory(bus);
+    jp.press_key(JoyPad::A_KEY);
+
+    bus.write(Vaddr::P1_VADDR, 0b010000);
+    EXPECT_EQ(set_P1_reserved_bits(0b011110), bus.read(Vaddr::P1_VADDR));
+
+    bus.write(Vaddr::P1_VADDR, 0b100000);
+    EXPECT_EQ(set_P1_reserved_bits(0b101111), bus.read(Vaddr::P1_VADDR));
+}
+
+TEST(Joy_Pad, Lazy_Sync) {
+    devsync::Scheduler  scheduler;
+    IntController       int_ctrl;
+    JoyPad              jp(&int_ctrl, scheduler.get_clock());
+
+    // key press is synchronized immediately
+    scheduler.advance(100_MCycles);
+    jp.press_key(JoyPad::A_KEY);
+    EXPECT_EQ(RAISED_JP_IF_VAL, int_ctrl.get_IF_reg());
+    EXPECT_EQ(scheduler.get_time(), jp.__sync.get_last_sync());
+
+    int_ctrl.reset_interrupt(IntController::JOYPAD_INT);
+    jp.press_key(JoyPad::A_KEY);
+    EXPECT_EQ(NO_JP_IF_VAL, int_ctrl.get_IF_reg());
+
+    // without access device isn't synchronized
+    scheduler.advance(1000_MCycles);
+    EXPECT_EQ(1000_MCycles, jp.__sync.elapsed());
+
+    jp.unpress_key(JoyPad::A_KEY);
+    jp.press_key(JoyPad::B_KEY);
+    EXPECT_EQ(RAISED_JP_IF_VAL, int_ctrl.get_IF_reg());
+    EXPECT_EQ(0, jp.__sync.elapsed());
+}
+
+TEST(Joy_Pad, Key_Set) {
+    devsync::Scheduler  scheduler;
+    IntController       int_ctrl;
+    JoyPad              jp(&int_ctrl, scheduler.get_clock());
+
+    // keys are pressed at once, and newly pressed keys raise the interrupt
+    jp.set_pressed_key_set(::bits_set(JoyPad::A_KEY, JoyPad::UP_KEY));
+    EXPECT_EQ(::bits_set(JoyPad::A_KEY, JoyPad::UP_KEY), jp.get_pressed_key_set());
+    EXPECT_EQ(RAISED_JP_IF_VAL, int_ctrl.get_IF_reg());
+
+    int_ctrl.reset_interrupt(IntController::JOYPAD_INT);
+    jp.set_pressed_key_set(::bits_set(JoyPad::A_KEY));
+    EXPECT_EQ(::bits_set(JoyPad::A_KEY), jp.get_pressed_key_set());
+    EXPECT_EQ(NO_JP_IF_VAL, int_ctrl.get_IF_reg());
+}
+
+TEST(Joy_Pad, Lazy_Sync_Memory_Bus) {
+    devsync::Scheduler          scheduler;
+    GB::memory::BusInterface    bus;
+    IntController               int_ctrl;
+    JoyPad                      jp(&int_ctrl, scheduler.get_clock());
+
+    jp.map_to_memory(bus);
+    jp.press_key(JoyPad::A_KEY);
+
+    scheduler.advance(10_MCycles);
+    bus.write(Vaddr::P1_VADDR, 0b010000);
+    EXPECT_EQ(scheduler.get_time(), jp.__sync.get_last_sync());
+
+    scheduler.advance(10_MCycles);
+    EXPECT_EQ(set_P1_reserved_bits(0b011110), bus.read(Vaddr::P1_VADDR));
+    EXPECT_EQ(scheduler.get_time(), jp.__sync.get_last_sync());
+}
+
 }  // namespace
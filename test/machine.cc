@@ -0,0 +1,355 @@
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "GB_test.h"
+
+#include "GB_config.h"
+#include "core/GB_machine.h"
+#include "memory/GB_vaddr.h"
+
+namespace {
+
+using AnyMachine = GB::core::AnyMachine;
+using Cartridge = GB::device::Cartridge;
+template <GB::GBModeFlag _Mode> using Machine = GB::core::Machine<_Mode>;
+
+dbuffer_t make_rom(byte_t cgb_flag) {
+    dbuffer_t rom(32_KBytes);
+
+    for (size_t i = 0; i < rom.size(); ++i)
+        rom[i] = 0x0;
+    rom[Cartridge::CGB_FLAG_VADDR] = cgb_flag;
+    return rom;
+}
+
+TEST(Machine, DMG_Memory_Map) {
+    Machine<GB::DMG_MODE>   machine;
+    auto&                   bus = machine.get_bus();
+
+    EXPECT_EQ(GB::WRAM_NON_CGB_SIZE, Machine<GB::DMG_MODE>::WRAM::MAX_SIZE);
+    EXPECT_EQ(GB::VRAM_NON_CGB_SIZE, Machine<GB::DMG_MODE>::VRAM::MAX_SIZE);
+
+    // bank registers are not connected
+    EXPECT_EQ(0xFF, bus.read(GB::memory::SVBK_VADDR));
+    EXPECT_EQ(0xFF, bus.read(GB::memory::VBK_VADDR));
+
+    bus.write(0xD000, 0x1);
+    bus.write(GB::memory::SVBK_VADDR, 0x3);
+    EXPECT_EQ(0x1, bus.read(0xD000));
+    EXPECT_EQ(0x1, bus.read(0xF000));
+
+    bus.write(0x8000, 0x2);
+    bus.write(GB::memory::VBK_VADDR, 0x1);
+    EXPECT_EQ(0x2, bus.read(0x8000));
+
+    bus.write(GB::memory::HRAM_BASE_VADDR, 0x3);
+    bus.write(GB::memory::OAM_RAM_BASE_VADDR, 0x4);
+    EXPECT_EQ(0x3, machine.get_hram().read_phys_addr(0x0));
+    EXPECT_EQ(0x4, machine.get_oram().read_phys_addr(0x0));
+}
+
+TEST(Machine, CGB_Memory_Map) {
+    Machine<GB::CGB_MODE>   machine;
+    auto&                   bus = machine.get_bus();
+
+    EXPECT_EQ(GB::WRAM_CGB_SIZE, Machine<GB::CGB_MODE>::WRAM::MAX_SIZE);
+    EXPECT_EQ(GB::VRAM_CGB_SIZE, Machine<GB::CGB_MODE>::VRAM::MAX_SIZE);
+
+    bus.write(0xD000, 0x1);
+    bus.write(GB::memory::SVBK_VADDR, 0x3);
+    bus.write(0xD000, 0x3);
+    EXPECT_EQ(0x3, bus.read(0xF000));
+    bus.write(GB::memory::SVBK_VADDR, 0x1);
+    EXPECT_EQ(0x1, bus.read(0xD000));
+
+    bus.write(GB::memory::IE_VADDR, 0x1F);
+    EXPECT_EQ(0xFF, machine.get_interrupt_controller().get_IE_reg());
+}
+
+TEST(Machine, Memory_Arena) {
+    using DMGMachine = Machine<GB::DMG_MODE>;
+    using Arena = DMGMachine::Arena;
+
+    dbuffer_t rom = make_rom(0x00);
+    rom[Cartridge::RAM_SIZE_VADDR] = 0x02;
+
+    DMGMachine  machine(std::move(rom));
+    auto&       arena = machine.get_arena();
+    auto&       bus = machine.get_bus();
+    dbuffer_t   snapshot;
+
+    EXPECT_EQ(8_KBytes, arena.get_sram_size());
+    EXPECT_EQ(arena.get_region_addr(Arena::WRAM_REGION), machine.get_wram().get_bank0_addr());
+    EXPECT_EQ(arena.get_region_addr(Arena::VRAM_REGION), machine.get_vram().get_bank_addr());
+
+    bus.write(0xC000, 0x1);
+    bus.write(0x8000, 0x2);
+    bus.write(GB::memory::OAM_RAM_BASE_VADDR, 0x3);
+    bus.write(GB::memory::HRAM_BASE_VADDR, 0x4);
+    bus.write(GB::memory::SRAM_LAST_VADDR, 0x5);
+    EXPECT_EQ(0x5, arena.get_region_addr(Arena::SRAM_REGION)[0x1FFF]);
+
+    // whole machine memory is restored with a single copy
+    arena.save(snapshot);
+    bus.write(0xC000, 0x0);
+    bus.write(0x8000, 0x0);
+    bus.write(GB::memory::OAM_RAM_BASE_VADDR, 0x0);
+    bus.write(GB::memory::HRAM_BASE_VADDR, 0x0);
+    bus.write(GB::memory::SRAM_LAST_VADDR, 0x0);
+    EXPECT_TRUE(arena.load(snapshot));
+
+    EXPECT_EQ(0x1, bus.read(0xC000));
+    EXPECT_EQ(0x2, bus.read(0x8000));
+    EXPECT_EQ(0x3, bus.read(GB::memory::OAM_RAM_BASE_VADDR));
+    EXPECT_EQ(0x4, bus.read(GB::memory::HRAM_BASE_VADDR));
+    EXPECT_EQ(0x5, bus.read(GB::memory::SRAM_LAST_VADDR));
+}
+
+TEST(Machine, Fast_Forward_Halt) {
+    Machine<GB::DMG_MODE>   machine;
+    auto&                   bus = machine.get_bus();
+    auto&                   int_ctrl = machine.get_interrupt_controller();
+    auto&                   scheduler = machine.get_scheduler();
+
+    bus.write(GB::memory::IF_VADDR, 0x0);
+    bus.write(GB::memory::IE_VADDR, GB::device::InterruptController::interrupts<GB::device::InterruptController::TIMOVER_INT>);
+    bus.write(GB::memory::TIMA_VADDR, 0xFF);
+    bus.write(GB::memory::TAC_VADDR, 0x04);
+
+    // DMA events don't wake up CPU, timer reload does
+    bus.write(0xC000, 0x5A);
+    bus.write(GB::memory::DMA_VADDR, 0xC0);
+    EXPECT_EQ(1024 + 1_MCycles, machine.fast_forward_halt(70224));
+    EXPECT_EQ(1024 + 1_MCycles, scheduler.get_time());
+    EXPECT_TRUE(int_ctrl.has_pending_interrupt());
+    EXPECT_FALSE(machine.get_dma().is_active());
+    EXPECT_EQ(0x5A, machine.get_oram().read_phys_addr(0x0));
+
+    // pending interrupt doesn't halt CPU at all
+    EXPECT_EQ(0, machine.fast_forward_halt(70224));
+
+    // nothing to wait for, so HALT lasts till the limit
+    int_ctrl.reset_interrupt(GB::device::InterruptController::TIMOVER_INT);
+    bus.write(GB::memory::TAC_VADDR, 0x00);
+    EXPECT_EQ(70224 - 1024 - 1_MCycles, machine.fast_forward_halt(70224));
+    EXPECT_EQ(70224, scheduler.get_time());
+    EXPECT_FALSE(int_ctrl.has_pending_interrupt());
+}
+
+TEST(Machine, Run_CPU) {
+    dbuffer_t rom = make_rom(0x00);
+    const byte_t program[] = {
+        0x3E, 0xF0,     // LD A,0xF0
+        0xE0, 0x05,     // LDH (TIMA),A
+        0x3E, 0x04,     // LD A,0x04
+        0xE0, 0x07,     // LDH (TAC),A
+        0xE0, 0xFF,     // LDH (IE),A
+        0xFB,           // EI
+        0x76,           // HALT
+        0x18, 0xFD,     // JR -3
+    };
+    const byte_t handler[] = {
+        0x04,           // INC B
+        0xD9,           // RETI
+    };
+    std::copy(std::begin(program), std::end(program), &rom[GB::CPU_PC_INIT_VALUE]);
+    std::copy(std::begin(handler), std::end(handler), &rom[GB::memory::TIMOVER_JMP_VADDR]);
+
+    Machine<GB::DMG_MODE>   machine(std::move(rom));
+    auto&                   cpu = machine.get_cpu();
+
+    // timer interrupt is requested once per frame, CPU waits for it in HALT
+    machine.get_interrupt_controller().set_IME_reg(false);
+    machine.run(70224);
+    EXPECT_GE(machine.get_scheduler().get_time(), 70224);
+    EXPECT_TRUE(cpu.is_halted());
+    EXPECT_EQ(0x1, cpu.get_registers().B);
+    EXPECT_EQ(GB::CPU_PC_INIT_VALUE + 12, cpu.get_registers().PC);
+}
+
+/** Machine time, CPU registers, timer registers and memory, which is written by the game */
+std::vector<clk_cycle_t> observe(Machine<GB::DMG_MODE>& machine) {
+    const auto& regs = machine.get_cpu().get_registers();
+    auto& bus = machine.get_bus();
+    std::vector<clk_cycle_t> observed = {
+        machine.get_scheduler().get_time(),
+        regs.get_AF(), regs.get_BC(), regs.get_DE(), regs.get_HL(), regs.SP, regs.PC,
+        bus.read(GB::memory::DIV_VADDR), bus.read(GB::memory::TIMA_VADDR), bus.read(GB::memory::IF_VADDR),
+        bus.read(0x8000),
+    };
+
+    for (word_t vaddr = 0xC000; vaddr < 0xC100; ++vaddr)
+        observed.push_back(bus.read(vaddr));
+    return observed;
+}
+
+TEST(Machine, Save_State) {
+    dbuffer_t rom = make_rom(0x00);
+    const byte_t program[] = {
+        0x31, 0x00, 0xD0,   // LD SP,0xD000
+        0x3E, 0x04,         // LD A,0x04
+        0xE0, 0x07,         // LDH (TAC),A
+        0xE0, 0xFF,         // LDH (IE),A
+        0xFB,               // EI
+        0x21, 0x00, 0xC0,   // LD HL,0xC000
+        0x34,               // INC (HL)
+        0x2C,               // INC L
+        0x18, 0xFC,         // JR -4
+    };
+    const byte_t handler[] = {
+        0x04,               // INC B
+        0x78,               // LD A,B
+        0xEA, 0x00, 0x80,   // LD (0x8000),A
+        0xD9,               // RETI
+    };
+    std::copy(std::begin(program), std::end(program), &rom[GB::CPU_PC_INIT_VALUE]);
+    std::copy(std::begin(handler), std::end(handler), &rom[GB::memory::TIMOVER_JMP_VADDR]);
+
+    Machine<GB::DMG_MODE>   machine(std::move(rom));
+    auto&                   scheduler = machine.get_scheduler();
+
+    // image is saved to external memory (e.g. a mapped file)
+    std::vector<byte_t>     storage(machine.get_state_size());
+    dbuffer_t               image = dbuffer_t::view(storage.data(), storage.size());
+
+    machine.run(3 * 70224);
+    machine.save_state(image);
+    const clk_cycle_t saved_time = scheduler.get_time();
+
+    // writes are tracked while the machine runs: the counters page, the stack page and the tile
+    machine.get_wram().clear_dirty_pages();
+    machine.get_vram().clear_dirty_pages();
+    machine.run(saved_time + 2 * 70224);
+    const std::vector<clk_cycle_t> expected = observe(machine);
+    EXPECT_EQ(2, machine.get_wram().get_dirty_pages().count());
+    EXPECT_TRUE(machine.get_wram().get_dirty_pages()[0x00]);
+    EXPECT_TRUE(machine.get_wram().get_dirty_pages()[0x0F]);
+    EXPECT_EQ(1, machine.get_vram().get_dirty_pages().count());
+
+    // restored machine runs the same way, and the whole memory is dirty
+    EXPECT_TRUE(machine.load_state(image));
+    EXPECT_EQ(saved_time, scheduler.get_time());
+    EXPECT_TRUE(machine.get_wram().get_dirty_pages().all());
+    machine.run(saved_time + 2 * 70224);
+    EXPECT_EQ(expected, observe(machine));
+    EXPECT_NE(0x0, machine.get_cpu().get_registers().B);
+}
+
+TEST(Machine, Save_State_Active_DMA) {
+    Machine<GB::DMG_MODE>   machine;
+    auto&                   bus = machine.get_bus();
+    auto&                   scheduler = machine.get_scheduler();
+    dbuffer_t               image;
+
+    for (word_t idx = 0; idx < GB::ORAM_SIZE; ++idx)
+        bus.write(word_t(0xC000 + idx), byte_t(idx + 1));
+    bus.write(GB::memory::DMA_VADDR, 0xC0);
+    scheduler.advance(1_MCycles + 40_MCycles);
+    machine.save_state(image);
+    EXPECT_EQ(machine.get_state_size(), image.size());
+
+    scheduler.advance(GB::ORAM_SIZE * 1_MCycles);
+    EXPECT_FALSE(machine.get_dma().is_active());
+    machine.get_wram().write_phys_addr(100, 0xEE);
+
+    // transfer continues from the restored memory, and the bus is locked again
+    EXPECT_TRUE(machine.load_state(image));
+    EXPECT_TRUE(machine.get_dma().is_active());
+    EXPECT_TRUE(bus.is_locked(0xC000));
+    scheduler.advance(GB::ORAM_SIZE * 1_MCycles);
+    EXPECT_FALSE(bus.is_locked(0xC000));
+    for (word_t idx = 0; idx < GB::ORAM_SIZE; ++idx)
+        EXPECT_EQ(byte_t(idx + 1), machine.get_oram().read_phys_addr(idx));
+}
+
+/** Fill the stack below the caller with the pattern, so padding of states isn't zero by chance */
+__attribute__((noinline)) void scribble_stack(byte_t pattern) {
+    volatile byte_t garbage[4096];
+
+    for (size_t idx = 0; idx < sizeof(garbage); ++idx)
+        garbage[idx] = pattern;
+}
+
+TEST(Machine, Save_State_Deterministic) {
+    Machine<GB::DMG_MODE>   machine;
+    auto&                   bus = machine.get_bus();
+    dbuffer_t               image;
+    dbuffer_t               other_image(machine.get_state_size());
+
+    // image, which isn't reallocated, has garbage up to the arena
+    std::fill(other_image.get_data_addr(), other_image.get_data_addr() + other_image.size(), 0xAA);
+    bus.write(0xC000, 0x1);
+    bus.write(GB::memory::DMA_VADDR, 0xC0);
+    machine.get_scheduler().advance(1_MCycles + 10_MCycles);
+
+    // the same state gives the same image, whatever is left in the memory of the state copies
+    scribble_stack(0xAA);
+    machine.save_state(image);
+    scribble_stack(0x55);
+    machine.save_state(other_image);
+    ASSERT_EQ(image.size(), other_image.size());
+    EXPECT_TRUE(std::equal(image.get_data_addr(), image.get_data_addr() + image.size(), other_image.get_data_addr()));
+
+    // padding bytes are zeros (between the mode and the arena size, inside device states, and up to the arena)
+    using State = Machine<GB::DMG_MODE>::State;
+    using JoyPadState = GB::device::JoyPad::State;
+    using DMAState = GB::device::DMA::State;
+    const auto expect_zeros = [&image](size_t base, size_t first, size_t last) {
+        for (size_t offset = base + first; offset < base + last; ++offset)
+            EXPECT_EQ(0x0, image[offset]) << "offset " << offset;
+    };
+    expect_zeros(0, offsetof(State, mode) + sizeof(GB::GBModeFlag), offsetof(State, arena_size));
+    expect_zeros(offsetof(State, joypad), offsetof(JoyPadState, p15) + 1, offsetof(JoyPadState, last_sync));
+    expect_zeros(offsetof(State, dma), offsetof(DMAState, reg) + 1, offsetof(DMAState, source));
+    expect_zeros(0, sizeof(State), Machine<GB::DMG_MODE>::STATE_ARENA_OFFSET);
+
+    // and a restored machine gives it back
+    Machine<GB::DMG_MODE>   restored;
+    ASSERT_TRUE(restored.load_state(image));
+    scribble_stack(0xCC);
+    restored.save_state(other_image);
+    EXPECT_TRUE(std::equal(image.get_data_addr(), image.get_data_addr() + image.size(), other_image.get_data_addr()));
+}
+
+TEST(Machine, Save_State_Mismatch) {
+    Machine<GB::DMG_MODE>   dmg_machine;
+    Machine<GB::CGB_MODE>   cgb_machine;
+    dbuffer_t               image;
+
+    cgb_machine.save_state(image);
+    EXPECT_FALSE(dmg_machine.load_state(image));
+
+    dmg_machine.save_state(image);
+    EXPECT_TRUE(dmg_machine.load_state(image));
+    image[0] = 0x0;
+    EXPECT_FALSE(dmg_machine.load_state(image));
+}
+
+TEST(Machine, Runtime_Dispatch) {
+    AnyMachine  any_machine;
+    GB::GBModeFlag visited_mode = GB::MGB_MODE;
+
+    EXPECT_FALSE(any_machine.is_loaded());
+    any_machine.visit([&visited_mode](auto& machine) { visited_mode = machine.MODE; });
+    EXPECT_EQ(GB::MGB_MODE, visited_mode);
+
+    EXPECT_EQ(GB::DMG_MODE, any_machine.load_rom(make_rom(0x00)));
+    EXPECT_TRUE(any_machine.is_loaded());
+    EXPECT_EQ(GB::DMG_MODE, any_machine.get_mode());
+    any_machine.visit([&visited_mode](auto& machine) { visited_mode = machine.MODE; });
+    EXPECT_EQ(GB::DMG_MODE, visited_mode);
+
+    EXPECT_EQ(GB::CGB_MODE, any_machine.load_rom(make_rom(Cartridge::CGB_SUPPORTED_FLAG)));
+    EXPECT_EQ(GB::CGB_MODE, any_machine.get_mode());
+    any_machine.visit([&visited_mode](auto& machine) { visited_mode = machine.MODE; });
+    EXPECT_EQ(GB::CGB_MODE, visited_mode);
+
+    EXPECT_EQ(GB::CGB_MODE, AnyMachine::select_mode(make_rom(Cartridge::CGB_ONLY_FLAG)));
+    EXPECT_EQ(GB::DMG_MODE, AnyMachine::select_mode(dbuffer_t()));
+}
+
+}  // namespace
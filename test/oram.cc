@@ -3,6 +3,7 @@
 #define protected public    // TODO(dolovnyak): Use #include "GB_test.h" now
 
 #include "device/GB_oram.h"
+#include "memory/GB_bus.h"
 
 namespace {
 
@@ -63,6 +64,147 @@ TEST(ObjectsRAM, Phys_Read_Write_And_Correct_Raw_Memory) {
     EXPECT_EQ(oram.read_phys_addr(159), 102);
 }
 
-// TODO(dolovnyak) make unit-tests for read/write with memory_bus when it will be done
+TEST(ObjectsRAM, Copy_On_Write) {
+    using Bus = GB::memory::BusInterface;
+
+    ORAM    oram;
+    Bus     bus;
+
+    oram.map_to_memory(bus);
+    bus.write(0xFE00, 0x1);
+    bus.write(0xFE10, 0x0);
+
+    oram.share_memory();
+    ORAM oram_fork(oram);
+    EXPECT_EQ(oram.get_memory_buffer_ref().get_page_rd_addr(0), oram_fork.get_memory_buffer_ref().get_page_rd_addr(0));
+
+    bus.write(0xFE10, 0x2);
+    EXPECT_FALSE(oram.get_memory_buffer_ref().is_shared());
+    EXPECT_EQ(0x1, bus.read(0xFE00));
+    EXPECT_EQ(0x2, bus.read(0xFE10));
+    EXPECT_EQ(0x2, oram.read_phys_addr(0x10));
+    EXPECT_EQ(0x1, oram_fork.read_phys_addr(0x0));
+    EXPECT_EQ(0x0, oram_fork.read_phys_addr(0x10));
+}
+
+TEST(ObjectsRAM, Memory_Bus) {
+    using Bus = GB::memory::BusInterface;
+
+    ORAM oram;
+    Bus bus;
+
+    oram.map_to_memory(bus);
+
+    bus.write(0xFE00, 100);
+    bus.write(0xFE9F, 101);
+    EXPECT_EQ(oram.read_phys_addr(0), 100);
+    EXPECT_EQ(oram.read_phys_addr(159), 101);
+
+    oram.write_phys_addr(10, 102);
+    EXPECT_EQ(bus.read(0xFE0A), 102);
+
+    // unusable area after OAM is not mapped
+    bus.write(0xFEA0, 103);
+    EXPECT_EQ(bus.read(0xFEA0), Bus::OPEN_BUS_VALUE);
+}
+
+TEST(ObjectsRAM, Dirty_Pages) {
+    using Bus = GB::memory::BusInterface;
+
+    ORAM oram;
+    Bus bus;
+    const byte_t block[2] = {0x1, 0x2};
+
+    oram.map_to_memory(bus);
+    EXPECT_TRUE(oram.get_dirty_pages().all());
+    oram.clear_dirty_pages();
+    EXPECT_TRUE(oram.get_dirty_pages().none());
+
+    bus.write(0xFE10, 0x1);
+    EXPECT_TRUE(oram.get_dirty_pages().all());
+
+    oram.clear_dirty_pages();
+    oram.write_block(0x20, block, sizeof(block));
+    EXPECT_TRUE(oram.get_dirty_pages().all());
+}
+
+TEST(ObjectsRAM, Line_Objects) {
+    using Bus = GB::memory::BusInterface;
+
+    ORAM    oram;
+    Bus     bus;
+
+    oram.map_to_memory(bus);
+    for (unsigned line = 0; line < GB::LCD_HEIGHT; ++line) {
+        EXPECT_EQ(0, oram.get_line_objects(line, false));
+        EXPECT_EQ(0, oram.get_line_objects(line, true));
+    }
+
+    // object 3 covers lines [4:11] (8x8) or [4:19] (8x16)
+    bus.write(0xFE00 + 3 * ORAM::OBJECT_SIZE, 20);
+    EXPECT_EQ(0, oram.get_line_objects(3, true));
+    EXPECT_EQ(0b1000, oram.get_line_objects(4, false));
+    EXPECT_EQ(0b1000, oram.get_line_objects(11, false));
+    EXPECT_EQ(0, oram.get_line_objects(12, false));
+    EXPECT_EQ(0b1000, oram.get_line_objects(19, true));
+    EXPECT_EQ(0, oram.get_line_objects(20, true));
+
+    // moving object updates the index, other bytes of the object don't
+    oram.write_phys_addr(3 * ORAM::OBJECT_SIZE, 10);
+    oram.write_phys_addr(3 * ORAM::OBJECT_SIZE + 1, 50);
+    EXPECT_EQ(0b1000, oram.get_line_objects(0, false));
+    EXPECT_EQ(0, oram.get_line_objects(4, false));
+    EXPECT_EQ(0b1000, oram.get_line_objects(4, true));
+
+    // objects at the bottom edge are clipped
+    oram.write_phys_addr(39 * ORAM::OBJECT_SIZE, 159);
+    EXPECT_EQ(ORAM::objects_mask_t(1) << 39, oram.get_line_objects(143, false));
+
+    // copy keeps the index, rebuild gives the same index
+    ORAM oram_copy(oram);
+    EXPECT_EQ(0b1000, oram_copy.get_line_objects(0, false));
+    oram_copy.rebuild_line_index();
+    for (unsigned line = 0; line < GB::LCD_HEIGHT; ++line)
+        EXPECT_EQ(oram.get_line_objects(line, true), oram_copy.get_line_objects(line, true));
+}
+
+TEST(ObjectsRAM, Select_Line_Objects) {
+    ORAM    oram;
+    byte_t  objects[ORAM::LINE_OBJECTS_MAX];
+
+    // every odd object is on line 50
+    for (unsigned object = 1; object < GB::ORAM_OBJECTS_NUM; object += 2)
+        oram.write_phys_addr(object * ORAM::OBJECT_SIZE, 50 + ORAM::OBJECT_Y_OFFSET);
+
+    EXPECT_EQ(0, oram.select_line_objects(49, false, objects));
+    EXPECT_EQ(ORAM::LINE_OBJECTS_MAX, oram.select_line_objects(50, false, objects));
+    for (unsigned idx = 0; idx < ORAM::LINE_OBJECTS_MAX; ++idx)
+        EXPECT_EQ(idx * 2 + 1, objects[idx]);
+
+    for (unsigned object = 1; object < 30; object += 2)
+        oram.write_phys_addr(object * ORAM::OBJECT_SIZE, 0);
+    EXPECT_EQ(5, oram.select_line_objects(57, false, objects));
+    EXPECT_EQ(31, objects[0]);
+    EXPECT_EQ(39, objects[4]);
+}
+
+TEST(ObjectsRAM, Block_Read_And_View) {
+    ORAM    oram;
+    byte_t  block[ORAM::OBJECT_SIZE * 2];
+
+    for (unsigned offset = 0; offset < sizeof(block); ++offset)
+        block[offset] = byte_t(offset + 0x20);
+    oram.write_block(ORAM::OBJECT_SIZE, block, sizeof(block));
+    EXPECT_NE(0, oram.get_line_objects(0x20 - ORAM::OBJECT_Y_OFFSET, false) & 0b10);
+
+    byte_t result[sizeof(block)] = {};
+    oram.read_block(ORAM::OBJECT_SIZE, result, sizeof(result));
+    for (unsigned offset = 0; offset < sizeof(block); ++offset)
+        EXPECT_EQ(block[offset], result[offset]);
+
+    const span_t<const byte_t> memory = oram.view_bank(0);
+    EXPECT_EQ(GB::ORAM_SIZE, memory.size());
+    EXPECT_EQ(0x20, memory[ORAM::OBJECT_SIZE]);
+}
 
 }   // namespace
@@ -0,0 +1,178 @@
+#include <algorithm>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "GB_test.h"
+
+#include "common/GB_dbuffer.h"
+#include "core/GB_machine.h"
+#include "core/GB_rewind.h"
+#include "memory/GB_vaddr.h"
+
+namespace {
+
+using GB::core::Rewind;
+using DMGMachine = GB::core::Machine<GB::DMG_MODE>;
+
+constexpr size_t IMAGE_SIZE = 0x2000;
+constexpr clk_cycle_t FRAME_CYCLES = 70224;
+
+/** Image of a frame differs from the previous one by a few bytes */
+dbuffer_t make_image(unsigned frame) {
+    dbuffer_t image(IMAGE_SIZE);
+
+    for (size_t offset = 0; offset < IMAGE_SIZE; ++offset)
+        image[offset] = uint8_t(offset >> 4);
+    for (unsigned idx = 0; idx <= frame; ++idx)
+        image[(idx * 37) % IMAGE_SIZE] = uint8_t(idx + 1);
+    return image;
+}
+
+bool is_equal(const dbuffer_t& lhs, const dbuffer_t& rhs) {
+    return lhs.size() == rhs.size()
+        && std::equal(lhs.get_data_addr(), lhs.get_data_addr() + lhs.size(), rhs.get_data_addr());
+}
+
+TEST(Rewind, Push_Pop) {
+    Rewind      rewind(64_KBytes, 4);
+    dbuffer_t   image;
+
+    EXPECT_FALSE(rewind.pop(image));
+    for (unsigned frame = 0; frame < 10; ++frame)
+        rewind.push(make_image(frame));
+    EXPECT_EQ(10, rewind.size());
+
+    // deltas are much smaller than images
+    EXPECT_GT(10 * IMAGE_SIZE / 2, rewind.get_used_bytes());
+
+    // pop crosses keyframes, and pushes continue the restored group
+    for (unsigned frame = 10; frame-- > 5;) {
+        EXPECT_TRUE(rewind.pop(image));
+        EXPECT_TRUE(is_equal(make_image(frame), image));
+    }
+    for (unsigned frame = 5; frame < 8; ++frame)
+        rewind.push(make_image(frame + 100));
+    for (unsigned frame = 8; frame-- > 5;) {
+        EXPECT_TRUE(rewind.pop(image));
+        EXPECT_TRUE(is_equal(make_image(frame + 100), image));
+    }
+    for (unsigned frame = 5; frame-- > 0;) {
+        EXPECT_TRUE(rewind.pop(image));
+        EXPECT_TRUE(is_equal(make_image(frame), image));
+    }
+    EXPECT_TRUE(rewind.empty());
+    EXPECT_EQ(0, rewind.get_used_bytes());
+    EXPECT_FALSE(rewind.pop(image));
+}
+
+TEST(Rewind, Budget) {
+    // keyframe is almost the whole image, so only a few groups fit
+    Rewind      rewind(3 * IMAGE_SIZE, 8);
+    dbuffer_t   image;
+    unsigned    frame = 0;
+
+    for (; frame < 100; ++frame) {
+        rewind.push(make_image(frame));
+        EXPECT_GE(rewind.get_budget(), rewind.get_used_bytes());
+    }
+    EXPECT_LT(8, rewind.size());
+    EXPECT_GT(100, rewind.size());
+
+    // the newest states are kept, and the oldest one is a keyframe
+    const size_t states_num = rewind.size();
+    for (size_t idx = 0; idx < states_num; ++idx) {
+        EXPECT_TRUE(rewind.pop(image));
+        EXPECT_TRUE(is_equal(make_image(--frame), image));
+    }
+    EXPECT_EQ(0, frame % 8);
+    EXPECT_TRUE(rewind.empty());
+
+    // image, which doesn't fit at all, isn't saved
+    Rewind small(IMAGE_SIZE / 2);
+    EXPECT_FALSE(small.push(make_image(0)));
+    EXPECT_TRUE(small.empty());
+}
+
+TEST(Rewind, Too_Large_Image) {
+    Rewind      rewind(1_KBytes, 4);
+    dbuffer_t   image(IMAGE_SIZE);
+    dbuffer_t   noise(IMAGE_SIZE);
+
+    // mostly zero images are a few bytes each
+    std::fill(image.get_data_addr(), image.get_data_addr() + IMAGE_SIZE, 0x0);
+    for (unsigned frame = 0; frame < 6; ++frame) {
+        image[frame * 100] = uint8_t(frame + 1);
+        EXPECT_TRUE(rewind.push(image));
+    }
+    const size_t used_bytes = rewind.get_used_bytes();
+
+    // incompressible image doesn't fit as a delta or a keyframe, and the history is kept
+    for (size_t offset = 0; offset < IMAGE_SIZE; ++offset)
+        noise[offset] = uint8_t(offset * 131 + (offset >> 8) * 17 + 1);
+    EXPECT_FALSE(rewind.push(noise));
+    EXPECT_EQ(6, rewind.size());
+    EXPECT_EQ(used_bytes, rewind.get_used_bytes());
+
+    dbuffer_t restored;
+    EXPECT_TRUE(rewind.pop(restored));
+    EXPECT_TRUE(is_equal(image, restored));
+}
+
+TEST(Rewind, Image_Size) {
+    Rewind      rewind(64_KBytes);
+    dbuffer_t   image(0x100);
+
+    rewind.push(make_image(0));
+    rewind.push(image);
+    EXPECT_EQ(1, rewind.size());
+    EXPECT_TRUE(rewind.pop(image));
+    EXPECT_EQ(0x100, image.size());
+
+    // owning image is reallocated
+    rewind.push(make_image(1));
+    EXPECT_TRUE(rewind.pop(image));
+    EXPECT_TRUE(is_equal(make_image(1), image));
+}
+
+TEST(Rewind, Step_Back) {
+    dbuffer_t rom(32_KBytes);
+    const byte_t program[] = {
+        0x21, 0x00, 0xC0,   // LD HL,0xC000
+        0x34,               // INC (HL)
+        0x2C,               // INC L
+        0x18, 0xFC,         // JR -4
+    };
+
+    std::fill(rom.get_data_addr(), rom.get_data_addr() + rom.size(), 0x0);
+    std::copy(std::begin(program), std::end(program), &rom[GB::CPU_PC_INIT_VALUE]);
+
+    DMGMachine                      machine(std::move(rom));
+    Rewind                          rewind(256_KBytes, 4);
+    std::vector<std::vector<byte_t>> frames;
+
+    auto observe = [&machine]() {
+        std::vector<byte_t> observed = { byte_t(machine.get_scheduler().get_time() / FRAME_CYCLES) };
+
+        for (word_t vaddr = 0xC000; vaddr < 0xC100; ++vaddr)
+            observed.push_back(machine.get_bus().read(vaddr));
+        return observed;
+    };
+
+    for (unsigned frame = 1; frame <= 10; ++frame) {
+        machine.run(frame * FRAME_CYCLES);
+        rewind.push(machine);
+        frames.push_back(observe());
+    }
+
+    while (!frames.empty()) {
+        EXPECT_TRUE(rewind.step_back(machine));
+        EXPECT_EQ(frames.back(), observe());
+        frames.pop_back();
+    }
+    EXPECT_FALSE(rewind.step_back(machine));
+}
+
+}  // namespace
@@ -0,0 +1,104 @@
+#include <algorithm>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "GB_test.h"
+
+#include "core/GB_machine.h"
+#include "core/GB_run_ahead.h"
+#include "device/GB_joypad.h"
+#include "memory/GB_vaddr.h"
+
+namespace {
+
+using DMGMachine = GB::core::Machine<GB::DMG_MODE>;
+using RunAhead = GB::core::RunAhead<GB::DMG_MODE>;
+using JoyPad = GB::device::JoyPad;
+
+/** Game, which reads direction keys to 0xC000 and counts the reads at 0xC001 */
+dbuffer_t make_input_rom() {
+    dbuffer_t rom(32_KBytes);
+    const byte_t program[] = {
+        0x3E, 0x20,         // 0100: LD A,0x20
+        0xE0, 0x00,         // 0102: LDH (P1),A
+        0xF0, 0x00,         // 0104: LDH A,(P1)
+        0xEA, 0x00, 0xC0,   // 0106: LD (0xC000),A
+        0x21, 0x01, 0xC0,   // 0109: LD HL,0xC001
+        0x34,               // 010C: INC (HL)
+        0x18, 0xF1,         // 010D: JR 0x0100
+    };
+
+    std::fill(rom.get_data_addr(), rom.get_data_addr() + rom.size(), 0x0);
+    std::copy(std::begin(program), std::end(program), &rom[GB::CPU_PC_INIT_VALUE]);
+    return rom;
+}
+
+std::vector<clk_cycle_t> observe(DMGMachine& machine) {
+    const auto& regs = machine.get_cpu().get_registers();
+
+    return {
+        machine.get_scheduler().get_time(), regs.PC, regs.get_AF(),
+        machine.get_bus().read(0xC000), machine.get_bus().read(0xC001),
+    };
+}
+
+/** Machine, which has run all frames with the input, and then frames_ahead frames with the last input */
+std::vector<clk_cycle_t> expected_ahead(const std::vector<byte_t>& input, unsigned frames_ahead) {
+    DMGMachine machine(make_input_rom());
+
+    for (byte_t key_set : input) {
+        machine.get_joypad().set_pressed_key_set(key_set);
+        machine.run_frame();
+    }
+    for (unsigned frame = 0; frame < frames_ahead; ++frame)
+        machine.run_frame();
+    return observe(machine);
+}
+
+TEST(Run_Ahead, Same_As_Future_Frames) {
+    constexpr unsigned FRAMES_AHEAD = 2;
+
+    DMGMachine          machine(make_input_rom());
+    RunAhead            run_ahead(machine, FRAMES_AHEAD);
+    std::vector<byte_t> input;
+    const byte_t        left = ::bits_set(JoyPad::LF_KEY);
+    const byte_t        up = ::bits_set(JoyPad::UP_KEY);
+    const std::vector<byte_t> keys = { 0x0, 0x0, 0x0, left, left, left, left, up, 0x0, 0x0 };
+
+    for (byte_t key_set : keys) {
+        DMGMachine& presented = run_ahead.run_frame(key_set);
+
+        input.push_back(key_set);
+        EXPECT_EQ(expected_ahead(input, FRAMES_AHEAD), observe(presented));
+        EXPECT_EQ(&presented, &run_ahead.get_presented());
+        // the machine itself runs only the real frames
+        EXPECT_EQ(expected_ahead(input, 0), observe(machine));
+    }
+
+    // the first frame and every input change
+    EXPECT_EQ(4, run_ahead.get_rollbacks_num());
+
+    // the key is seen by the presented game at once (P1 bits are low for pressed keys)
+    EXPECT_EQ(0x0, observe(run_ahead.run_frame(left))[3] & ::bits_set(JoyPad::P11));
+    EXPECT_EQ(0x0, observe(machine)[3] & ::bits_set(JoyPad::P11));
+}
+
+TEST(Run_Ahead, Disabled) {
+    DMGMachine  machine(make_input_rom());
+    RunAhead    run_ahead(machine, 0);
+
+    EXPECT_EQ(&machine, &run_ahead.run_frame(0x0));
+    EXPECT_EQ(expected_ahead({0x0}, 0), observe(machine));
+    EXPECT_EQ(0, run_ahead.get_rollbacks_num());
+
+    // speculation starts from the current machine
+    run_ahead.set_frames_ahead(1);
+    run_ahead.run_frame(0x0);
+    EXPECT_EQ(1, run_ahead.get_rollbacks_num());
+    EXPECT_EQ(expected_ahead({0x0, 0x0}, 1), observe(run_ahead.get_presented()));
+}
+
+}  // namespace
@@ -0,0 +1,202 @@
+#include <algorithm>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "GB_test.h"
+
+#include "common/GB_scheduler.h"
+#include "common/GB_types.h"
+
+namespace {
+
+using Scheduler = devsync::Scheduler;
+
+struct Device {
+    Scheduler*                  scheduler = nullptr;
+    Scheduler::event_id_t       event = Scheduler::NO_EVENT;
+    clk_cycle_t                 period = 0;
+    std::vector<clk_cycle_t>    fired;
+    std::vector<clk_cycle_t>*   dispatch_log = nullptr;
+
+    static void on_event(void* owner, clk_cycle_t deadline) {
+        Device* dev = static_cast<Device*>(owner);
+
+        dev->fired.push_back(deadline);
+        if (dev->dispatch_log != nullptr)
+            dev->dispatch_log->push_back(dev->scheduler->get_time());
+        if (dev->period != 0)
+            dev->scheduler->schedule(dev->event, deadline + dev->period);
+    }
+
+    void connect(Scheduler& sched, clk_cycle_t event_period = 0) {
+        scheduler = &sched;
+        period = event_period;
+        event = sched.register_event(&Device::on_event, this);
+    }
+};
+
+TEST(Scheduler, Deadline_Order) {
+    Scheduler   sched;
+    Device      devs[4];
+
+    for (auto& dev : devs)
+        dev.connect(sched);
+
+    EXPECT_EQ(Scheduler::NEVER, sched.get_next_deadline());
+
+    sched.schedule(devs[0].event, 40);
+    sched.schedule(devs[1].event, 10);
+    sched.schedule(devs[2].event, 30);
+    sched.schedule(devs[3].event, 20);
+    EXPECT_EQ(10, sched.get_next_deadline());
+
+    // reschedule and cancel pending events
+    sched.schedule(devs[1].event, 50);
+    sched.cancel(devs[2].event);
+    EXPECT_FALSE(sched.is_pending(devs[2].event));
+    EXPECT_EQ(Scheduler::NEVER, sched.get_deadline(devs[2].event));
+    EXPECT_EQ(20, sched.get_next_deadline());
+
+    sched.advance_to(40);
+    EXPECT_EQ(40, sched.get_time());
+    EXPECT_EQ(std::vector<clk_cycle_t>{40}, devs[0].fired);
+    EXPECT_TRUE(devs[1].fired.empty());
+    EXPECT_TRUE(devs[2].fired.empty());
+    EXPECT_EQ(std::vector<clk_cycle_t>{20}, devs[3].fired);
+    EXPECT_EQ(50, sched.get_next_deadline());
+
+    sched.advance(100);
+    EXPECT_EQ(140, sched.get_time());
+    EXPECT_EQ(std::vector<clk_cycle_t>{50}, devs[1].fired);
+    EXPECT_EQ(Scheduler::NEVER, sched.get_next_deadline());
+}
+
+TEST(Scheduler, Periodic_Events) {
+    Scheduler   sched;
+    Device      fast;
+    Device      slow;
+
+    fast.connect(sched, 4);
+    slow.connect(sched, 10);
+    sched.schedule_in(fast.event, 4);
+    sched.schedule_in(slow.event, 10);
+
+    // events which are rescheduled by callbacks inside the range are dispatched too
+    sched.advance(20);
+    EXPECT_EQ((std::vector<clk_cycle_t>{4, 8, 12, 16, 20}), fast.fired);
+    EXPECT_EQ((std::vector<clk_cycle_t>{10, 20}), slow.fired);
+    EXPECT_EQ(24, sched.get_next_deadline());
+}
+
+TEST(Scheduler, Same_Deadline) {
+    Scheduler           sched;
+    std::vector<int>    order;
+
+    auto on_first = [](void* owner, clk_cycle_t) { static_cast<std::vector<int>*>(owner)->push_back(0); };
+    auto on_second = [](void* owner, clk_cycle_t) { static_cast<std::vector<int>*>(owner)->push_back(1); };
+
+    const auto first = sched.register_event(on_first, &order);
+    const auto second = sched.register_event(on_second, &order);
+
+    sched.schedule(second, 8);
+    sched.schedule(first, 8);
+    sched.advance_to(8);
+    EXPECT_EQ((std::vector<int>{0, 1}), order);
+}
+
+TEST(Scheduler, Budget) {
+    Scheduler   sched;
+    Device      dev;
+
+    dev.connect(sched);
+    EXPECT_EQ(100 - 1, sched.get_budget(100));
+
+    sched.schedule_in(dev.event, 12);
+
+    // CPU runs 4-cycle actions until the deadline
+    clk_cycle_t budget = sched.get_budget(100);
+    const clk_cycle_t given = budget;
+    unsigned actions = 0;
+
+    while (devsync::is_ready(budget)) {
+        devsync::pay(budget, 4);
+        ++actions;
+    }
+    EXPECT_EQ(3u, actions);
+
+    sched.advance(given - budget);
+    EXPECT_EQ(12, sched.get_time());
+    EXPECT_EQ(std::vector<clk_cycle_t>{12}, dev.fired);
+}
+
+TEST(Scheduler, Slots_Limit) {
+    Scheduler sched;
+
+    for (unsigned idx = 0; idx < Scheduler::MAX_EVENTS; ++idx)
+        EXPECT_EQ(idx, sched.register_event(&Device::on_event, nullptr));
+    EXPECT_EQ(Scheduler::NO_EVENT, sched.register_event(&Device::on_event, nullptr));
+}
+
+TEST(Scheduler, Heap_Order) {
+    Scheduler                   sched;
+    Device                      devs[Scheduler::MAX_EVENTS];
+    std::vector<clk_cycle_t>    dispatch_log;
+
+    for (auto& dev : devs) {
+        dev.connect(sched);
+        dev.dispatch_log = &dispatch_log;
+    }
+
+    // pseudo random deadlines with rescheduling and cancelling
+    u32 seed = 0x1234;
+    for (unsigned round = 0; round < 1000; ++round) {
+        seed = seed * 1103515245u + 12345u;
+        Device& dev = devs[(seed >> 16) % Scheduler::MAX_EVENTS];
+
+        if ((seed >> 8) % 4 == 0)
+            sched.cancel(dev.event);
+        else
+            sched.schedule(dev.event, sched.get_time() + 1 + (seed >> 4) % 1000);
+
+        if (round % 10 == 0)
+            sched.advance(50);
+    }
+    sched.advance_to(Scheduler::NEVER - 1);
+
+    // events are dispatched at their deadlines in the deadline order
+    size_t fired_num = 0;
+    for (auto& dev : devs)
+        fired_num += dev.fired.size();
+    EXPECT_EQ(fired_num, dispatch_log.size());
+    EXPECT_FALSE(dispatch_log.empty());
+    EXPECT_TRUE(std::is_sorted(dispatch_log.begin(), dispatch_log.end()));
+    EXPECT_EQ(Scheduler::NEVER, sched.get_next_deadline());
+}
+
+TEST(Scheduler, Save_State) {
+    Scheduler   sched;
+    Device      devs[3];
+
+    for (auto& dev : devs)
+        dev.connect(sched);
+    sched.schedule(devs[0].event, 30);
+    sched.schedule(devs[2].event, 10);
+    sched.advance(5);
+    const Scheduler::State state = sched.get_state();
+
+    sched.advance(100);
+    sched.schedule(devs[1].event, 200);
+
+    // pending events are restored, and no callback is called
+    sched.set_state(state);
+    EXPECT_EQ(5, sched.get_time());
+    EXPECT_EQ(10, sched.get_next_deadline());
+    EXPECT_FALSE(sched.is_pending(devs[1].event));
+    sched.advance_to(30);
+    EXPECT_EQ((std::vector<clk_cycle_t>{30, 30}), devs[0].fired);
+    EXPECT_EQ((std::vector<clk_cycle_t>{10, 10}), devs[2].fired);
+    EXPECT_TRUE(devs[1].fired.empty());
+}
+
+}  // namespace
@@ -0,0 +1,102 @@
+#include "gtest/gtest.h"
+
+#include "GB_test.h"
+
+#include "GB_config.h"
+#include "common/GB_macro.h"
+#include "device/GB_tile_decoder.h"
+
+namespace {
+
+using TileDecoder = GB::device::TileDecoder;
+
+constexpr unsigned MAP_OFFSET = 0x1800;
+
+/* Decoding pixel by pixel */
+byte_t reference_pixel(const byte_t* row, unsigned x, bool hflip) {
+    const unsigned bit = hflip ? x : 7 - x;
+    return byte_t((::bit_n(bit, row[1]) << 1) | ::bit_n(bit, row[0]));
+}
+
+void fill_pseudo_random(byte_t* memory, unsigned size) {
+    unsigned seed = 0x1234567;
+    for (unsigned offset = 0; offset < size; ++offset) {
+        seed = seed * 1103515245 + 12345;
+        memory[offset] = byte_t(seed >> 16);
+    }
+}
+
+TEST(Tile_Decoder, Decode_Rows) {
+    byte_t planes[2 * 11];
+    fill_pseudo_random(planes, sizeof(planes));
+
+    for (unsigned isa_idx = 0; isa_idx < TileDecoder::ISA_NUM; ++isa_idx) {
+        const TileDecoder::Isa isa = TileDecoder::Isa(isa_idx);
+        if (!TileDecoder::is_supported(isa))
+            continue;
+
+        TileDecoder decoder(isa);
+        byte_t pixels[8 * 11] = {};
+
+        EXPECT_EQ(isa, decoder.get_isa());
+        // odd number of rows goes through vector loop and tail
+        decoder.decode_rows(planes, 11, pixels);
+        for (unsigned row = 0; row < 11; ++row) {
+            for (unsigned x = 0; x < 8; ++x)
+                EXPECT_EQ(reference_pixel(planes + row * 2, x, false), pixels[row * 8 + x]) << "isa " << isa;
+        }
+    }
+}
+
+TEST(Tile_Decoder, Fetch_DMG_Line) {
+    byte_t vram[GB::VRAM_NON_CGB_SIZE];
+    fill_pseudo_random(vram, sizeof(vram));
+
+    for (unsigned isa_idx = 0; isa_idx < TileDecoder::ISA_NUM; ++isa_idx) {
+        const TileDecoder::Isa isa = TileDecoder::Isa(isa_idx);
+        if (!TileDecoder::is_supported(isa))
+            continue;
+
+        TileDecoder decoder(isa);
+        for (bool signed_tiles : { false, true }) {
+            const byte_t scx = 0xFB;    // wraps around the map
+            const byte_t y = 0x93;
+            byte_t pixels[TileDecoder::LINE_WIDTH];
+
+            decoder.fetch_line(vram, MAP_OFFSET, signed_tiles, false, scx, y, pixels);
+            for (unsigned x = 0; x < TileDecoder::LINE_WIDTH; ++x) {
+                const unsigned map_x = (scx + x) % 256;
+                const byte_t tile = vram[MAP_OFFSET + (y / 8) * 32 + map_x / 8];
+                const unsigned tile_offset = signed_tiles ? 0x1000 + int8_t(tile) * 16 : tile * 16;
+                const byte_t* row = vram + tile_offset + (y % 8) * 2;
+
+                EXPECT_EQ(reference_pixel(row, map_x % 8, false), pixels[x]) << "isa " << isa << ", x " << x;
+            }
+        }
+    }
+}
+
+TEST(Tile_Decoder, Fetch_CGB_Line) {
+    byte_t vram[GB::VRAM_CGB_SIZE];
+    fill_pseudo_random(vram, sizeof(vram));
+
+    TileDecoder decoder;
+    const byte_t scx = 0x0D;
+    const byte_t y = 0x42;
+    byte_t pixels[TileDecoder::LINE_WIDTH];
+
+    decoder.fetch_line(vram, MAP_OFFSET, false, true, scx, y, pixels);
+    for (unsigned x = 0; x < TileDecoder::LINE_WIDTH; ++x) {
+        const unsigned map_x = (scx + x) % 256;
+        const unsigned map_idx = MAP_OFFSET + (y / 8) * 32 + map_x / 8;
+        const byte_t attrs = vram[GB::VRAM_BANK_SIZE + map_idx];
+        const unsigned bank_base = ::bit_n(TileDecoder::ATTR_BANK_BIT, attrs) ? GB::VRAM_BANK_SIZE : 0;
+        const unsigned tile_row = ::bit_n(TileDecoder::ATTR_VFLIP_BIT, attrs) ? 7 - y % 8 : y % 8;
+        const byte_t* row = vram + bank_base + vram[map_idx] * 16 + tile_row * 2;
+        const bool hflip = ::bit_n(TileDecoder::ATTR_HFLIP_BIT, attrs);
+
+        EXPECT_EQ(reference_pixel(row, map_x % 8, hflip), pixels[x]) << "x " << x;
+    }
+}
+
+}  // namespace
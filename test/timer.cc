@@ -0,0 +1,230 @@
+#include <random>
+
+#include "gtest/gtest.h"
+
+#include "GB_test.h"
+
+#include "common/GB_clock.h"
+#include "common/GB_scheduler.h"
+#include "device/GB_interrupt.h"
+#include "device/GB_timer.h"
+#include "memory/GB_bus.h"
+#include "memory/GB_vaddr.h"
+
+namespace {
+
+using Bus = GB::memory::BusInterface;
+using IntController = GB::device::InterruptController;
+using Timer = GB::device::Timer;
+using Vaddr = GB::memory::VirtualAddress;
+
+constexpr clk_cycle_t EDGE_PERIODS[] = { 1024, 16, 64, 256 };
+
+struct Timer_Test : public ::testing::Test {
+    Bus                 bus;
+    devsync::Scheduler  scheduler;
+    IntController       int_ctrl;
+    Timer               timer;
+
+    Timer_Test() : timer(&int_ctrl, &scheduler) {
+        timer.map_to_memory(bus);
+        int_ctrl.map_to_memory(bus);
+    }
+
+    bool is_interrupt_requested() const {
+        return ::bit_n(IntController::TIMOVER_INT, int_ctrl.get_IF_reg());
+    }
+};
+
+/**
+ * Timer model, which is stepped every clock cycle
+ */
+struct SteppedTimer {
+    clk_cycle_t time = 0;
+    clk_cycle_t reload_time = -1;
+    clk_cycle_t last_reload = -1;
+    unsigned    counter = 0;
+    unsigned    tima = 0;
+    byte_t      tma = 0;
+    byte_t      tac = 0;
+    bool        interrupt = false;
+
+    bool signal() const {
+        return ::bit_n(Timer::TAC_ENABLE_BIT, tac) && ::bit_n(Timer::TIMA_COUNTER_BITS[tac & 0b11], counter);
+    }
+
+    void increment() {
+        if (++tima == Timer::TIMA_OVERFLOW) {
+            tima = 0;
+            reload_time = time + Timer::RELOAD_DELAY;
+        }
+    }
+
+    void step() {
+        const bool old_signal = signal();
+
+        ++time;
+        counter = (counter + 1) & Timer::COUNTER_MASK;
+        if (time == reload_time) {
+            tima = tma;
+            interrupt = true;
+            reload_time = -1;
+            last_reload = time;
+        }
+        if (old_signal && !signal())
+            increment();
+    }
+
+    void write_DIV() {
+        const bool old_signal = signal();
+        counter = 0;
+        if (old_signal)
+            increment();
+    }
+
+    void write_TAC(byte_t value) {
+        const bool old_signal = signal();
+        tac = value & 0b111;
+        if (old_signal && !signal())
+            increment();
+    }
+
+    void write_TIMA(byte_t value) {
+        if (time == last_reload)
+            return;
+        reload_time = -1;
+        tima = value;
+    }
+
+    void write_TMA(byte_t value) {
+        tma = value;
+        if (time == last_reload)
+            tima = value;
+    }
+};
+
+TEST_F(Timer_Test, DIV_Counter) {
+    EXPECT_EQ(0x0, bus.read(Vaddr::DIV_VADDR));
+    scheduler.advance(0x100);
+    EXPECT_EQ(0x1, bus.read(Vaddr::DIV_VADDR));
+    scheduler.advance(0xFF00 * 3 + 0x1234);
+    EXPECT_EQ(0x10, bus.read(Vaddr::DIV_VADDR));
+
+    // any write resets the counter
+    bus.write(Vaddr::DIV_VADDR, 0xAB);
+    EXPECT_EQ(0x0, bus.read(Vaddr::DIV_VADDR));
+    scheduler.advance(0xFF);
+    EXPECT_EQ(0x0, bus.read(Vaddr::DIV_VADDR));
+    EXPECT_EQ(0xF8, bus.read(Vaddr::TAC_VADDR));
+}
+
+TEST_F(Timer_Test, TIMA_Frequencies) {
+    for (byte_t clock_select = 0; clock_select < 4; ++clock_select) {
+        bus.write(Vaddr::DIV_VADDR, 0x0);
+        bus.write(Vaddr::TIMA_VADDR, 0x0);
+        bus.write(Vaddr::TAC_VADDR, byte_t(0x4 | clock_select));
+
+        scheduler.advance(EDGE_PERIODS[clock_select] * 3 - 1);
+        EXPECT_EQ(0x2, bus.read(Vaddr::TIMA_VADDR));
+        scheduler.advance(1);
+        EXPECT_EQ(0x3, bus.read(Vaddr::TIMA_VADDR));
+
+        // disabled timer doesn't count
+        bus.write(Vaddr::TAC_VADDR, clock_select);
+        scheduler.advance(EDGE_PERIODS[clock_select] * 4);
+        EXPECT_EQ(0x3, bus.read(Vaddr::TIMA_VADDR));
+    }
+}
+
+TEST_F(Timer_Test, Overflow_Reload) {
+    bus.write(Vaddr::TMA_VADDR, 0xF0);
+    bus.write(Vaddr::TIMA_VADDR, 0xFE);
+    bus.write(Vaddr::TAC_VADDR, 0x05);
+
+    scheduler.advance(16);
+    EXPECT_EQ(0xFF, bus.read(Vaddr::TIMA_VADDR));
+
+    // TIMA is zero for an M-cycle before the reload
+    scheduler.advance(16);
+    EXPECT_EQ(0x00, bus.read(Vaddr::TIMA_VADDR));
+    EXPECT_FALSE(is_interrupt_requested());
+    scheduler.advance(Timer::RELOAD_DELAY);
+    EXPECT_EQ(0xF0, bus.read(Vaddr::TIMA_VADDR));
+    EXPECT_TRUE(is_interrupt_requested());
+
+    // the next overflow is a single event after 16 increments
+    int_ctrl.reset_interrupt(IntController::TIMOVER_INT);
+    EXPECT_EQ(scheduler.get_time() + 16 * 16 - Timer::RELOAD_DELAY, scheduler.get_next_deadline());
+}
+
+TEST_F(Timer_Test, Falling_Edge_Glitches) {
+    bus.write(Vaddr::TAC_VADDR, 0x05);
+
+    // counter bit 3 is set, so DIV reset is a falling edge
+    scheduler.advance(8);
+    bus.write(Vaddr::DIV_VADDR, 0x0);
+    EXPECT_EQ(0x1, bus.read(Vaddr::TIMA_VADDR));
+
+    // disabling timer is a falling edge too
+    scheduler.advance(8);
+    bus.write(Vaddr::TAC_VADDR, 0x01);
+    EXPECT_EQ(0x2, bus.read(Vaddr::TIMA_VADDR));
+
+    // clock select change from set bit to reset bit
+    bus.write(Vaddr::TAC_VADDR, 0x05);
+    bus.write(Vaddr::TAC_VADDR, 0x06);
+    EXPECT_EQ(0x3, bus.read(Vaddr::TIMA_VADDR));
+}
+
+TEST_F(Timer_Test, Write_During_Reload) {
+    bus.write(Vaddr::TMA_VADDR, 0x40);
+    bus.write(Vaddr::TIMA_VADDR, 0xFF);
+    bus.write(Vaddr::TAC_VADDR, 0x05);
+
+    // write in the overflow M-cycle cancels the reload and the interrupt
+    scheduler.advance(16);
+    bus.write(Vaddr::TIMA_VADDR, 0x10);
+    scheduler.advance(Timer::RELOAD_DELAY);
+    EXPECT_EQ(0x10, bus.read(Vaddr::TIMA_VADDR));
+    EXPECT_FALSE(is_interrupt_requested());
+
+    // TIMA write at the reload M-cycle is ignored, TMA write is loaded to TIMA
+    bus.write(Vaddr::TIMA_VADDR, 0xFF);
+    bus.write(Vaddr::DIV_VADDR, 0x0);
+    scheduler.advance(16 + Timer::RELOAD_DELAY);
+    bus.write(Vaddr::TIMA_VADDR, 0x20);
+    EXPECT_EQ(0x40, bus.read(Vaddr::TIMA_VADDR));
+    bus.write(Vaddr::TMA_VADDR, 0x50);
+    EXPECT_EQ(0x50, bus.read(Vaddr::TIMA_VADDR));
+    EXPECT_TRUE(is_interrupt_requested());
+}
+
+TEST_F(Timer_Test, Same_As_Stepped_Timer) {
+    SteppedTimer    stepped;
+    std::mt19937    random(0x7133);
+
+    for (unsigned action = 0; action < 20000; ++action) {
+        const clk_cycle_t cycles = (random() % 8 == 0) ? clk_cycle_t(random() % 4096) * 4
+                                                        : clk_cycle_t(random() % 24) * 4;
+        scheduler.advance(cycles);
+        for (clk_cycle_t cycle = 0; cycle < cycles; ++cycle)
+            stepped.step();
+
+        const byte_t value = byte_t(random());
+        switch (random() % 6) {
+            case 0: bus.write(Vaddr::DIV_VADDR, value); stepped.write_DIV(); break;
+            case 1: bus.write(Vaddr::TIMA_VADDR, value); stepped.write_TIMA(value); break;
+            case 2: bus.write(Vaddr::TMA_VADDR, value); stepped.write_TMA(value); break;
+            case 3: bus.write(Vaddr::TAC_VADDR, value); stepped.write_TAC(value); break;
+            default: break;
+        }
+
+        ASSERT_EQ(byte_t(stepped.counter >> 8), bus.read(Vaddr::DIV_VADDR)) << "action " << action;
+        ASSERT_EQ(stepped.tima, bus.read(Vaddr::TIMA_VADDR)) << "action " << action;
+        ASSERT_EQ(stepped.interrupt, is_interrupt_requested()) << "action " << action;
+        stepped.interrupt = false;
+        int_ctrl.reset_interrupt(IntController::TIMOVER_INT);
+    }
+}
+
+}  // namespace
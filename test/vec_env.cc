@@ -0,0 +1,201 @@
+#include <memory_resource>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "GB_test.h"
+
+#include "core/GB_machine.h"
+#include "core/GB_vec_env.h"
+#include "device/GB_joypad.h"
+#include "memory/GB_vaddr.h"
+
+/** Allocations of global operator new, which are counted while is_counted is set */
+static std::atomic<bool>    is_counted { false };
+static std::atomic<size_t>  allocations_num { 0 };
+
+static void* counted_allocate(size_t size, size_t alignment) {
+    void* ptr;
+
+    if (is_counted)
+        ++allocations_num;
+    size = (size != 0) ? size : 1;
+    if (alignment <= __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+        ptr = std::malloc(size);
+    else
+        ptr = std::aligned_alloc(alignment, (size + alignment - 1) & ~(alignment - 1));
+    if (ptr == nullptr)
+        throw std::bad_alloc();
+    return ptr;
+}
+
+void* operator new(size_t size) { return counted_allocate(size, 0); }
+void* operator new[](size_t size) { return counted_allocate(size, 0); }
+void* operator new(size_t size, std::align_val_t align) { return counted_allocate(size, size_t(align)); }
+void* operator new[](size_t size, std::align_val_t align) { return counted_allocate(size, size_t(align)); }
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete[](void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, size_t) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, size_t) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::align_val_t) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, std::align_val_t) noexcept { std::free(ptr); }
+void operator delete(void* ptr, size_t, std::align_val_t) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, size_t, std::align_val_t) noexcept { std::free(ptr); }
+
+namespace {
+
+using DMGMachine = GB::core::Machine<GB::DMG_MODE>;
+using VecEnv = GB::core::VecEnv<GB::DMG_MODE>;
+using JoyPad = GB::device::JoyPad;
+
+constexpr unsigned INSTANCES_NUM = 5;
+constexpr unsigned FRAMES_PER_STEP = 2;
+
+/** Game, which reads direction keys to 0xC000 and counts the reads at 0xC001 */
+dbuffer_t make_input_rom() {
+    dbuffer_t rom(32_KBytes);
+    const byte_t program[] = {
+        0x3E, 0x20,         // 0100: LD A,0x20
+        0xE0, 0x00,         // 0102: LDH (P1),A
+        0xF0, 0x00,         // 0104: LDH A,(P1)
+        0xEA, 0x00, 0xC0,   // 0106: LD (0xC000),A
+        0x21, 0x01, 0xC0,   // 0109: LD HL,0xC001
+        0x34,               // 010C: INC (HL)
+        0x18, 0xF1,         // 010D: JR 0x0100
+    };
+
+    std::fill(rom.get_data_addr(), rom.get_data_addr() + rom.size(), 0x0);
+    std::copy(std::begin(program), std::end(program), &rom[GB::CPU_PC_INIT_VALUE]);
+    return rom;
+}
+
+/** Game, which runs through the ROM: every 8 bytes are a delay loop, so a step runs new code */
+dbuffer_t make_walking_rom() {
+    dbuffer_t rom(32_KBytes);
+    const byte_t jump[] = { 0xC3, 0x00, 0x02 };     // JP 0x0200
+    const byte_t delay[] = {
+        0x06, 0xFF,         // LD B,0xFF
+        0x05,               // DEC B
+        0x20, 0xFD,         // JR NZ,-3
+        0x00, 0x00, 0x00,   // NOP x3
+    };
+    const size_t last_vaddr = rom.size() - sizeof(jump);
+
+    std::fill(rom.get_data_addr(), rom.get_data_addr() + rom.size(), 0x0);
+    std::copy(std::begin(jump), std::end(jump), &rom[GB::CPU_PC_INIT_VALUE]);
+    for (size_t vaddr = 0x200; vaddr + sizeof(delay) <= last_vaddr; vaddr += sizeof(delay))
+        std::copy(std::begin(delay), std::end(delay), &rom[vaddr]);
+    std::copy(std::begin(jump), std::end(jump), &rom[last_vaddr]);
+    return rom;
+}
+
+VecEnv::Config make_config(unsigned workers_num) {
+    VecEnv::Config config;
+
+    config.instances_num = INSTANCES_NUM;
+    config.frames_per_step = FRAMES_PER_STEP;
+    config.workers_num = workers_num;
+    config.observation = { {0xC000, 0x2}, {0xFF00, 0x1} };
+    config.rewards = { {0xC001, 0.5f} };
+    return config;
+}
+
+std::vector<byte_t> observe(DMGMachine& machine) {
+    return { machine.get_bus().read(0xC000), machine.get_bus().read(0xC001), machine.get_bus().read(0xFF00) };
+}
+
+std::vector<byte_t> observe(const VecEnv& env, unsigned instance) {
+    return std::vector<byte_t>(env.get_observation(instance), env.get_observation(instance) + env.get_observation_size());
+}
+
+TEST(Vec_Env, Same_As_Machines) {
+    const dbuffer_t                             rom = make_input_rom();
+    VecEnv                                      env(rom, make_config(2));
+    std::vector<std::unique_ptr<DMGMachine>>    machines;
+    const byte_t                                left = ::bits_set(JoyPad::LF_KEY);
+    const byte_t                                up = ::bits_set(JoyPad::UP_KEY);
+
+    for (unsigned instance = 0; instance < INSTANCES_NUM; ++instance)
+        machines.emplace_back(std::make_unique<DMGMachine>(dbuffer_t(rom)));
+
+    EXPECT_EQ(INSTANCES_NUM, env.size());
+    EXPECT_EQ(2, env.get_workers_num());
+    EXPECT_EQ(3, env.get_observation_size());
+    EXPECT_EQ(env.get_observation(1), env.get_observations() + env.get_observation_size());
+    EXPECT_EQ(observe(*machines[0]), observe(env, 0));
+
+    for (unsigned step = 0; step < 6; ++step) {
+        byte_t actions[INSTANCES_NUM];
+
+        for (unsigned instance = 0; instance < INSTANCES_NUM; ++instance)
+            actions[instance] = ((step + instance) % 3 == 0) ? left : ((step + instance) % 3 == 1) ? up : 0x0;
+        env.step(actions);
+
+        for (unsigned instance = 0; instance < INSTANCES_NUM; ++instance) {
+            DMGMachine& machine = *machines[instance];
+            const byte_t counter = machine.get_bus().read(0xC001);
+
+            machine.get_joypad().set_pressed_key_set(actions[instance]);
+            for (unsigned frame = 0; frame < FRAMES_PER_STEP; ++frame)
+                machine.run_frame();
+
+            EXPECT_EQ(observe(machine), observe(env, instance));
+            EXPECT_EQ(0.5f * float(int(machine.get_bus().read(0xC001)) - int(counter)), env.get_rewards()[instance]);
+            EXPECT_EQ(machine.get_scheduler().get_time(), env.get_machine(instance).get_scheduler().get_time());
+        }
+    }
+}
+
+TEST(Vec_Env, Reset) {
+    const dbuffer_t rom = make_input_rom();
+    VecEnv          env(rom, make_config(0));
+    DMGMachine      initial { dbuffer_t(rom) };
+    const byte_t    actions[INSTANCES_NUM] = {};
+
+    env.step(actions);
+    env.reset(1);
+    EXPECT_EQ(observe(initial), observe(env, 1));
+    EXPECT_EQ(0.0f, env.get_rewards()[1]);
+    EXPECT_EQ(0, env.get_machine(1).get_scheduler().get_time());
+    EXPECT_NE(0, env.get_machine(0).get_scheduler().get_time());
+
+    env.reset();
+    for (unsigned instance = 0; instance < INSTANCES_NUM; ++instance) {
+        EXPECT_EQ(observe(initial), observe(env, instance));
+        EXPECT_EQ(0, env.get_machine(instance).get_scheduler().get_time());
+    }
+}
+
+TEST(Vec_Env, No_Steady_State_Allocations) {
+    // pool grows by operator new, so it's counted too
+    VecEnv          env(make_walking_rom(), make_config(3), std::pmr::new_delete_resource());
+    byte_t          actions[INSTANCES_NUM] = {};
+    const byte_t*   observations = env.get_observations();
+
+    env.step(actions);
+    const word_t warm_pc = env.get_machine(0).get_cpu().get_registers().PC;
+
+    // steps decode blocks of code pages, which weren't run before
+    is_counted = true;
+    for (unsigned step = 0; step < 20; ++step) {
+        actions[step % INSTANCES_NUM] ^= ::bits_set(JoyPad::A_KEY);
+        env.step(actions);
+    }
+    const word_t pc = env.get_machine(0).get_cpu().get_registers().PC;
+    env.reset();
+    env.reset(0);
+    is_counted = false;
+
+    EXPECT_LT(warm_pc + 10 * GB::memory::BusInterface::PAGE_SIZE, pc);
+    EXPECT_EQ(0, allocations_num.load());
+    EXPECT_EQ(observations, env.get_observations());
+}
+
+}  // namespace
@@ -2,10 +2,11 @@
 
 #define protected public    // TODO(dolovnyak): Use #include "GB_test.h" now!
 #include "device/GB_vram.h"
+#include "memory/GB_bus.h"
 
 namespace {
 
-using VRAM = GB::device::VRAM;
+using VRAM = GB::device::VRAM<GB::CGB_MODE>;
 
 TEST(VideoRAM, Constructors) {
     VRAM vram;
@@ -104,6 +105,252 @@ TEST(VideoRAM, Inner_Read_Write) {
     EXPECT_EQ(vram.__memory[0x3FFF], 32);
 }
 
-// TODO(dolovnyak): Add tests with membus when it well be implemented
+TEST(VideoRAM, Bank_Pointer) {
+    VRAM vram;
+
+    EXPECT_EQ(vram.get_bank_addr(), vram.__memory.get_data_addr());
+    vram.set_VBK_reg(0x1);
+    EXPECT_EQ(vram.get_bank_addr(), vram.__memory.get_data_addr() + GB::VRAM_BANK_SIZE);
+    vram.write_phys_addr(0x2010, 0);
+
+    VRAM vram_copy(vram);
+    EXPECT_EQ(vram_copy.get_bank_addr(), vram_copy.__memory.get_data_addr() + GB::VRAM_BANK_SIZE);
+
+    vram_copy.write_inner_vaddr(0x10, 40);
+    EXPECT_EQ(vram_copy.read_phys_addr(0x2010), 40);
+    EXPECT_EQ(vram.read_phys_addr(0x2010), 0);
+}
+
+TEST(VideoRAM, Memory_Bus) {
+    using Bus = GB::memory::BusInterface;
+
+    VRAM vram;
+    Bus bus;
+
+    vram.map_to_memory(bus);
+
+    EXPECT_EQ(bus.read(0xFF4F), 0xFE);
+    bus.write(0x8000, 20);
+    bus.write(0x9FFF, 21);
+
+    bus.write(0xFF4F, 0x1);
+    EXPECT_EQ(bus.read(0xFF4F), 0xFF);
+    bus.write(0x8000, 30);
+    bus.write(0x9FFF, 31);
+
+    EXPECT_EQ(vram.__memory[0x0], 20);
+    EXPECT_EQ(vram.__memory[0x1FFF], 21);
+    EXPECT_EQ(vram.__memory[0x2000], 30);
+    EXPECT_EQ(vram.__memory[0x3FFF], 31);
+
+    vram.set_VBK_reg(0x0);
+    EXPECT_EQ(bus.read(0x8000), 20);
+    EXPECT_EQ(bus.read(0x9FFF), 21);
+}
+
+TEST(VideoRAM, Dirty_Pages) {
+    using Bus = GB::memory::BusInterface;
+
+    VRAM vram;
+    Bus bus;
+
+    vram.map_to_memory(bus);
+    vram.clear_dirty_pages();
+    EXPECT_TRUE(vram.get_dirty_pages().none());
+    EXPECT_EQ(nullptr, bus.__pages[0x98].wr_host);
+
+    // tile data is always trapped, tile maps are mapped directly after the first write
+    bus.write(0x8010, 0x1);
+    bus.write(0x9801, 0x2);
+    EXPECT_TRUE(vram.get_dirty_pages()[0x00]);
+    EXPECT_TRUE(vram.get_dirty_pages()[0x18]);
+    EXPECT_EQ(nullptr, bus.__pages[0x80].wr_host);
+    EXPECT_NE(nullptr, bus.__pages[0x98].wr_host);
+    EXPECT_EQ(nullptr, bus.__pages[0x99].wr_host);
+    bus.write(0x9802, 0x3);
+    EXPECT_EQ(0x3, vram.read_phys_addr(0x1802));
+
+    // pages of bank 1 are tracked separately
+    bus.write(0xFF4F, 0x1);
+    EXPECT_EQ(nullptr, bus.__pages[0x98].wr_host);
+    bus.write(0x9FFF, 0x4);
+    EXPECT_TRUE(vram.get_dirty_pages()[0x3F]);
+    EXPECT_NE(nullptr, bus.__pages[0x9F].wr_host);
+
+    const byte_t block[4] = {0x5, 0x6, 0x7, 0x8};
+    vram.write_block(0x1C00, block, sizeof(block));
+    EXPECT_TRUE(vram.get_dirty_pages()[0x3C]);
+    EXPECT_NE(nullptr, bus.__pages[0x9C].wr_host);
+    EXPECT_EQ(4, vram.get_dirty_pages().count());
+
+    vram.clear_dirty_pages();
+    EXPECT_EQ(nullptr, bus.__pages[0x9F].wr_host);
+    EXPECT_EQ(0x4, bus.read(0x9FFF));
+}
+
+TEST(VideoRAM, Copy_On_Write) {
+    using Bus = GB::memory::BusInterface;
+
+    VRAM    vram;
+    Bus     bus;
+
+    vram.map_to_memory(bus);
+    bus.write(0x8000, 0x1);
+    bus.write(0x9800, 0x2);
+    bus.write(0x9801, 0x0);
+
+    vram.share_memory();
+    VRAM vram_fork(vram);
+    EXPECT_EQ(vram.get_bank_addr(), vram_fork.get_bank_addr());
+    EXPECT_EQ(nullptr, bus.__pages[0x80].wr_host);
+    EXPECT_EQ(nullptr, bus.__pages[0x98].wr_host);
+
+    // only the written bank is copied (tile data stays trapped)
+    bus.write(0x9801, 0x3);
+    EXPECT_EQ(nullptr, bus.__pages[0x80].wr_host);
+    EXPECT_EQ(nullptr, bus.__pages[0x90].wr_host);
+    EXPECT_NE(nullptr, bus.__pages[0x98].wr_host);
+    EXPECT_EQ(0x2, bus.read(0x9800));
+    EXPECT_EQ(0x3, bus.read(0x9801));
+    EXPECT_EQ(0x0, vram_fork.read_inner_vaddr(0x1801));
+
+    vram_fork.write_inner_vaddr(0x0000, 0x4);
+    EXPECT_EQ(0x4, vram_fork.read_inner_vaddr(0x0000));
+    EXPECT_EQ(0x1, bus.read(0x8000));
+}
+
+TEST(VideoRAM, DMG_Mode) {
+    using DMG_VRAM = GB::device::VRAM<GB::DMG_MODE>;
+
+    DMG_VRAM vram;
+
+    EXPECT_EQ(DMG_VRAM::MAX_SIZE, GB::VRAM_NON_CGB_SIZE);
+    EXPECT_EQ(vram.__memory.size(), GB::VRAM_NON_CGB_SIZE);
+    EXPECT_EQ(vram.get_VBK_reg(), 0xFF);
+
+    vram.write_inner_vaddr(0x10, 20);
+    vram.set_VBK_reg(0x1);
+    EXPECT_EQ(vram.get_VBK_reg(), 0xFF);
+    EXPECT_EQ(vram.read_inner_vaddr(0x10), 20);
+}
+
+TEST(VideoRAM, Tile_Cache) {
+    using Bus = GB::memory::BusInterface;
+
+    VRAM    vram;
+    Bus     bus;
+
+    vram.map_to_memory(bus);
+    EXPECT_EQ(nullptr, bus.__pages[0x97].wr_host);
+    EXPECT_NE(nullptr, bus.__pages[0x98].wr_host);
+
+    // row 1 of tile 2: low bitplane 0b10100101, high bitplane 0b11000011
+    bus.write(0x8022, 0b10100101);
+    bus.write(0x8023, 0b11000011);
+    const byte_t expected_row[8] = { 3, 2, 1, 0, 0, 1, 2, 3 };
+    const byte_t* row = vram.get_tile_row(0, 2, 1);
+    for (unsigned x = 0; x < 8; ++x)
+        EXPECT_EQ(expected_row[x], row[x]);
+    EXPECT_EQ(0, vram.__dirty_rows[2] & 0b10);
+
+    // write marks only the affected row
+    const byte_t* tile = vram.get_tile(0, 2);
+    EXPECT_EQ(0, vram.__dirty_rows[2]);
+    bus.write(0x802E, 0xFF);
+    EXPECT_EQ(0b10000000, vram.__dirty_rows[2]);
+    EXPECT_EQ(1, vram.get_tile_row(0, 2, 7)[0]);
+    EXPECT_EQ(0, vram.__dirty_rows[2]);
+    EXPECT_EQ(3, tile[8]);
+
+    // tile maps aren't tile data
+    vram.get_tile(0, VRAM::TILES_NUM - 1);
+    bus.write(0x9800, 0xFF);
+    EXPECT_EQ(0, vram.__dirty_rows[VRAM::TILES_NUM - 1]);
+    bus.write(0x97FF, 0xFF);
+    EXPECT_EQ(0b10000000, vram.__dirty_rows[VRAM::TILES_NUM - 1]);
+
+    // bank 1 and physical writes
+    vram.write_phys_addr(0x2000 + 0x10, 0xFF);
+    EXPECT_EQ(1, vram.get_tile_row(1, 1, 0)[7]);
+    vram.set_VBK_reg(0x1);
+    bus.write(0x8011, 0xFF);
+    EXPECT_EQ(3, vram.get_tile_row(1, 1, 0)[0]);
+    EXPECT_EQ(3, vram.get_tile_row(0, 2, 1)[0]);
+
+    // copy doesn't copy the cache, its tiles are decoded again from the memory
+    VRAM vram_copy(vram);
+    EXPECT_EQ(0u, vram_copy.__tile_cache.size());
+    EXPECT_EQ(0xFF, vram_copy.__dirty_rows[2]);
+    EXPECT_EQ(3, vram_copy.get_tile_row(1, 1, 0)[0]);
+    EXPECT_EQ(3, vram_copy.get_tile_row(0, 2, 1)[0]);
+    vram_copy.invalidate_tile_cache();
+    EXPECT_EQ(0xFF, vram_copy.__dirty_rows[0]);
+    EXPECT_EQ(3, vram_copy.get_tile_row(1, 1, 0)[0]);
+
+    // assigned VRAM keeps its cache buffer and decodes it again
+    VRAM vram_assigned;
+    vram_assigned.get_tile(0, 0);
+    const byte_t* cache = vram_assigned.__tile_cache.get_data_addr();
+    vram_assigned = vram;
+    EXPECT_EQ(cache, vram_assigned.__tile_cache.get_data_addr());
+    EXPECT_EQ(0xFF, vram_assigned.__dirty_rows[2]);
+    EXPECT_EQ(3, vram_assigned.get_tile_row(0, 2, 1)[0]);
+}
+
+TEST(VideoRAM, Write_Block) {
+    VRAM    vram;
+    byte_t  block[0x20];
+
+    for (unsigned offset = 0; offset < sizeof(block); ++offset) {
+        block[offset] = byte_t(offset + 1);
+        vram.write_phys_addr(GB::VRAM_BANK_SIZE + 0x0FF0 + offset, 0x0);
+    }
+    vram.get_tile(1, 0xFF);
+    vram.get_tile(1, 0x100);
+    vram.share_memory();
+    VRAM vram_fork(vram);
+
+    // block crosses the copy-on-write page boundary of the bank 1
+    vram.set_VBK_reg(0x1);
+    vram.write_block(0x0FF0, block, sizeof(block));
+    for (unsigned offset = 0; offset < sizeof(block); ++offset)
+        EXPECT_EQ(block[offset], vram.read_phys_addr(GB::VRAM_BANK_SIZE + 0x0FF0 + offset));
+    EXPECT_EQ(0x0, vram_fork.read_phys_addr(GB::VRAM_BANK_SIZE + 0x0FF0));
+    EXPECT_EQ(0xFF, vram.__dirty_rows[VRAM::TILES_NUM + 0xFF]);
+    EXPECT_EQ(0xFF, vram.__dirty_rows[VRAM::TILES_NUM + 0x100]);
+
+    // partial rows are marked dirty too
+    vram.get_tile(1, 0xFF);
+    vram.write_block(0x0FF3, block, 0x3);
+    EXPECT_EQ(0b110, vram.__dirty_rows[VRAM::TILES_NUM + 0xFF]);
+}
+
+TEST(VideoRAM, Block_Read_And_View) {
+    VRAM    vram;
+    byte_t  result[0x10] = {};
+
+    vram.write_phys_addr(GB::VRAM_BANK_SIZE + 0x1FF8, 0x1);
+    vram.write_phys_addr(GB::VRAM_BANK_SIZE, 0x2);
+    vram.write_phys_addr(GB::VRAM_BANK_SIZE + 0x1800, 0x0);
+    vram.set_VBK_reg(0x1);
+
+    // inner address wraps at the end of the bank
+    vram.read_block(0x1FF8, result, sizeof(result));
+    EXPECT_EQ(0x1, result[0x0]);
+    EXPECT_EQ(0x2, result[0x8]);
+
+    vram.share_memory();
+    VRAM vram_fork(vram);
+    vram.write_inner_vaddr(0x1800, 0x3);
+
+    // bank pages are copied together, so the bank view stays contiguous
+    const span_t<const byte_t> bank = vram.view_bank(1);
+    EXPECT_EQ(GB::VRAM_BANK_SIZE, bank.size());
+    EXPECT_EQ(vram.get_bank_addr(), bank.data());
+    EXPECT_EQ(0x2, bank[0x0]);
+    EXPECT_EQ(0x3, bank[0x1800]);
+    EXPECT_EQ(0x0, vram_fork.view_bank(1)[0x1800]);
+    EXPECT_NE(vram_fork.view_bank(1).data(), bank.data());
+}
 
 }   // namespace
@@ -0,0 +1,80 @@
+#ifdef __linux__
+# include <sched.h>
+#endif
+
+#include <atomic>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "GB_test.h"
+
+#include "common/GB_worker_pool.h"
+
+namespace {
+
+struct Counters {
+    std::vector<unsigned>   runs;           ///< runs of every worker
+    std::atomic<unsigned>   total;
+};
+
+void count_job(void* context, unsigned worker_idx) {
+    Counters& counters = *static_cast<Counters*>(context);
+
+    ++counters.runs[worker_idx];
+    ++counters.total;
+}
+
+TEST(Worker_Pool, Run) {
+    worker_pool_t   pool(4, false);
+    Counters        counters = { std::vector<unsigned>(pool.size(), 0), {0} };
+
+    EXPECT_EQ(4, pool.size());
+    EXPECT_EQ(0, pool.get_pinned_num());
+    for (unsigned run = 0; run < 100; ++run) {
+        pool.run(&count_job, &counters);
+        // run() returns after every worker
+        EXPECT_EQ((run + 1) * pool.size(), counters.total.load());
+    }
+    for (unsigned runs : counters.runs)
+        EXPECT_EQ(100, runs);
+}
+
+TEST(Worker_Pool, Pinned) {
+    worker_pool_t   pool(2);
+    Counters        counters = { std::vector<unsigned>(pool.size(), 0), {0} };
+
+    EXPECT_EQ(worker_pool_t::is_pinning_supported() ? 2 : 0, pool.get_pinned_num());
+    pool.run(&count_job, &counters);
+    EXPECT_EQ(2, counters.total.load());
+
+    // there is always a worker
+    worker_pool_t   single(0, false);
+    EXPECT_EQ(1, single.size());
+}
+
+TEST(Worker_Pool, CPUs_Num) {
+    EXPECT_LE(1, worker_pool_t::get_cpus_num());
+
+#ifdef __linux__
+    // restricted process gets only its CPUs
+    cpu_set_t allowed;
+    cpu_set_t single;
+
+    ASSERT_EQ(0, sched_getaffinity(0, sizeof(allowed), &allowed));
+    EXPECT_EQ(CPU_COUNT(&allowed), worker_pool_t::get_cpus_num());
+
+    CPU_ZERO(&single);
+    for (unsigned cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+        if (CPU_ISSET(cpu, &allowed)) {
+            CPU_SET(cpu, &single);
+            break;
+        }
+    }
+    ASSERT_EQ(0, sched_setaffinity(0, sizeof(single), &single));
+    EXPECT_EQ(1, worker_pool_t::get_cpus_num());
+    EXPECT_EQ(0, sched_setaffinity(0, sizeof(allowed), &allowed));
+#endif
+}
+
+}  // namespace
@@ -4,10 +4,11 @@
 
 #include "GB_config.h"
 #include "device/GB_wram.h"
+#include "memory/GB_bus.h"
 
 namespace {
 
-using WRAM = GB::device::WRAM;
+using WRAM = GB::device::WRAM<GB::CGB_MODE>;
 
 inline byte_t set_SVBK_reserved_bits(byte_t value) {
     return value | WRAM::Registers::RESERVED_BITS;
@@ -136,4 +137,254 @@ TEST(Work_RAM, SVBK_Bank_Choose) {
     EXPECT_EQ(7, ram.__get_current_bank_idx());
 }
 
+TEST(Work_RAM, Inner_Read_Write) {
+    WRAM    ram;
+
+    ram.write_inner_vaddr(0x0000, 0x10);
+    ram.write_inner_vaddr(0x0FFF, 0x11);
+
+    ram.set_SVBK_reg(0x0);
+    ram.write_inner_vaddr(0x1000, 0x21);
+    ram.set_SVBK_reg(0x5);
+    ram.write_inner_vaddr(0x1000, 0x25);
+    ram.write_inner_vaddr(0x1FFF, 0x26);
+
+    EXPECT_EQ(ram.read_phys_addr(0x0000), 0x10);
+    EXPECT_EQ(ram.read_phys_addr(0x0FFF), 0x11);
+    EXPECT_EQ(ram.read_phys_addr(0x1000), 0x21);
+    EXPECT_EQ(ram.read_phys_addr(0x5000), 0x25);
+    EXPECT_EQ(ram.read_phys_addr(0x5FFF), 0x26);
+
+    EXPECT_EQ(ram.read_inner_vaddr(0x1000), 0x25);
+    ram.set_SVBK_reg(0x1);
+    EXPECT_EQ(ram.read_inner_vaddr(0x1000), 0x21);
+}
+
+TEST(Work_RAM, Bank_Pointers) {
+    WRAM    ram;
+
+    EXPECT_EQ(ram.get_bank0_addr(), ram.__memory.get_data_addr());
+    EXPECT_EQ(ram.get_bankx_addr(), ram.__memory.get_data_addr() + WRAM::BANK_SIZE);
+
+    ram.set_SVBK_reg(0x7);
+    EXPECT_EQ(ram.get_bankx_addr(), ram.__memory.get_data_addr() + 7 * WRAM::BANK_SIZE);
+    ram.write_phys_addr(0x7000, 0x0);
+
+    // copies must point to own memory
+    WRAM ram_copy(ram);
+    EXPECT_EQ(ram_copy.get_bank0_addr(), ram_copy.__memory.get_data_addr());
+    EXPECT_EQ(ram_copy.get_bankx_addr(), ram_copy.__memory.get_data_addr() + 7 * WRAM::BANK_SIZE);
+
+    WRAM ram_assigned;
+    ram_assigned = ram;
+    EXPECT_EQ(ram_assigned.get_bankx_addr(), ram_assigned.__memory.get_data_addr() + 7 * WRAM::BANK_SIZE);
+
+    ram_copy.write_inner_vaddr(0x1000, 0x42);
+    EXPECT_EQ(ram_copy.read_phys_addr(0x7000), 0x42);
+    EXPECT_EQ(ram.read_phys_addr(0x7000), 0x0);
+}
+
+TEST(Work_RAM, Copy_On_Write) {
+    using Bus = GB::memory::BusInterface;
+
+    WRAM    ram;
+    Bus     bus;
+
+    ram.map_to_memory(bus);
+    ram.set_SVBK_reg(0x2);
+    bus.write(0xC000, 0x1);
+    bus.write(0xD000, 0x2);
+
+    ram.share_memory();
+    WRAM ram_fork(ram);
+
+    // not modified banks are shared
+    EXPECT_EQ(ram.get_bank0_addr(), ram_fork.get_bank0_addr());
+    EXPECT_EQ(ram.get_bankx_addr(), ram_fork.get_bankx_addr());
+    EXPECT_EQ(nullptr, bus.__pages[0xD0].wr_host);
+    EXPECT_EQ(0x2, bus.read(0xD000));
+
+    // first write through the bus copies the bank and maps the copy
+    bus.write(0xF000, 0x3);
+    EXPECT_NE(nullptr, bus.__pages[0xD0].wr_host);
+    EXPECT_EQ(0x3, bus.read(0xD000));
+    EXPECT_EQ(0x3, ram.read_inner_vaddr(0x1000));
+    EXPECT_EQ(0x2, ram_fork.read_inner_vaddr(0x1000));
+    EXPECT_EQ(ram.get_bank0_addr(), ram_fork.get_bank0_addr());
+
+    ram_fork.write_inner_vaddr(0x0000, 0x4);
+    ram_fork.write_phys_addr(0x3000, 0x5);
+    EXPECT_EQ(0x4, ram_fork.read_inner_vaddr(0x0000));
+    EXPECT_EQ(0x5, ram_fork.read_phys_addr(0x3000));
+    EXPECT_EQ(0x1, bus.read(0xC000));
+    EXPECT_NE(ram.get_bank0_addr(), ram_fork.get_bank0_addr());
+
+    // bank switch maps a frozen bank for reading
+    bus.write(GB::memory::SVBK_VADDR, 0x3);
+    EXPECT_EQ(nullptr, bus.__pages[0xD0].wr_host);
+}
+
+TEST(Work_RAM, Memory_Bus) {
+    using Bus = GB::memory::BusInterface;
+
+    WRAM    ram;
+    Bus     bus;
+
+    ram.map_to_memory(bus);
+
+    EXPECT_EQ(set_SVBK_reserved_bits(GB::SVBK_INIT_VALUE), bus.read(GB::memory::SVBK_VADDR));
+
+    bus.write(0xC000, 0x1);
+    bus.write(0xD000, 0x2);
+    bus.write(GB::memory::SVBK_VADDR, 0x3);
+    EXPECT_EQ(set_SVBK_reserved_bits(0x3), bus.read(GB::memory::SVBK_VADDR));
+    bus.write(0xD000, 0x3);
+    bus.write(0xDFFF, 0x4);
+
+    EXPECT_EQ(ram.read_phys_addr(0x0000), 0x1);
+    EXPECT_EQ(ram.read_phys_addr(0x1000), 0x2);
+    EXPECT_EQ(ram.read_phys_addr(0x3000), 0x3);
+    EXPECT_EQ(ram.read_phys_addr(0x3FFF), 0x4);
+
+    // echo area
+    EXPECT_EQ(bus.read(0xE000), 0x1);
+    EXPECT_EQ(bus.read(0xF000), 0x3);
+    EXPECT_EQ(bus.read(0xFDFF), ram.read_phys_addr(0x3DFF));
+    bus.write(0xF001, 0x5);
+    EXPECT_EQ(ram.read_phys_addr(0x3001), 0x5);
+    EXPECT_EQ(bus.read(0xFE00), Bus::OPEN_BUS_VALUE);
+
+    ram.set_SVBK_reg(0x1);
+    EXPECT_EQ(bus.read(0xD000), 0x2);
+    EXPECT_EQ(bus.read(0xF000), 0x2);
+
+    // echo pages are aliases of WRAM pages
+    for (unsigned page = 0xE0; page <= 0xFD; ++page) {
+        EXPECT_NE(bus.__pages[page].rd_host, nullptr);
+        EXPECT_EQ(bus.__pages[page].rd_host, bus.__pages[page - 0x20].rd_host);
+        EXPECT_EQ(bus.__pages[page].wr_host, bus.__pages[page - 0x20].wr_host);
+    }
+
+    // copy is not mapped
+    WRAM ram_copy(ram);
+    ram_copy.set_SVBK_reg(0x3);
+    EXPECT_EQ(bus.read(0xD000), 0x2);
+}
+
+TEST(Work_RAM, Dirty_Pages) {
+    using Bus = GB::memory::BusInterface;
+
+    WRAM    ram;
+    Bus     bus;
+
+    ram.map_to_memory(bus);
+    EXPECT_TRUE(ram.get_dirty_pages().all());
+
+    // clean pages are mapped for reading only
+    ram.clear_dirty_pages();
+    EXPECT_TRUE(ram.get_dirty_pages().none());
+    EXPECT_EQ(nullptr, bus.__pages[0xC0].wr_host);
+    EXPECT_EQ(nullptr, bus.__pages[0xF0].wr_host);
+
+    // the first write marks the page and maps it directly, echo writes mark the same page
+    bus.write(0xC010, 0x1);
+    bus.write(0xF123, 0x2);
+    EXPECT_EQ(0x1, ram.read_phys_addr(0x0010));
+    EXPECT_EQ(0x2, ram.read_phys_addr(0x1123));
+    EXPECT_TRUE(ram.get_dirty_pages()[0x00]);
+    EXPECT_TRUE(ram.get_dirty_pages()[0x11]);
+    EXPECT_EQ(2, ram.get_dirty_pages().count());
+    EXPECT_NE(nullptr, bus.__pages[0xC0].wr_host);
+    EXPECT_NE(nullptr, bus.__pages[0xE0].wr_host);
+    EXPECT_NE(nullptr, bus.__pages[0xD1].wr_host);
+    EXPECT_EQ(nullptr, bus.__pages[0xC1].wr_host);
+    EXPECT_EQ(nullptr, bus.__pages[0xD2].wr_host);
+
+    // pages are physical, so WRAMX pages of another bank are tracked separately
+    bus.write(GB::memory::SVBK_VADDR, 0x3);
+    EXPECT_EQ(nullptr, bus.__pages[0xD1].wr_host);
+    bus.write(0xDFFF, 0x3);
+    EXPECT_TRUE(ram.get_dirty_pages()[0x3F]);
+    EXPECT_NE(nullptr, bus.__pages[0xDF].wr_host);
+
+    // writes not through the bus are tracked too
+    ram.write_phys_addr(0x2000, 0x4);
+    ram.write_block(0x0100, reinterpret_cast<const byte_t*>("\x5\x6"), 2);
+    EXPECT_TRUE(ram.get_dirty_pages()[0x20]);
+    EXPECT_TRUE(ram.get_dirty_pages()[0x01]);
+    EXPECT_NE(nullptr, bus.__pages[0xC1].wr_host);
+    EXPECT_EQ(5, ram.get_dirty_pages().count());
+
+    ram.mark_dirty_pages();
+    EXPECT_TRUE(ram.get_dirty_pages().all());
+    EXPECT_NE(nullptr, bus.__pages[0xD2].wr_host);
+    EXPECT_NE(nullptr, bus.__pages[0xFD].wr_host);
+    EXPECT_EQ(0x3, bus.read(0xDFFF));
+    EXPECT_EQ(bus.__pages[0xFD].wr_host, bus.__pages[0xDD].wr_host);
+    EXPECT_EQ(Bus::OPEN_BUS_VALUE, bus.read(0xFE00));
+}
+
+TEST(Work_RAM, DMG_Mode) {
+    using DMG_WRAM = GB::device::WRAM<GB::DMG_MODE>;
+
+    DMG_WRAM ram;
+
+    EXPECT_EQ(DMG_WRAM::MAX_SIZE, GB::WRAM_NON_CGB_SIZE);
+    EXPECT_EQ(ram.__memory.length(), GB::WRAM_NON_CGB_SIZE);
+    EXPECT_EQ(ram.get_SVBK_reg(), 0xFF);
+
+    ram.write_inner_vaddr(0x1000, 0x42);
+    ram.set_SVBK_reg(0x3);
+    EXPECT_EQ(ram.get_SVBK_reg(), 0xFF);
+    EXPECT_EQ(ram.read_inner_vaddr(0x1000), 0x42);
+    EXPECT_EQ(ram.read_phys_addr(0x1000), 0x42);
+}
+
+TEST(Work_RAM, Block_Read_Write) {
+    WRAM    ram;
+    byte_t  block[0x20];
+    byte_t  result[0x20] = {};
+
+    for (unsigned offset = 0; offset < sizeof(block); ++offset)
+        block[offset] = byte_t(offset + 1);
+    ram.set_SVBK_reg(0x3);
+
+    // block crosses WRAM0 into the selected WRAMX bank
+    ram.write_block(0x0FF0, block, sizeof(block));
+    EXPECT_EQ(0x10, ram.read_phys_addr(0x0FFF));
+    EXPECT_EQ(0x11, ram.read_phys_addr(3 * WRAM::BANK_SIZE));
+    ram.read_block(0x0FF0, result, sizeof(result));
+    for (unsigned offset = 0; offset < sizeof(block); ++offset)
+        EXPECT_EQ(block[offset], result[offset]);
+
+    // inner address wraps at the end of WRAMX
+    ram.write_block(0x1FF8, block, 0x10);
+    EXPECT_EQ(0x8, ram.read_phys_addr(3 * WRAM::BANK_SIZE + 0xFFF));
+    EXPECT_EQ(0x9, ram.read_phys_addr(0x0));
+
+    const span_t<const byte_t> bank = ram.view_bank(3);
+    EXPECT_EQ(WRAM::BANK_SIZE, bank.size());
+    EXPECT_EQ(ram.get_bankx_addr(), bank.data());
+    EXPECT_EQ(0x11, bank[0x0]);
+}
+
+TEST(Work_RAM, Block_Copy_On_Write) {
+    GB::memory::BusInterface    bus;
+    WRAM                        ram;
+    const byte_t                block[0x4] = { 0x1, 0x2, 0x3, 0x4 };
+
+    ram.map_to_memory(bus);
+    ram.write_phys_addr(WRAM::BANK_SIZE, 0x5);
+    ram.share_memory();
+    WRAM ram_fork(ram);
+    EXPECT_EQ(ram_fork.view_bank(1).data(), ram.view_bank(1).data());
+
+    ram.write_block(0x1000, block, sizeof(block));
+    EXPECT_NE(ram_fork.view_bank(1).data(), ram.view_bank(1).data());
+    EXPECT_EQ(0x5, ram_fork.view_bank(1)[0x0]);
+    EXPECT_EQ(0x1, bus.read(0xD000));
+    bus.write(0xD004, 0x6);
+    EXPECT_EQ(0x6, ram.view_bank(1)[0x4]);
+}
+
 }  // namespace